@@ -28,14 +28,26 @@ function(build_erf_lib erf_lib_name)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_WARM_NO_PRECIP)
   endif()
 
+  if(ERF_ENABLE_ALL_ADV_SPECIALIZATIONS)
+    target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_ALL_ADV_SPECIALIZATIONS)
+  endif()
+
   if(ERF_ENABLE_POISSON_SOLVE)
     target_sources(${erf_lib_name} PRIVATE
                    ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_inc.cpp
                    ${SRC_DIR}/Utils/ERF_PoissonSolve.cpp
-                   ${SRC_DIR}/Utils/ERF_PoissonSolve_tb.cpp)
+                   ${SRC_DIR}/Utils/ERF_PoissonSolve_tb.cpp
+                   ${SRC_DIR}/Utils/FFTPoisson.cpp)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_POISSON_SOLVE)
   endif()
 
+  if(ERF_ENABLE_WINDFARM)
+    target_sources(${erf_lib_name} PRIVATE
+                   ${SRC_DIR}/Initialization/ERF_init_windfarm.cpp
+                   ${SRC_DIR}/WindFarmParametrization/InitWindFarm.cpp)
+    target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_WINDFARM)
+  endif()
+
   if(ERF_ENABLE_PARTICLES)
     target_sources(${erf_lib_name} PRIVATE
                    ${SRC_DIR}/Particles/ERFPCEvolve.cpp
@@ -145,12 +157,16 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/IO/Checkpoint.cpp
        ${SRC_DIR}/IO/ERF_ReadBndryPlanes.cpp
        ${SRC_DIR}/IO/ERF_WriteBndryPlanes.cpp
+       ${SRC_DIR}/IO/ERF_BndryPlaneContainer.cpp
        ${SRC_DIR}/IO/ERF_Write1DProfiles.cpp
        ${SRC_DIR}/IO/ERF_Write1DProfiles_stag.cpp
        ${SRC_DIR}/IO/ERF_WriteScalarProfiles.cpp
        ${SRC_DIR}/IO/Plotfile.cpp
+       ${SRC_DIR}/IO/ERF_CompressedPlotfile.cpp
        ${SRC_DIR}/IO/writeJobInfo.cpp
        ${SRC_DIR}/IO/console_io.cpp
+       ${SRC_DIR}/IO/ERF_DiagnosticsPipeline.cpp
+       ${SRC_DIR}/IO/ERF_SamplerRegistry.cpp
        ${SRC_DIR}/SourceTerms/ERF_ApplySpongeZoneBCs.cpp
 	   ${SRC_DIR}/SourceTerms/ERF_ApplySpongeZoneBCs_ReadFromFile.cpp	  
        ${SRC_DIR}/SourceTerms/ERF_make_buoyancy.cpp
@@ -171,6 +187,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_pre.cpp
        ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_post.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_N.cpp
+       ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_N_fused.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_T.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_MT.cpp
        ${SRC_DIR}/Utils/MomentumToVelocity.cpp
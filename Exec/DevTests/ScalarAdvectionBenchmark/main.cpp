@@ -0,0 +1,175 @@
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
+#include <AMReX_Print.H>
+
+#include <iomanip>
+
+#include <AdvectionSrcForScalars.H>
+
+using namespace amrex;
+
+/**
+ * Microbenchmark for the advective fluxes of several scalars at once (the
+ * moisture species plus any passive tracers).  For each number of scalars in
+ * bench.nscal we time, on a cubic tile of bench.n_cell cells,
+ *   - one sweep over the faces per component (what AdvectionSrcForScalarsWrapper
+ *     did for every ncomp)
+ *   - AdvectionSrcForScalarsWrapper, which loops over the components at each face
+ * for the WENO3 (default moist) and UPWIND3 (default dry) interpolations, and
+ * check the fluxes against each other.
+ */
+
+namespace {
+
+template<typename InterpType>
+void
+per_component_fluxes (const Box& bx, int ncomp, int icomp,
+                      const GpuArray<const Array4<Real>, AMREX_SPACEDIM>& flx_arr,
+                      const Array4<const Real>& cell_prim,
+                      const Array4<const Real>& avg_xmom,
+                      const Array4<const Real>& avg_ymom,
+                      const Array4<const Real>& avg_zmom)
+{
+    InterpType interp(cell_prim);
+
+    ParallelFor(surroundingNodes(bx,0), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    {
+        const int cons_index = icomp + n;
+        Real interpx(0.);
+        interp.InterpolateInX(i,j,k,cons_index-1,interpx,avg_xmom(i,j,k),1.0);
+        (flx_arr[0])(i,j,k,cons_index) = avg_xmom(i,j,k) * interpx;
+    });
+    ParallelFor(surroundingNodes(bx,1), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    {
+        const int cons_index = icomp + n;
+        Real interpy(0.);
+        interp.InterpolateInY(i,j,k,cons_index-1,interpy,avg_ymom(i,j,k),1.0);
+        (flx_arr[1])(i,j,k,cons_index) = avg_ymom(i,j,k) * interpy;
+    });
+    ParallelFor(surroundingNodes(bx,2), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    {
+        const int cons_index = icomp + n;
+        Real interpz(0.);
+        interp.InterpolateInZ(i,j,k,cons_index-1,interpz,avg_zmom(i,j,k),1.0);
+        (flx_arr[2])(i,j,k,cons_index) = avg_zmom(i,j,k) * interpz;
+    });
+}
+
+template <typename F>
+Real
+time_it (int nreps, F&& f)
+{
+    f(); // warm up
+    Gpu::streamSynchronize();
+    Real strt = amrex::second();
+    for (int n = 0; n < nreps; ++n) {
+        f();
+    }
+    Gpu::streamSynchronize();
+    return (amrex::second() - strt) / nreps;
+}
+
+Real
+max_diff (const std::array<FArrayBox,AMREX_SPACEDIM>& a,
+          const std::array<FArrayBox,AMREX_SPACEDIM>& b, int icomp, int ncomp)
+{
+    Real diff = 0.0;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        const Box& fbx = a[dir].box();
+        FArrayBox tmp(fbx, ncomp, The_Async_Arena());
+        tmp.copy<RunOn::Device>(a[dir], fbx, icomp, fbx, 0, ncomp);
+        tmp.minus<RunOn::Device>(b[dir], fbx, fbx, icomp, 0, ncomp);
+        for (int n = 0; n < ncomp; ++n) {
+            diff = amrex::max(diff, tmp.norm<RunOn::Device>(fbx, 0, n, 1));
+        }
+    }
+    return diff;
+}
+
+template<typename InterpType>
+void
+run (const std::string& name, const Box& bx, int nscal, int nreps)
+{
+    // Scalars start at RhoQ1_comp as they do for the moisture species
+    const int icomp = RhoQ1_comp;
+    const int ncons = icomp + nscal;
+
+    FArrayBox prim(grow(bx,3), ncons-1, The_Async_Arena());
+    FArrayBox xmom(grow(surroundingNodes(bx,0),1), 1, The_Async_Arena());
+    FArrayBox ymom(grow(surroundingNodes(bx,1),1), 1, The_Async_Arena());
+    FArrayBox zmom(grow(surroundingNodes(bx,2),1), 1, The_Async_Arena());
+
+    std::array<FArrayBox,AMREX_SPACEDIM> flux_ref;
+    std::array<FArrayBox,AMREX_SPACEDIM> flux;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        flux_ref[dir].resize(surroundingNodes(bx,dir), ncons, The_Async_Arena());
+        flux[dir].resize    (surroundingNodes(bx,dir), ncons, The_Async_Arena());
+    }
+
+    auto const& prim_a = prim.array();
+    ParallelForRNG(prim.box(), ncons-1, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n, RandomEngine const& engine) noexcept
+    {
+        prim_a(i,j,k,n) = 1.e-3 * Random(engine);
+    });
+    for (auto* mom : {&xmom, &ymom, &zmom}) {
+        auto const& mom_a = mom->array();
+        ParallelForRNG(mom->box(), [=] AMREX_GPU_DEVICE (int i, int j, int k, RandomEngine const& engine) noexcept
+        {
+            mom_a(i,j,k) = Random(engine) - 0.5;
+        });
+    }
+
+    GpuArray<const Array4<Real>, AMREX_SPACEDIM> flx_ref_arr{{AMREX_D_DECL(flux_ref[0].array(), flux_ref[1].array(), flux_ref[2].array())}};
+    GpuArray<const Array4<Real>, AMREX_SPACEDIM> flx_arr    {{AMREX_D_DECL(flux[0].array(), flux[1].array(), flux[2].array())}};
+
+    Real t_per_comp = time_it(nreps, [&] () {
+        per_component_fluxes<InterpType>(bx, nscal, icomp, flx_ref_arr, prim.const_array(),
+                                         xmom.const_array(), ymom.const_array(), zmom.const_array());
+    });
+
+    Real t_fused = time_it(nreps, [&] () {
+        AdvectionSrcForScalarsWrapper<InterpType,InterpType>(bx, nscal, icomp, flx_arr, prim.const_array(),
+                                                             xmom.const_array(), ymom.const_array(), zmom.const_array(),
+                                                             1.0, 1.0);
+    });
+
+    amrex::Print() << std::setw(8) << name
+                   << std::setw(7) << nscal
+                   << std::setw(16) << t_per_comp
+                   << std::setw(13) << t_fused
+                   << std::setw(10) << std::setprecision(3) << t_per_comp / t_fused
+                   << std::setw(13) << max_diff(flux, flux_ref, icomp, nscal)
+                   << std::setprecision(6) << std::endl;
+}
+
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+    int n_cell = 64;
+    Vector<int> nscal{3, 6, 10};
+    int nreps = 20;
+    {
+        ParmParse pp("bench");
+        pp.query("n_cell", n_cell);
+        pp.queryarr("nscal", nscal);
+        pp.query("nreps", nreps);
+    }
+
+    Box bx(IntVect(0), IntVect(n_cell-1));
+
+    amrex::Print() << "  interp  nscal  per comp (s)    fused (s)   speedup   max |diff|" << std::endl;
+
+    for (int n : nscal) {
+        run<WENO3>  ("WENO3"  , bx, n, nreps);
+    }
+    for (int n : nscal) {
+        run<UPWIND3>("UPWIND3", bx, n, nreps);
+    }
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,179 @@
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
+#include <AMReX_Print.H>
+
+#include <iomanip>
+
+#include <BatchedTridiagonalSolver.H>
+
+using namespace amrex;
+
+/**
+ * Microbenchmark for the batched vertical tridiagonal solver used in the
+ * acoustic substepping.  For cubic tiles of each size in bench.n_cell we time
+ *   - the column-at-a-time Thomas loop (what erf_fast_rhs_* do on the GPU)
+ *   - the k-plane sweep (what erf_fast_rhs_* did on the CPU)
+ *   - batched_tridiagonal_solve
+ * and check the batched solution against the column loop.
+ */
+
+namespace {
+
+// One thread (or one iteration) per column, k-recurrence walks with plane stride
+void
+column_solve (const Box& tbz,
+              const Array4<const Real>& A, const Array4<const Real>& invB,
+              const Array4<const Real>& C, const Array4<const Real>& RHS,
+              const Array4<Real>& soln)
+{
+    Box b2d = tbz; // Copy constructor
+    b2d.setRange(2,0);
+    const auto lo = lbound(tbz);
+    const auto hi = ubound(tbz);
+    ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+    {
+        soln(i,j,lo.z) = RHS(i,j,lo.z) * invB(i,j,lo.z);
+        for (int k = lo.z+1; k <= hi.z; k++) {
+            soln(i,j,k) = (RHS(i,j,k)-A(i,j,k)*soln(i,j,k-1)) * invB(i,j,k);
+        }
+        for (int k = hi.z-1; k >= lo.z; k--) {
+            soln(i,j,k) -= ( C(i,j,k) * invB(i,j,k) ) * soln(i,j,k+1);
+        }
+    });
+}
+
+#ifndef AMREX_USE_GPU
+// Whole k-planes at a time, vectorized in i
+void
+plane_solve (const Box& tbz,
+             const Array4<const Real>& A, const Array4<const Real>& invB,
+             const Array4<const Real>& C, const Array4<const Real>& RHS,
+             const Array4<Real>& soln)
+{
+    const auto lo = lbound(tbz);
+    const auto hi = ubound(tbz);
+    for (int j = lo.y; j <= hi.y; ++j) {
+        AMREX_PRAGMA_SIMD
+        for (int i = lo.x; i <= hi.x; ++i) {
+            soln(i,j,lo.z) = RHS(i,j,lo.z) * invB(i,j,lo.z);
+        }
+    }
+    for (int k = lo.z+1; k <= hi.z; ++k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            AMREX_PRAGMA_SIMD
+            for (int i = lo.x; i <= hi.x; ++i) {
+                soln(i,j,k) = (RHS(i,j,k)-A(i,j,k)*soln(i,j,k-1)) * invB(i,j,k);
+            }
+        }
+    }
+    for (int k = hi.z-1; k >= lo.z; --k) {
+        for (int j = lo.y; j <= hi.y; ++j) {
+            AMREX_PRAGMA_SIMD
+            for (int i = lo.x; i <= hi.x; ++i) {
+                soln(i,j,k) -= ( C(i,j,k) * invB(i,j,k) ) * soln(i,j,k+1);
+            }
+        }
+    }
+}
+#endif
+
+template <typename F>
+Real
+time_it (int nreps, F&& f)
+{
+    f(); // warm up
+    Gpu::streamSynchronize();
+    Real strt = amrex::second();
+    for (int n = 0; n < nreps; ++n) {
+        f();
+    }
+    Gpu::streamSynchronize();
+    return (amrex::second() - strt) / nreps;
+}
+
+Real
+max_diff (const Box& tbz, const FArrayBox& a, const FArrayBox& b)
+{
+    FArrayBox diff(tbz, 1, The_Async_Arena());
+    diff.copy<RunOn::Device>(a, tbz, 0, tbz, 0, 1);
+    diff.minus<RunOn::Device>(b, tbz, tbz, 0, 0, 1);
+    return diff.norm<RunOn::Device>(tbz, 0, 0, 1);
+}
+
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+    Vector<int> n_cell{64, 128, 256};
+    int nreps = 20;
+    {
+        ParmParse pp("bench");
+        pp.queryarr("n_cell", n_cell);
+        pp.query("nreps", nreps);
+    }
+
+    amrex::Print() << "      n   column (s)    plane (s)  batched (s)   max |diff|" << std::endl;
+
+    for (int n : n_cell)
+    {
+        Box bx(IntVect(0), IntVect(n-1));
+        Box tbz = surroundingNodes(bx,2);
+        const auto lo = lbound(tbz);
+        const auto hi = ubound(tbz);
+
+        // A, B, C, RHS
+        FArrayBox coeffs(tbz, 4, The_Async_Arena());
+        FArrayBox soln_ref(tbz, 1, The_Async_Arena());
+        FArrayBox soln    (tbz, 1, The_Async_Arena());
+
+        auto const& A   = coeffs.array(0);
+        auto const& B   = coeffs.array(1);
+        auto const& C   = coeffs.array(2);
+        auto const& RHS = coeffs.array(3);
+
+        // Diagonally dominant, like the acoustic operator
+        ParallelForRNG(tbz, [=] AMREX_GPU_DEVICE (int i, int j, int k, RandomEngine const& engine) noexcept
+        {
+            A(i,j,k)   = (k == lo.z) ? 0.0 : -1.0 - Random(engine);
+            C(i,j,k)   = (k == hi.z) ? 0.0 : -1.0 - Random(engine);
+            B(i,j,k)   = 5.0 + Random(engine);
+            RHS(i,j,k) = Random(engine) - 0.5;
+        });
+
+        batched_tridiagonal_factorize(tbz, A, B, C);
+        ParallelFor(tbz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            B(i,j,k) = 1.0 / B(i,j,k);
+        });
+
+        auto const& soln_ref_a = soln_ref.array();
+        auto const& soln_a     = soln.array();
+
+        Real t_column = time_it(nreps, [&] () {
+            column_solve(tbz, A, B, C, RHS, soln_ref_a);
+        });
+
+        Real t_plane = 0.0;
+#ifndef AMREX_USE_GPU
+        t_plane = time_it(nreps, [&] () {
+            plane_solve(tbz, A, B, C, RHS, soln_a);
+        });
+#endif
+
+        Real t_batched = time_it(nreps, [&] () {
+            batched_tridiagonal_solve(tbz, A, B, C, RHS, soln_a);
+        });
+
+        amrex::Print() << std::setw(7) << n
+                       << std::setw(13) << t_column
+                       << std::setw(13) << t_plane
+                       << std::setw(13) << t_batched
+                       << std::setw(13) << max_diff(tbz, soln, soln_ref) << std::endl;
+    }
+    }
+    amrex::Finalize();
+}
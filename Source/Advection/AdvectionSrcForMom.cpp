@@ -167,7 +167,7 @@ AdvectionSrcForMom (const Box& bx,
                                                   horiz_upw_frac, vert_upw_frac,
                                                   vert_adv_type, lo_z_face, hi_z_face);
             } else if (horiz_adv_type == AdvType::Upwind_3rd) {
-                AdvectionSrcForMomVert_N<UPWIND3>(bxx, bxy, bxz,
+                AdvectionSrcForMomUpw_N<UPWIND3>(bxx, bxy, bxz,
                                                   rho_u_rhs, rho_v_rhs, rho_w_rhs,
                                                   rho_u, rho_v, Omega, u, v, w,
                                                   cellSizeInv, mf_m,
@@ -183,7 +183,7 @@ AdvectionSrcForMom (const Box& bx,
                                                   horiz_upw_frac, vert_upw_frac,
                                                   vert_adv_type, lo_z_face, hi_z_face);
             } else if (horiz_adv_type == AdvType::Upwind_5th) {
-                AdvectionSrcForMomVert_N<UPWIND5>(bxx, bxy, bxz,
+                AdvectionSrcForMomUpw_N<UPWIND5>(bxx, bxy, bxz,
                                                   rho_u_rhs, rho_v_rhs, rho_w_rhs,
                                                   rho_u, rho_v, Omega, u, v, w,
                                                   cellSizeInv, mf_m,
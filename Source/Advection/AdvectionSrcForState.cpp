@@ -206,9 +206,9 @@ AdvectionSrcForScalars (const Real& dt,
                                                   horiz_upw_frac, vert_upw_frac, vert_adv_type);
             break;
         case AdvType::Upwind_3rd:
-            AdvectionSrcForScalarsVert<UPWIND3>(bx, ncomp, icomp, flx_arr, cell_prim,
-                                                avg_xmom, avg_ymom, avg_zmom,
-                                                horiz_upw_frac, vert_upw_frac, vert_adv_type);
+            AdvectionSrcForScalarsUpw<UPWIND3>(bx, ncomp, icomp, flx_arr, cell_prim,
+                                               avg_xmom, avg_ymom, avg_zmom,
+                                               horiz_upw_frac, vert_upw_frac, vert_adv_type);
             break;
         case AdvType::Centered_4th:
             AdvectionSrcForScalarsVert<CENTERED4>(bx, ncomp, icomp, flx_arr, cell_prim,
@@ -216,9 +216,9 @@ AdvectionSrcForScalars (const Real& dt,
                                                   horiz_upw_frac, vert_upw_frac, vert_adv_type);
             break;
         case AdvType::Upwind_5th:
-            AdvectionSrcForScalarsVert<UPWIND5>(bx, ncomp, icomp, flx_arr, cell_prim,
-                                                avg_xmom, avg_ymom, avg_zmom,
-                                                horiz_upw_frac, vert_upw_frac, vert_adv_type);
+            AdvectionSrcForScalarsUpw<UPWIND5>(bx, ncomp, icomp, flx_arr, cell_prim,
+                                               avg_xmom, avg_ymom, avg_zmom,
+                                               horiz_upw_frac, vert_upw_frac, vert_adv_type);
             break;
         case AdvType::Centered_6th:
             AdvectionSrcForScalarsVert<CENTERED6>(bx, ncomp, icomp, flx_arr, cell_prim,
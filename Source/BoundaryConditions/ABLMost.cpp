@@ -128,6 +128,11 @@ ABLMost::update_fluxes (const int& lev,
 /**
  * Function to compute the fluxes (u^star and t^star) for Monin Obukhov similarity theory
  *
+ * With most.warm_start the iterations start from the u^star (and L) of the previous call,
+ * and with most.fixed_iters > 0 every column does exactly that many iterations, which
+ * avoids the divergence of a data-dependent trip count.  With most.report_residual the
+ * distribution of the change in u^star over the last iteration is printed.
+ *
  * @param[in] lev Current level
  * @param[in] max_iters maximum iterations to use
  * @param[in] most_flux structure to iteratively compute ustar and tstar
@@ -136,7 +141,7 @@ template <typename FluxIter>
 void
 ABLMost::compute_fluxes (const int& lev,
                          const int& max_iters,
-                         const FluxIter& most_flux,
+                         FluxIter most_flux,
                          bool is_land)
 {
     // Pointers to the computed averages
@@ -145,6 +150,16 @@ ABLMost::compute_fluxes (const int& lev,
     const auto *const tvm_ptr = m_ma.get_average(lev,4); // virtual potential temperature
     const auto *const umm_ptr = m_ma.get_average(lev,5); // horizontal velocity magnitude
 
+    // iterate_flux does iters+1 iterations when fixed
+    most_flux.set_iteration(m_warm_start, (m_fixed_iters > 0));
+    const int iters = (m_fixed_iters > 0) ? m_fixed_iters - 1 : max_iters;
+
+    // Max, sum, number above tolerance and number of columns
+    ReduceOps<ReduceOpMax, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real, Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    const Real resid_tol = 1.0e-5;
+
     for (MFIter mfi(*u_star[lev]); mfi.isValid(); ++mfi)
     {
         Box gtbx = mfi.growntilebox();
@@ -169,18 +184,58 @@ ABLMost::compute_fluxes (const int& lev,
         auto lmask_arr    = (m_lmask_lev[lev][0])    ? m_lmask_lev[lev][0]->array(mfi) :
                                                        Array4<int> {};
 
-        ParallelFor(gtbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-        {
-            if (( is_land && lmask_arr(i,j,k) == 1) ||
-                (!is_land && lmask_arr(i,j,k) == 0))
+        if (m_report_residual) {
+            // Only count each column once, in the box that owns it
+            Box vbx = mfi.validbox();
+            reduce_op.eval(gtbx, reduce_data, [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
             {
-                most_flux.iterate_flux(i, j, k, max_iters,
-                                       z0_arr, umm_arr, tm_arr, tvm_arr, qvm_arr,
-                                       u_star_arr, t_star_arr, q_star_arr,  // to be updated
-                                       t_surf_arr, olen_arr,                // to be updated
-                                       Hwave_arr, Lwave_arr, eta_arr);
-            }
-        });
+                Real resid = 0.0;
+                Real npts  = 0.0;
+                if (( is_land && lmask_arr(i,j,k) == 1) ||
+                    (!is_land && lmask_arr(i,j,k) == 0))
+                {
+                    resid = most_flux.iterate_flux(i, j, k, iters,
+                                                   z0_arr, umm_arr, tm_arr, tvm_arr, qvm_arr,
+                                                   u_star_arr, t_star_arr, q_star_arr,  // to be updated
+                                                   t_surf_arr, olen_arr,                // to be updated
+                                                   Hwave_arr, Lwave_arr, eta_arr);
+                    npts  = (vbx.contains(i,j,k)) ? 1.0 : 0.0;
+                }
+                Real above = (resid > resid_tol) ? 1.0 : 0.0;
+                return {resid*npts, resid*npts, above*npts, npts};
+            });
+        } else {
+            ParallelFor(gtbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                if (( is_land && lmask_arr(i,j,k) == 1) ||
+                    (!is_land && lmask_arr(i,j,k) == 0))
+                {
+                    most_flux.iterate_flux(i, j, k, iters,
+                                           z0_arr, umm_arr, tm_arr, tvm_arr, qvm_arr,
+                                           u_star_arr, t_star_arr, q_star_arr,  // to be updated
+                                           t_surf_arr, olen_arr,                // to be updated
+                                           Hwave_arr, Lwave_arr, eta_arr);
+                }
+            });
+        }
+    }
+
+    if (m_report_residual) {
+        ReduceTuple hv = reduce_data.value(reduce_op);
+        Real resid_max = amrex::get<0>(hv);
+        Real resid_sum = amrex::get<1>(hv);
+        Real n_above   = amrex::get<2>(hv);
+        Real n_cols    = amrex::get<3>(hv);
+        ParallelDescriptor::ReduceRealMax(resid_max);
+        ParallelDescriptor::ReduceRealSum({resid_sum, n_above, n_cols});
+        if (n_cols > 0.0) {
+            amrex::Print() << "MOST u* residual at level " << lev << (is_land ? " (land)" : " (sea)")
+                           << ((m_fixed_iters > 0) ? " after " : " after at most ") << iters + 1
+                           << " iterations: max " << resid_max
+                           << ", mean " << resid_sum / n_cols
+                           << ", columns above " << resid_tol << ": " << static_cast<Long>(n_above)
+                           << " of " << static_cast<Long>(n_cols) << std::endl;
+        }
     }
 }
 
@@ -23,21 +23,13 @@ ERF::fill_from_bndryregs (const Vector<MultiFab*>& mfs, const Real time)
     const auto& dom_lo = lbound(domain);
     const auto& dom_hi = ubound(domain);
 
-    Vector<std::unique_ptr<PlaneVector>>& bndry_data = m_r2d->interp_in_time(time);
+    // The pieces of the planes the boxes of mfs read, on the owners of those boxes
+    const BndryPlaneCopies& copies = m_r2d->planes_for(time, mfs);
+    const auto& planes      = copies.planes;
+    const auto& plane_index = copies.index;
 
     const BCRec* bc_ptr = domain_bcs_type_d.data();
 
-    // xlo: ori = 0
-    // ylo: ori = 1
-    // zlo: ori = 2
-    // xhi: ori = 3
-    // yhi: ori = 4
-    // zhi: ori = 5
-    const auto& bdatxlo = (*bndry_data[0])[lev].const_array();
-    const auto& bdatylo = (*bndry_data[1])[lev].const_array();
-    const auto& bdatxhi = (*bndry_data[3])[lev].const_array();
-    const auto& bdatyhi = (*bndry_data[4])[lev].const_array();
-
     int bccomp;
 
     for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
@@ -64,6 +56,22 @@ ERF::fill_from_bndryregs (const Vector<MultiFab*>& mfs, const Real time)
             const Array4<Real>& dest_arr = mf.array(mfi);
             Box bx = mfi.growntilebox();
 
+            // xlo: ori = 0
+            // ylo: ori = 1
+            // zlo: ori = 2
+            // xhi: ori = 3
+            // yhi: ori = 4
+            // zhi: ori = 5
+            Array<Array4<Real const>, 2*AMREX_SPACEDIM> bdat;
+            for (int ori : {0, 1, 3, 4}) {
+                const int idx = plane_index[ori][mfi.index()];
+                if (idx >= 0) bdat[ori] = planes[ori].const_array(idx);
+            }
+            const auto& bdatxlo = bdat[0];
+            const auto& bdatylo = bdat[1];
+            const auto& bdatxhi = bdat[3];
+            const auto& bdatyhi = bdat[4];
+
             // x-faces
             {
             Box bx_xlo(bx); bx_xlo.setBig(0,dom_lo.x-1);
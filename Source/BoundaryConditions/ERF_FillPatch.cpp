@@ -244,12 +244,15 @@ ERF::FillIntermediatePatch (int lev, Real time,
                             const Vector<MultiFab*>& mfs_mom,     // This includes cc quantities and MOMENTA
                             int ng_cons, int ng_vel, bool cons_only,
                             int icomp_cons, int ncomp_cons,
-                            bool allow_most_bcs)
+                            bool allow_most_bcs, bool async_exchange)
 {
     BL_PROFILE_VAR("FillIntermediatePatch()",FillIntermediatePatch);
     int bccomp;
     Interpolater* mapper;
 
+    AMREX_ALWAYS_ASSERT(!m_pending_fill.pending);
+    AMREX_ALWAYS_ASSERT(!async_exchange || (lev == 0 && !cons_only));
+
     //
     // ***************************************************************************
     // The first thing we do is interpolate the momenta on the "valid" faces of
@@ -298,6 +301,39 @@ ERF::FillIntermediatePatch (int lev, Real time,
                             Geom(lev).Domain(), domain_bcs_type);
     }
 
+    if (async_exchange)
+    {
+        // Start the fine-fine exchange of cons and VELOCITY; the density ghost cells were
+        //    filled by the preceding (cons_only) call
+        const Periodicity& period = geom[lev].periodicity();
+        mfs_vel[Vars::cons]->FillBoundary_nowait(icomp_cons,ncomp_cons,IntVect(ng_cons,ng_cons,ng_cons),period);
+        mfs_vel[Vars::xvel]->FillBoundary_nowait(0,1,IntVect(ng_vel,ng_vel,ng_vel),period);
+        mfs_vel[Vars::yvel]->FillBoundary_nowait(0,1,IntVect(ng_vel,ng_vel,ng_vel),period);
+        mfs_vel[Vars::zvel]->FillBoundary_nowait(0,1,IntVect(ng_vel,ng_vel,0),period);
+
+        // Convert back on the valid region only, so the interior of the slow RHS can be built
+        //    while the exchange is in flight; the ghost cells/faces are converted once it completes
+        VelocityToMomentum(*mfs_vel[Vars::xvel], IntVect(0),
+                           *mfs_vel[Vars::yvel], IntVect(0),
+                           *mfs_vel[Vars::zvel], IntVect(0),
+                           *mfs_vel[Vars::cons],
+                           *mfs_mom[IntVars::xmom], *mfs_mom[IntVars::ymom], *mfs_mom[IntVars::zmom],
+                           Geom(lev).Domain(),
+                           domain_bcs_type);
+
+        m_pending_fill.pending        = true;
+        m_pending_fill.lev            = lev;
+        m_pending_fill.time           = time;
+        m_pending_fill.mfs_vel        = mfs_vel;
+        m_pending_fill.mfs_mom        = mfs_mom;
+        m_pending_fill.ng_cons        = ng_cons;
+        m_pending_fill.ng_vel         = ng_vel;
+        m_pending_fill.icomp_cons     = icomp_cons;
+        m_pending_fill.ncomp_cons     = ncomp_cons;
+        m_pending_fill.allow_most_bcs = allow_most_bcs;
+        return;
+    }
+
     // We now start working on conserved quantities + VELOCITY
     for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
     {
@@ -389,6 +425,44 @@ ERF::FillIntermediatePatch (int lev, Real time,
         } // lev > 0
     } // var_idx
 
+    FillIntermediatePatchBCs(lev, time, mfs_vel, mfs_mom, ng_cons, ng_vel, cons_only,
+                             icomp_cons, ncomp_cons, allow_most_bcs);
+}
+
+/*
+ * Complete a FillIntermediatePatch started with async_exchange: finish the fine-fine exchange
+ *    of cons and velocity, then impose the physical bcs and convert back to momenta as
+ *    FillIntermediatePatch would have
+ */
+void
+ERF::FinishIntermediatePatch ()
+{
+    BL_PROFILE_VAR("FinishIntermediatePatch()",FinishIntermediatePatch);
+    AMREX_ALWAYS_ASSERT(m_pending_fill.pending);
+
+    const PendingFill pf = m_pending_fill;
+    m_pending_fill = PendingFill{};
+
+    for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+        pf.mfs_vel[var_idx]->FillBoundary_finish();
+    }
+
+    FillIntermediatePatchBCs(pf.lev, pf.time, pf.mfs_vel, pf.mfs_mom, pf.ng_cons, pf.ng_vel, false,
+                             pf.icomp_cons, pf.ncomp_cons, pf.allow_most_bcs);
+}
+
+/*
+ * Impose the physical bcs on cons and velocity once their fine-fine ghost values are filled,
+ *    then convert velocity back to momenta on the valid and ghost cells/faces
+ */
+void
+ERF::FillIntermediatePatchBCs (int lev, Real time,
+                               const Vector<MultiFab*>& mfs_vel,     // This includes cc quantities and VELOCITIES
+                               const Vector<MultiFab*>& mfs_mom,     // This includes cc quantities and MOMENTA
+                               int ng_cons, int ng_vel, bool cons_only,
+                               int icomp_cons, int ncomp_cons,
+                               bool allow_most_bcs)
+{
     // ***************************************************************************
     // Physical bc's at domain boundary
     // ***************************************************************************
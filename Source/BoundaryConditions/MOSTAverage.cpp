@@ -53,6 +53,13 @@ MOSTAverage::MOSTAverage (Vector<Geometry>  geom,
     m_j_indx.resize(m_maxlev);
     m_k_indx.resize(m_maxlev);
 
+    // The interpolation stencils only depend on the terrain
+    m_stencil_valid.resize(m_maxlev,0);
+    m_stencil_ijk.resize(m_maxlev);
+    m_stencil_wgt.resize(m_maxlev);
+    std::string terrain_type_string{"Static"};
+    pp.query("terrain_type",terrain_type_string);
+    m_static_stencil = !(terrain_type_string == "Moving" || terrain_type_string == "moving");
 
     for (int lev(0); lev < m_maxlev; lev++) {
       m_fields[lev].resize(m_nvar);
@@ -625,6 +632,73 @@ MOSTAverage::set_norm_positions_T ()
 }
 
 
+/**
+ * Function to build the trilinear interpolation stencils of the region average
+ * with terrain and interpolation. For each column and each of the points in the
+ * region this stores the upper corner and weights found by trilinear_stencil_T,
+ * so compute_region_averages only has to gather the field values.
+ *
+ * @param[in] lev Current level
+ */
+void
+MOSTAverage::set_interp_stencils (int lev)
+{
+    const auto& geom = m_geom[lev];
+    const auto plo   = geom.ProbLoArray();
+    const auto dx    = geom.CellSizeArray();
+    const auto dxInv = geom.InvCellSizeArray();
+
+    // Capture radius for device
+    int d_radius = m_radius;
+
+    // The nodal averages of U and V need one more column on the high sides
+    IntVect ng(1,1,0);
+    int ncomp = AMREX_SPACEDIM * m_ncell_region;
+    if (!m_stencil_ijk[lev]) {
+        m_stencil_ijk[lev] = std::make_unique<iMultiFab>(m_x_pos[lev]->boxArray(), m_x_pos[lev]->DistributionMap(), ncomp, ng);
+        m_stencil_wgt[lev] = std::make_unique<MultiFab>(m_x_pos[lev]->boxArray(), m_x_pos[lev]->DistributionMap(), ncomp, ng);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(*m_stencil_ijk[lev], TileNoZ()); mfi.isValid(); ++mfi) {
+        Box gpbx = mfi.tilebox(IntVect(0),ng); gpbx.setSmall(2,0); gpbx.setBig(2,0);
+
+        const auto z_phys_arr = m_z_phys_nd[lev]->const_array(mfi);
+        const auto x_pos_arr  = m_x_pos[lev]->const_array(mfi);
+        const auto y_pos_arr  = m_y_pos[lev]->const_array(mfi);
+        const auto z_pos_arr  = m_z_pos[lev]->const_array(mfi);
+        auto ijk_arr = m_stencil_ijk[lev]->array(mfi);
+        auto wgt_arr = m_stencil_wgt[lev]->array(mfi);
+        ParallelFor(gpbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            Real met_h_zeta = Compute_h_zeta_AtCellCenter(i,j,k,dxInv,z_phys_arr);
+            int n = 0;
+            for (int lk(-d_radius); lk <= (d_radius); ++lk) {
+              for (int lj(-d_radius); lj <= (d_radius); ++lj) {
+                for (int li(-d_radius); li <= (d_radius); ++li) {
+                    Real xp = x_pos_arr(i+li,j+lj,k);
+                    Real yp = y_pos_arr(i+li,j+lj,k);
+                    Real zp = z_pos_arr(i+li,j+lj,k) + met_h_zeta*lk*dx[2];
+                    IntVect  iv;
+                    RealVect sx_hi;
+                    trilinear_stencil_T(xp, yp, zp, iv, sx_hi, z_phys_arr, plo, dxInv);
+                    for (int d(0); d < AMREX_SPACEDIM; ++d) {
+                        ijk_arr(i,j,k,AMREX_SPACEDIM*n+d) = iv[d];
+                        wgt_arr(i,j,k,AMREX_SPACEDIM*n+d) = sx_hi[d];
+                    }
+                    ++n;
+                }
+              }
+            }
+        });
+    }
+
+    m_stencil_valid[lev] = (m_static_stencil) ? 1 : 0;
+}
+
+
 /**
  * Function to call the type of average computation.
  *
@@ -946,11 +1020,6 @@ MOSTAverage::compute_region_averages (int lev)
     auto& averages    = m_averages[lev];
     const auto & geom = m_geom[lev];
 
-    auto& z_phys   = m_z_phys_nd[lev];
-    auto& x_pos    = m_x_pos[lev];
-    auto& y_pos    = m_y_pos[lev];
-    auto& z_pos    = m_z_pos[lev];
-
     auto& i_indx   = m_i_indx[lev];
     auto& j_indx   = m_j_indx[lev];
     auto& k_indx   = m_k_indx[lev];
@@ -971,54 +1040,140 @@ MOSTAverage::compute_region_averages (int lev)
     // Capture radius for device
     int d_radius = m_radius;
 
-    //
-    //----------------------------------------------------------
-    // Averages for U,V,T,Qv
-    //----------------------------------------------------------
-    //
-    for (int imf(0); imf < 4; ++imf) {
+    if (m_interp) {
+        //
+        //----------------------------------------------------------
+        // All averages at once, gathering with the cached stencils
+        //----------------------------------------------------------
+        //
+        if (!m_stencil_valid[lev]) set_interp_stencils(lev);
 
-        // Continue if no valid Qv pointer
-        if (!fields[imf]) continue;
+        // Liquid water is only sampled at the center of the region
+        int npts     = m_ncell_region;
+        int n_center = m_ncell_region / 2;
+
+        bool d_rotate = m_rotate;
+        bool has_qv   = (fields[3] != nullptr);
+        bool has_qr   = (fields[4] != nullptr);
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi(*fields[imf], TileNoZ()); mfi.isValid(); ++mfi) {
-            Box pbx = mfi.tilebox(); pbx.setSmall(2,0); pbx.setBig(2,0);
-
-            auto mf_arr = (m_rotate) ? rot_fields[imf]->const_array(mfi) :
-                                           fields[imf]->const_array(mfi);
-            auto ma_arr = averages[imf]->array(mfi);
+        for (MFIter mfi(*averages[2], TileNoZ()); mfi.isValid(); ++mfi) {
+            Box cbx = mfi.tilebox();                 cbx.setSmall(2,0); cbx.setBig(2,0);
+            Box ubx = mfi.tilebox(IntVect(1,0,0));   ubx.setSmall(2,0); ubx.setBig(2,0);
+            Box vbx = mfi.tilebox(IntVect(0,1,0));   vbx.setSmall(2,0); vbx.setBig(2,0);
+            Box gbx = cbx; gbx.growHi(0,1); gbx.growHi(1,1);
+
+            // U/V/T/Qv averages use the rotated fields, if we have them
+            auto u_arr  = (m_rotate) ? rot_fields[0]->const_array(mfi) : fields[0]->const_array(mfi);
+            auto v_arr  = (m_rotate) ? rot_fields[1]->const_array(mfi) : fields[1]->const_array(mfi);
+            auto t_arr  = (m_rotate) ? rot_fields[2]->const_array(mfi) : fields[2]->const_array(mfi);
+            auto qv_arr = (!has_qv)  ? Array4<const Real>{} :
+                          (m_rotate) ? rot_fields[3]->const_array(mfi) : fields[3]->const_array(mfi);
+
+            // Virtual potential temperature uses the unrotated fields
+            auto tv_t_arr  = fields[2]->const_array(mfi);
+            auto tv_qv_arr = (has_qv) ? fields[3]->const_array(mfi) : Array4<const Real>{};
+            auto tv_qr_arr = (has_qr) ? fields[4]->const_array(mfi) : Array4<const Real>{};
+
+            auto ma_u_arr    = averages[0]->array(mfi);
+            auto ma_v_arr    = averages[1]->array(mfi);
+            auto ma_t_arr    = averages[2]->array(mfi);
+            auto ma_qv_arr   = averages[3]->array(mfi);
+            auto ma_tv_arr   = averages[4]->array(mfi);
+            auto ma_umag_arr = averages[5]->array(mfi);
+
+            const auto ijk_arr = m_stencil_ijk[lev]->const_array(mfi);
+            const auto wgt_arr = m_stencil_wgt[lev]->const_array(mfi);
+
+            ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+            {
+                Real u_sum{0}, v_sum{0}, t_sum{0}, qv_sum{0}, tv_sum{0}, umag_sum{0};
+
+                Real qr_interp{0};
+                if (has_qr) {
+                    const int c = AMREX_SPACEDIM*n_center;
+                    const RealVect sx_hi(wgt_arr(i,j,k,c), wgt_arr(i,j,k,c+1), wgt_arr(i,j,k,c+2));
+                    qr_interp = trilinear_apply(ijk_arr(i,j,k,c), ijk_arr(i,j,k,c+1), ijk_arr(i,j,k,c+2),
+                                                sx_hi, tv_qr_arr, 0);
+                }
 
-            if (m_interp) {
-                const auto plo   = geom.ProbLoArray();
-                const auto dx    = geom.CellSizeArray();
-                const auto dxInv = geom.InvCellSizeArray();
-                const auto z_phys_arr = z_phys->const_array(mfi);
-                auto x_pos_arr = x_pos->array(mfi);
-                auto y_pos_arr = y_pos->array(mfi);
-                auto z_pos_arr = z_pos->array(mfi);
-                ParallelFor(pbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-                {
-                    ma_arr(i,j,k) *= d_fact_old;
+                for (int n(0); n < npts; ++n) {
+                    const int c  = AMREX_SPACEDIM*n;
+                    const int li = ijk_arr(i,j,k,c  );
+                    const int lj = ijk_arr(i,j,k,c+1);
+                    const int lk = ijk_arr(i,j,k,c+2);
+                    const RealVect sx_hi(wgt_arr(i,j,k,c), wgt_arr(i,j,k,c+1), wgt_arr(i,j,k,c+2));
+
+                    Real u_interp = trilinear_apply(li, lj, lk, sx_hi, u_arr, 0);
+                    Real v_interp = trilinear_apply(li, lj, lk, sx_hi, v_arr, 0);
+                    Real t_interp = trilinear_apply(li, lj, lk, sx_hi, t_arr, 0);
+                    u_sum    += u_interp;
+                    v_sum    += v_interp;
+                    t_sum    += t_interp;
+                    umag_sum += std::sqrt(u_interp*u_interp + v_interp*v_interp);
+
+                    if (has_qv) {
+                        Real qv_interp    = trilinear_apply(li, lj, lk, sx_hi, qv_arr, 0);
+                        Real tv_t_interp  = (d_rotate) ? trilinear_apply(li, lj, lk, sx_hi, tv_t_arr , 0) : t_interp;
+                        Real tv_qv_interp = (d_rotate) ? trilinear_apply(li, lj, lk, sx_hi, tv_qv_arr, 0) : qv_interp;
+                        qv_sum += qv_interp;
+                        tv_sum += tv_t_interp * (1.0 + 0.61*tv_qv_interp - qr_interp);
+                    }
+                }
 
-                    Real met_h_zeta = Compute_h_zeta_AtCellCenter(i,j,k,dxInv,z_phys_arr);
-                    for (int lk(-d_radius); lk <= (d_radius); ++lk) {
-                      for (int lj(-d_radius); lj <= (d_radius); ++lj) {
-                        for (int li(-d_radius); li <= (d_radius); ++li) {
-                            Real interp{0};
-                            Real xp = x_pos_arr(i+li,j+lj,k);
-                            Real yp = y_pos_arr(i+li,j+lj,k);
-                            Real zp = z_pos_arr(i+li,j+lj,k) + met_h_zeta*lk*dx[2];
-                            trilinear_interp_T(xp, yp, zp, &interp, mf_arr, z_phys_arr, plo, dxInv, 1);
-                            Real val = denom * interp * d_fact_new;
-                            ma_arr(i,j,k) += val;
-                        }
-                      }
+                if (ubx.contains(i,j,k)) {
+                    ma_u_arr(i,j,k) = d_fact_old * ma_u_arr(i,j,k) + denom * u_sum * d_fact_new;
+                }
+                if (vbx.contains(i,j,k)) {
+                    ma_v_arr(i,j,k) = d_fact_old * ma_v_arr(i,j,k) + denom * v_sum * d_fact_new;
+                }
+                if (cbx.contains(i,j,k)) {
+                    ma_t_arr(i,j,k)    = d_fact_old * ma_t_arr(i,j,k)    + denom * t_sum    * d_fact_new;
+                    ma_umag_arr(i,j,k) = d_fact_old * ma_umag_arr(i,j,k) + denom * umag_sum * d_fact_new;
+                    if (has_qv) {
+                        ma_qv_arr(i,j,k) = d_fact_old * ma_qv_arr(i,j,k) + denom * qv_sum * d_fact_new;
+                        ma_tv_arr(i,j,k) = d_fact_old * ma_tv_arr(i,j,k) + denom * tv_sum * d_fact_new;
                     }
-                });
-            } else {
+                }
+            });
+        }
+
+        // Fill interior ghost cells and any ghost cells outside a periodic domain
+        //***********************************************************************************
+        for (int iavg(0); iavg < m_navg; ++iavg) {
+            if ((iavg == 3 || iavg == 4) && !has_qv) continue;
+            averages[iavg]->FillBoundary(geom.periodicity());
+        }
+
+        // Without water vapor, copy temperature
+        if (!has_qv) {
+            int iavg   = m_navg - 2;
+            IntVect ng = averages[iavg]->nGrowVect();
+            MultiFab::Copy(*(averages[iavg]),*(averages[2]),0,0,1,ng);
+        }
+    } else {
+        //
+        //----------------------------------------------------------
+        // Averages for U,V,T,Qv
+        //----------------------------------------------------------
+        //
+        for (int imf(0); imf < 4; ++imf) {
+
+            // Continue if no valid Qv pointer
+            if (!fields[imf]) continue;
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(*fields[imf], TileNoZ()); mfi.isValid(); ++mfi) {
+                Box pbx = mfi.tilebox(); pbx.setSmall(2,0); pbx.setBig(2,0);
+
+                auto mf_arr = (m_rotate) ? rot_fields[imf]->const_array(mfi) :
+                                               fields[imf]->const_array(mfi);
+                auto ma_arr = averages[imf]->array(mfi);
+
                 auto k_arr = k_indx->const_array(mfi);
                 auto j_arr = j_indx ? j_indx->const_array(mfi) : Array4<const int> {};
                 auto i_arr = i_indx ? i_indx->const_array(mfi) : Array4<const int> {};
@@ -1039,74 +1194,32 @@ MOSTAverage::compute_region_averages (int lev)
                     }
                 });
             }
-        }
 
-        // Fill interior ghost cells and any ghost cells outside a periodic domain
-        //***********************************************************************************
-        averages[imf]->FillBoundary(geom.periodicity());
-    }
+            // Fill interior ghost cells and any ghost cells outside a periodic domain
+            //***********************************************************************************
+            averages[imf]->FillBoundary(geom.periodicity());
+        }
 
-    //
-    //----------------------------------------------------------
-    // Averages for virtual potential temperature
-    //----------------------------------------------------------
-    //
-    if (fields[3]) // We have water vapor
-    {
-        int iavg = 4;
+        //
+        //----------------------------------------------------------
+        // Averages for virtual potential temperature
+        //----------------------------------------------------------
+        //
+        if (fields[3]) // We have water vapor
+        {
+            int iavg = 4;
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi(*averages[iavg], TileNoZ()); mfi.isValid(); ++mfi) {
-            Box pbx = mfi.tilebox(); pbx.setSmall(2,0); pbx.setBig(2,0);
-
-            const Array4<Real const>& T_mf_arr = fields[2]->const_array(mfi);
-            const Array4<Real const>& qv_mf_arr = (fields[3])? fields[3]->const_array(mfi) : Array4<const Real>{};
-            const Array4<Real const>& qr_mf_arr = (fields[4])? fields[4]->const_array(mfi) : Array4<const Real>{};
-            auto ma_arr   = averages[iavg]->array(mfi);
+            for (MFIter mfi(*averages[iavg], TileNoZ()); mfi.isValid(); ++mfi) {
+                Box pbx = mfi.tilebox(); pbx.setSmall(2,0); pbx.setBig(2,0);
 
-            if (m_interp) {
-                const auto plo   = geom.ProbLoArray();
-                const auto dx    = geom.CellSizeArray();
-                const auto dxInv = geom.InvCellSizeArray();
-                const auto z_phys_arr = z_phys->const_array(mfi);
-                auto x_pos_arr = x_pos->array(mfi);
-                auto y_pos_arr = y_pos->array(mfi);
-                auto z_pos_arr = z_pos->array(mfi);
-                ParallelFor(pbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-                {
-                    ma_arr(i,j,k) *= d_fact_old;
+                const Array4<Real const>& T_mf_arr = fields[2]->const_array(mfi);
+                const Array4<Real const>& qv_mf_arr = (fields[3])? fields[3]->const_array(mfi) : Array4<const Real>{};
+                const Array4<Real const>& qr_mf_arr = (fields[4])? fields[4]->const_array(mfi) : Array4<const Real>{};
+                auto ma_arr   = averages[iavg]->array(mfi);
 
-                    Real met_h_zeta = Compute_h_zeta_AtCellCenter(i,j,k,dxInv,z_phys_arr);
-                    for (int lk(-d_radius); lk <= (d_radius); ++lk) {
-                      for (int lj(-d_radius); lj <= (d_radius); ++lj) {
-                        for (int li(-d_radius); li <= (d_radius); ++li) {
-                            Real T_interp{0};
-                            Real qv_interp{0};
-                            Real xp = x_pos_arr(i+li,j+lj,k);
-                            Real yp = y_pos_arr(i+li,j+lj,k);
-                            Real zp = z_pos_arr(i+li,j+lj,k) + met_h_zeta*lk*dx[2];
-                            trilinear_interp_T(xp, yp, zp, &T_interp,  T_mf_arr,  z_phys_arr, plo, dxInv, 1);
-                            trilinear_interp_T(xp, yp, zp, &qv_interp, qv_mf_arr, z_phys_arr, plo, dxInv, 1);
-                            Real vfac;
-                            if (qr_mf_arr) {
-                                // We also have liquid water
-                                Real qr_interp{0};
-                                trilinear_interp_T(x_pos_arr(i,j,k), y_pos_arr(i,j,k), z_pos_arr(i,j,k),
-                                                   &qr_interp, qr_mf_arr, z_phys_arr, plo, dxInv, 1);
-                                vfac = 1.0 + 0.61*qv_interp - qr_interp;
-                            } else {
-                                vfac = 1.0 + 0.61*qv_interp;
-                            }
-                            const Real mag = T_interp * vfac;
-                            const Real val = denom * mag * d_fact_new;
-                            ma_arr(i,j,k) += val;
-                        }
-                      }
-                    }
-                });
-            } else {
                 auto k_arr = k_indx->const_array(mfi);
                 auto j_arr = j_indx ? j_indx->const_array(mfi) : Array4<const int> {};
                 auto i_arr = i_indx ? i_indx->const_array(mfi) : Array4<const int> {};
@@ -1134,72 +1247,40 @@ MOSTAverage::compute_region_averages (int lev)
                       }
                     }
                 });
-            }
 
-            // Fill interior ghost cells and any ghost cells outside a periodic domain
-            //***********************************************************************************
-            averages[iavg]->FillBoundary(geom.periodicity());
+                // Fill interior ghost cells and any ghost cells outside a periodic domain
+                //***********************************************************************************
+                averages[iavg]->FillBoundary(geom.periodicity());
+            }
+        }
+        else // copy temperature
+        {
+            int iavg   = m_navg - 2;
+            IntVect ng = averages[iavg]->nGrowVect();
+            MultiFab::Copy(*(averages[iavg]),*(averages[2]),0,0,1,ng);
         }
-    }
-    else // copy temperature
-    {
-        int iavg   = m_navg - 2;
-        IntVect ng = averages[iavg]->nGrowVect();
-        MultiFab::Copy(*(averages[iavg]),*(averages[2]),0,0,1,ng);
-    }
 
-    //
-    //----------------------------------------------------------
-    // Averages for the tangential velocity magnitude
-    //----------------------------------------------------------
-    //
-    {
-        int imf  = 0;
-        int iavg = m_navg - 1;
+        //
+        //----------------------------------------------------------
+        // Averages for the tangential velocity magnitude
+        //----------------------------------------------------------
+        //
+        {
+            int imf  = 0;
+            int iavg = m_navg - 1;
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi(*averages[iavg], TileNoZ()); mfi.isValid(); ++mfi) {
-            Box pbx = mfi.tilebox(); pbx.setSmall(2,0); pbx.setBig(2,0);
+            for (MFIter mfi(*averages[iavg], TileNoZ()); mfi.isValid(); ++mfi) {
+                Box pbx = mfi.tilebox(); pbx.setSmall(2,0); pbx.setBig(2,0);
 
-            auto u_mf_arr = (m_rotate) ? rot_fields[imf  ]->const_array(mfi) :
-                                             fields[imf  ]->const_array(mfi);
-            auto v_mf_arr = (m_rotate) ? rot_fields[imf+1]->const_array(mfi) :
-                                             fields[imf+1]->const_array(mfi);
-            auto ma_arr   = averages[iavg]->array(mfi);
+                auto u_mf_arr = (m_rotate) ? rot_fields[imf  ]->const_array(mfi) :
+                                                 fields[imf  ]->const_array(mfi);
+                auto v_mf_arr = (m_rotate) ? rot_fields[imf+1]->const_array(mfi) :
+                                                 fields[imf+1]->const_array(mfi);
+                auto ma_arr   = averages[iavg]->array(mfi);
 
-            if (m_interp) {
-                const auto plo   = geom.ProbLoArray();
-                const auto dx    = geom.CellSizeArray();
-                const auto dxInv = geom.InvCellSizeArray();
-                const auto z_phys_arr = z_phys->const_array(mfi);
-                auto x_pos_arr = x_pos->array(mfi);
-                auto y_pos_arr = y_pos->array(mfi);
-                auto z_pos_arr = z_pos->array(mfi);
-                ParallelFor(pbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-                {
-                    ma_arr(i,j,k) *= d_fact_old;
-
-                    Real met_h_zeta = Compute_h_zeta_AtCellCenter(i,j,k,dxInv,z_phys_arr);
-                    for (int lk(-d_radius); lk <= (d_radius); ++lk) {
-                      for (int lj(-d_radius); lj <= (d_radius); ++lj) {
-                        for (int li(-d_radius); li <= (d_radius); ++li) {
-                            Real u_interp{0};
-                            Real v_interp{0};
-                            Real xp = x_pos_arr(i+li,j+lj,k);
-                            Real yp = y_pos_arr(i+li,j+lj,k);
-                            Real zp = z_pos_arr(i+li,j+lj,k) + met_h_zeta*lk*dx[2];
-                            trilinear_interp_T(xp, yp, zp, &u_interp, u_mf_arr, z_phys_arr, plo, dxInv, 1);
-                            trilinear_interp_T(xp, yp, zp, &v_interp, v_mf_arr, z_phys_arr, plo, dxInv, 1);
-                            Real mag = std::sqrt(u_interp*u_interp + v_interp*v_interp);
-                            Real val = denom * mag * d_fact_new;
-                            ma_arr(i,j,k) += val;
-                        }
-                      }
-                    }
-                });
-            } else {
                 auto k_arr = k_indx->const_array(mfi);
                 auto j_arr = j_indx ? j_indx->const_array(mfi) : Array4<const int> {};
                 auto i_arr = i_indx ? i_indx->const_array(mfi) : Array4<const int> {};
@@ -1222,15 +1303,14 @@ MOSTAverage::compute_region_averages (int lev)
                       }
                     }
                 });
-            }
 
-            // Fill interior ghost cells and any ghost cells outside a periodic domain
-            //***********************************************************************************
-            averages[iavg]->FillBoundary(geom.periodicity());
+                // Fill interior ghost cells and any ghost cells outside a periodic domain
+                //***********************************************************************************
+                averages[iavg]->FillBoundary(geom.periodicity());
+            }
         }
     }
 
-
     // Need to fill ghost cells outside the domain if not periodic
     bool not_per_x = !(geom.periodicity().isPeriodic(0));
     bool not_per_y = !(geom.periodicity().isPeriodic(1));
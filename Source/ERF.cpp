@@ -13,6 +13,7 @@
 
 #include <Utils.H>
 #include <TerrainMetrics.H>
+#include <BatchedPlaneAverage.H>
 #include <memory>
 
 #ifdef ERF_USE_MULTIBLOCK
@@ -35,6 +36,7 @@ Real ERF::fixed_fast_dt = -1.0;
 Real ERF::init_shrink   =  1.0;
 Real ERF::change_max    =  1.1;
 int  ERF::fixed_mri_dt_ratio = 0;
+bool ERF::adaptive_substeps  = false;
 
 // Dictate verbosity in screen output
 int ERF::verbose       = 0;
@@ -51,6 +53,13 @@ int  ERF::pert_interval = -1;
 // Native AMReX vs NetCDF
 std::string ERF::plotfile_type    = "amrex";
 
+// Collective parallel NetCDF output
+bool ERF::nc_parallel_io = false;
+
+// Absolute precision of the quantized variables of compressed plotfiles
+Vector<std::string> ERF::plot_quantize_vars;
+Vector<Real>        ERF::plot_quantize_quanta;
+
 // init_type:  "uniform", "ideal", "real", "input_sounding", "metgrid" or ""
 std::string ERF::init_type;
 
@@ -192,6 +201,7 @@ ERF::ERF ()
 
 #ifdef ERF_USE_POISSON_SOLVE
     pp_inc.resize(nlevs_max);
+    m_projection.resize(nlevs_max);
 #endif
 
     rU_new.resize(nlevs_max);
@@ -355,7 +365,7 @@ ERF::Evolve ()
         // Make sure we have read enough of the boundary plane data to make it through this timestep
         if (input_bndry_planes)
         {
-            m_r2d->read_input_files(cur_time,dt[0],m_bc_extdir_vals);
+            m_r2d->read_input_files(cur_time,dt[0],grids[0],dmap[0],m_bc_extdir_vals);
         }
 
         int lev = 0;
@@ -420,6 +430,8 @@ ERF::Evolve ()
         }
     }
 
+    flush_diagnostics();
+
     BL_PROFILE_VAR_STOP(evolve);
 }
 
@@ -493,6 +505,12 @@ ERF::post_timestep (int nstep, Real time, Real dt_lev0)
         sum_integrated_quantities(time);
     }
 
+    if (m_samplers) {
+        m_samplers->set_owners(grids[0], dmap[0]);
+        m_samplers->sample(nstep+1, time, vars_new[0][Vars::cons], vars_new[0][Vars::xvel],
+                           vars_new[0][Vars::yvel], vars_new[0][Vars::zvel], m_diag_pipeline.get());
+    }
+
     if (solverChoice.pert_type == PerturbationType::perturbSource ||
         solverChoice.pert_type == PerturbationType::perturbDirect) {
         if (is_it_time_for_action(nstep, time, dt_lev0, pert_interval, -1.)) {
@@ -736,7 +754,7 @@ ERF::InitData ()
 
         // We haven't populated dt yet, set to 0 to ensure assert doesn't crash
         Real dt_dummy = 0.0;
-        m_r2d->read_input_files(t_new[0],dt_dummy,m_bc_extdir_vals);
+        m_r2d->read_input_files(t_new[0],dt_dummy,grids[0],dmap[0],m_bc_extdir_vals);
     }
 
     if (solverChoice.custom_rhotheta_forcing)
@@ -850,8 +868,9 @@ ERF::InitData ()
         // Create the WriteBndryPlanes object so we can handle writing of boundary plane data
         m_w2d = std::make_unique<WriteBndryPlanes>(grids,geom);
 
+        // A restart has written the planes of its first step already
         Real time = 0.;
-        if (time >= bndry_output_planes_start_time) {
+        if (restart_chkfile.empty() && time >= bndry_output_planes_start_time) {
             m_w2d->write_planes(0, time, vars_new);
         }
     }
@@ -867,6 +886,7 @@ ERF::InitData ()
             {
                 project_velocities(lev, dummy_dt, vars_new[lev], pp_inc[lev]);
                 pp_inc[lev].setVal(0.);
+                if (m_projection[lev]) m_projection[lev]->clear_history();
             }
         }
     }
@@ -1039,6 +1059,11 @@ ERF::InitData ()
 
     // Set these up here because we need to know which MPI rank "cell" is on...
     ParmParse pp("erf");
+
+    if (m_async_diagnostics && !m_diag_pipeline) {
+        m_diag_pipeline = std::make_unique<DiagnosticsPipeline>(m_async_diagnostics_queue);
+    }
+
     if (pp.contains("data_log"))
     {
         int num_datalogs = pp.countval("data_log");
@@ -1119,6 +1144,14 @@ ERF::InitData ()
 
     }
 
+    // Groups of probes, each written to a single file
+    if (ParmParse(pp_prefix).contains("sampler_groups"))
+    {
+        m_samplers = std::make_unique<SamplerRegistry>(pp_prefix, geom[0].Domain(),
+                                                       vars_new[0][Vars::cons].nComp());
+        m_samplers->set_owners(grids[0], dmap[0]);
+    }
+
     BL_PROFILE_VAR_STOP(InitData);
 
 #ifdef ERF_USE_EB
@@ -1324,6 +1357,10 @@ ERF::ReadParameters ()
 
         pp.query("pert_interval", pert_interval);
 
+        // Write the data and sample logs on a helper thread
+        pp.query("async_diagnostics", m_async_diagnostics);
+        pp.query("async_diag_queue", m_async_diagnostics_queue);
+
         // Time step controls
         pp.query("cfl", cfl);
         pp.query("init_shrink", init_shrink);
@@ -1332,6 +1369,7 @@ ERF::ReadParameters ()
         pp.query("fixed_dt", fixed_dt);
         pp.query("fixed_fast_dt", fixed_fast_dt);
         pp.query("fixed_mri_dt_ratio", fixed_mri_dt_ratio);
+        pp.query("adaptive_substeps", adaptive_substeps);
 
         // If this is set, it must be even
         if (fixed_mri_dt_ratio > 0 && (fixed_mri_dt_ratio%2 != 0) )
@@ -1359,6 +1397,12 @@ ERF::ReadParameters ()
             }
         }
 
+        // The number of fast steps is either fixed or adaptive, not both
+        if (adaptive_substeps && (fixed_fast_dt > 0. || fixed_mri_dt_ratio > 0))
+        {
+            Abort("adaptive_substeps cannot be used with fixed_fast_dt or fixed_mri_dt_ratio");
+        }
+
         AMREX_ALWAYS_ASSERT(cfl > 0. || fixed_dt > 0.);
 
         // How to initialize
@@ -1438,11 +1482,21 @@ ERF::ReadParameters ()
         pp.query("plotfile_type", plotfile_type);
         if (plotfile_type != "amrex" &&
             plotfile_type != "netcdf" && plotfile_type != "NetCDF" &&
-            plotfile_type != "hdf5"   && plotfile_type != "HDF5" )
+            plotfile_type != "hdf5"   && plotfile_type != "HDF5" &&
+            plotfile_type != "compressed" )
         {
             Print() << "User selected plotfile_type = " << plotfile_type << std::endl;
             Abort("Dont know this plotfile_type");
         }
+        pp.query("nc_parallel_io", nc_parallel_io);
+        pp.queryarr("plot_quantize_vars",   plot_quantize_vars);
+        pp.queryarr("plot_quantize_quanta", plot_quantize_quanta);
+        if (plot_quantize_vars.size() != plot_quantize_quanta.size()) {
+            Abort("plot_quantize_vars and plot_quantize_quanta must have the same length");
+        }
+        for (const auto& q : plot_quantize_quanta) {
+            if (q <= 0.0) Abort("plot_quantize_quanta must be positive");
+        }
         pp.query("plot_file_1",   plot_file_1);
         pp.query("plot_file_2",   plot_file_2);
         pp.query("plot_int_1" , m_plot_int_1);
@@ -1588,31 +1642,23 @@ ERF::MakeHorizontalAverages ()
                 fab_arr(i, j, k, 4) = (ncomp > RhoQ2_comp ? cons_arr(i, j, k, RhoQ2_comp) / dens : 0.0);
             });
         }
-
-        Gpu::HostVector<Real> h_avg_qv          = sumToLine(mf,3,1,domain,zdir);
-        Gpu::HostVector<Real> h_avg_qc          = sumToLine(mf,4,1,domain,zdir);
     }
 
-    // Sum in the horizontal plane
-    Gpu::HostVector<Real> h_avg_density     = sumToLine(mf,0,1,domain,zdir);
-    Gpu::HostVector<Real> h_avg_temperature = sumToLine(mf,1,1,domain,zdir);
-    Gpu::HostVector<Real> h_avg_pressure    = sumToLine(mf,2,1,domain,zdir);
+    // Average in the horizontal plane, with a single reduction across ranks
+    BatchedPlaneAverage havg(geom[0], zdir);
+    havg.add(&mf);
+    havg();
 
-    // Divide by the total number of cells we are averaging over
-    int size_z = domain.length(zdir);
-    Real area_z = static_cast<Real>(domain.length(0)*domain.length(1));
-    int klen = static_cast<int>(h_avg_density.size());
+    havg.line_average(0, 0, h_havg_density);
+    havg.line_average(0, 1, h_havg_temperature);
+    havg.line_average(0, 2, h_havg_pressure);
+    if (use_moisture)
+    {
+        havg.line_average(0, 3, h_havg_qv);
+        havg.line_average(0, 4, h_havg_qc);
+    }
 
-    for (int k = 0; k < klen; ++k) {
-        h_havg_density[k]     /= area_z;
-        h_havg_temperature[k] /= area_z;
-        h_havg_pressure[k]    /= area_z;
-        if (solverChoice.moisture_type != MoistureType::None)
-        {
-            h_havg_qc[k]          /= area_z;
-            h_havg_qv[k]          /= area_z;
-        }
-    } // k
+    int size_z = domain.length(zdir);
 
     // resize device vectors
     d_havg_density.resize(size_z, 0.0_rt);
@@ -2029,7 +2075,7 @@ ERF::Evolve_MB (int MBstep, int max_block_step)
         // Make sure we have read enough of the boundary plane data to make it through this timestep
         if (input_bndry_planes)
         {
-            m_r2d->read_input_files(cur_time,dt[0],m_bc_extdir_vals);
+            m_r2d->read_input_files(cur_time,dt[0],grids[0],dmap[0],m_bc_extdir_vals);
         }
 
         int lev = 0;
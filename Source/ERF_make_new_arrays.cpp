@@ -521,11 +521,16 @@ ERF::initialize_integrator (int lev, MultiFab& cons_mf, MultiFab& vel_mf)
     int_state.push_back(MultiFab(convert(ba,IntVect(0,1,0)), dm, 1, vel_mf.nGrow())); // ymom
     int_state.push_back(MultiFab(convert(ba,IntVect(0,0,1)), dm, 1, vel_mf.nGrow())); // zmom
 
-    mri_integrator_mem[lev] = std::make_unique<MRISplitIntegrator<Vector<MultiFab> > >(int_state);
+    // The coarse/fine set region is filled by ERFFillPatcher on all the conserved components,
+    //    so the fast state of the integrator can only be trimmed if we don't use it
+    bool trim_mri_memory = solverChoice.trim_mri_memory && !(lev > 0 && cf_set_width > 0);
+
+    mri_integrator_mem[lev] = std::make_unique<MRISplitIntegrator<Vector<MultiFab> > >(int_state, trim_mri_memory);
     mri_integrator_mem[lev]->setNoSubstepping(solverChoice.no_substepping);
     mri_integrator_mem[lev]->setIncompressible(solverChoice.incompressible[lev]);
     mri_integrator_mem[lev]->setNcompCons(ncomp_cons);
     mri_integrator_mem[lev]->setForceFirstStageSingleSubstep(solverChoice.force_stage1_single_substep);
+    mri_integrator_mem[lev]->setUseTerrain(solverChoice.use_terrain);
 }
 
 void
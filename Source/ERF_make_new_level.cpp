@@ -503,6 +503,7 @@ ERF::ClearLevel (int lev)
 
 #ifdef ERF_USE_POISSON_SOLVE
     pp_inc[lev].clear();
+    m_projection[lev].reset();
 #endif
 
     // Clears the integrator memory
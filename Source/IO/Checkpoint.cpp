@@ -34,6 +34,9 @@ ERF::WriteCheckpointFile () const
 
     Print() << "Writing native checkpoint " << checkpointname << "\n";
 
+    // Make sure the logs are up to date with the checkpoint we restart from
+    flush_diagnostics();
+
     const int nlevels = finest_level+1;
 
     // ---- prebuild a hierarchy of directories
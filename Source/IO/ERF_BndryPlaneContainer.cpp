@@ -0,0 +1,349 @@
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "AMReX_ParallelDescriptor.H"
+#include "AMReX_Utility.H"
+#include "ERF_BndryPlaneContainer.H"
+
+using namespace amrex;
+
+namespace {
+
+std::string data_name  (const std::string& dir, int rank) { return dir + "/planes_" + std::to_string(rank) + ".bin"; }
+std::string index_name (const std::string& dir, int rank) { return dir + "/planes_" + std::to_string(rank) + ".idx"; }
+
+// Size of one entry (step, block offset) of an index file
+constexpr std::streamoff index_entry_size = sizeof(std::int32_t) + sizeof(std::int64_t);
+
+// Contents of planes.hdr; version 1 has no list of patches
+struct Header
+{
+    int version{0};
+    int real_size{0};
+    int nwriters{0};
+    Vector<std::string> var_names;
+    Vector<BndryPlaneContainer::Owner> owners;
+};
+
+bool read_header (std::istream& is, Header& h)
+{
+    std::string magic;
+    int nvars = 0;
+    if (!(is >> magic >> h.version >> h.real_size >> h.nwriters >> nvars)) return false;
+    if (magic != "ERF_BNDRY_PLANES" || h.version < 1 || h.version > 2) return false;
+    h.var_names.resize(nvars);
+    for (auto& name : h.var_names) {
+        is >> name;
+    }
+    if (h.version >= 2) {
+        int nowners = 0;
+        is >> nowners;
+        h.owners.resize(nowners);
+        for (auto& o : h.owners) {
+            IntVect lo, hi;
+            is >> o.writer >> o.ori;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) is >> lo[d];
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) is >> hi[d];
+            o.box = Box(lo, hi);
+        }
+    }
+    return !is.fail();
+}
+
+bool same_owner (const BndryPlaneContainer::Owner& a, const BndryPlaneContainer::Owner& b)
+{
+    return a.writer == b.writer && a.ori == b.ori && a.box == b.box;
+}
+
+void merge_owners (Vector<BndryPlaneContainer::Owner>& owners, const Vector<BndryPlaneContainer::Owner>& more)
+{
+    for (const auto& o : more) {
+        if (std::none_of(owners.begin(), owners.end(),
+                         [&] (const BndryPlaneContainer::Owner& x) { return same_owner(x, o); })) {
+            owners.push_back(o);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * Writes planes.hdr.  If a restart appends to an existing container, the
+ * largest number of writers and the patches listed before are kept.
+ *
+ * @param dir Folder of the container
+ * @param var_names Variables written in each step
+ * @param owners Patches of the faces and the ranks that write them
+ */
+void
+BndryPlaneContainer::write_header (const std::string& dir, const Vector<std::string>& var_names,
+                                   const Vector<Owner>& owners)
+{
+    if (!ParallelDescriptor::IOProcessor()) return;
+
+    int nwriters = ParallelDescriptor::NProcs();
+    Vector<Owner> all_owners;
+    {
+        std::ifstream ifs(header_name(dir));
+        Header old;
+        if (read_header(ifs, old)) {
+            nwriters = std::max(nwriters, old.nwriters);
+            all_owners = old.owners;
+        }
+    }
+    merge_owners(all_owners, owners);
+
+    std::ofstream ofs(header_name(dir), std::ios::out | std::ios::trunc);
+    if (!ofs.good()) {
+        FileOpenFailed(header_name(dir));
+    }
+    ofs << "ERF_BNDRY_PLANES 2\n" << sizeof(Real) << '\n' << nwriters << '\n' << var_names.size();
+    for (const auto& name : var_names) {
+        ofs << ' ' << name;
+    }
+    ofs << '\n' << all_owners.size() << '\n';
+    for (const auto& o : all_owners) {
+        ofs << o.writer << ' ' << o.ori;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) ofs << ' ' << o.box.smallEnd(d);
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) ofs << ' ' << o.box.bigEnd(d);
+        ofs << '\n';
+    }
+    ofs.flush();
+    if (!ofs.good()) {
+        FileOpenFailed(header_name(dir));
+    }
+}
+
+/**
+ * Rewrites planes.hdr when the patches of a step are not all listed yet, e.g.
+ * on the first step or after the grids changed.  Every rank passes the same
+ * list, so this needs no communication.
+ *
+ * @param dir Folder of the container
+ * @param var_names Variables written in each step
+ * @param owners Patches of the faces in this step and the ranks that write them
+ */
+void
+BndryPlaneContainer::add_owners (const std::string& dir, const Vector<std::string>& var_names,
+                                 const Vector<Owner>& owners)
+{
+    const auto nold = m_owners_out.size();
+    merge_owners(m_owners_out, owners);
+    if (m_owners_out.size() != nold) {
+        write_header(dir, var_names, m_owners_out);
+    }
+}
+
+/**
+ * Appends one block to the data file of this rank and its entry to the index file.
+ *
+ * @param dir Folder of the container
+ * @param t_step Step of the planes
+ * @param patches Table of the patches; the offsets are filled in here
+ * @param fabs Data of the patches, in host memory
+ */
+void
+BndryPlaneContainer::append (const std::string& dir, int t_step,
+                             const Vector<Patch>& patches,
+                             const Vector<const FArrayBox*>& fabs)
+{
+    AMREX_ALWAYS_ASSERT(patches.size() == fabs.size());
+    if (patches.empty()) return;
+
+    const int myproc = ParallelDescriptor::MyProc();
+    if (!m_data_out) {
+        m_data_out  = std::make_unique<std::ofstream>(data_name (dir, myproc), std::ios::binary | std::ios::app);
+        m_index_out = std::make_unique<std::ofstream>(index_name(dir, myproc), std::ios::binary | std::ios::app);
+        if (!m_data_out->good() || !m_index_out->good()) {
+            FileOpenFailed(data_name(dir, myproc));
+        }
+    }
+
+    m_data_out->seekp(0, std::ios::end);
+    const std::int64_t block = m_data_out->tellp();
+
+    const auto npatch = static_cast<std::int32_t>(patches.size());
+    Vector<Patch> table(patches);
+    std::int64_t offset = sizeof(npatch) + npatch * sizeof(Patch);
+    for (int n = 0; n < npatch; ++n) {
+        table[n].offset = offset;
+        offset += fabs[n]->box().numPts() * fabs[n]->nComp() * sizeof(Real);
+    }
+
+    m_data_out->write(reinterpret_cast<const char*>(&npatch), sizeof(npatch));
+    m_data_out->write(reinterpret_cast<const char*>(table.data()), npatch * sizeof(Patch));
+    for (int n = 0; n < npatch; ++n) {
+        m_data_out->write(reinterpret_cast<const char*>(fabs[n]->dataPtr()),
+                          fabs[n]->box().numPts() * fabs[n]->nComp() * sizeof(Real));
+    }
+    m_data_out->flush();
+
+    // The index entry goes last, so a reader never finds a step whose block is incomplete
+    const auto step = static_cast<std::int32_t>(t_step);
+    m_index_out->write(reinterpret_cast<const char*>(&step), sizeof(step));
+    m_index_out->write(reinterpret_cast<const char*>(&block), sizeof(block));
+    m_index_out->flush();
+}
+
+/**
+ * Reads planes.hdr on the I/O processor and broadcasts it. The data files are
+ * only opened by the ranks that read patches, on their first read, and only
+ * for the writers of patches they need.
+ *
+ * @param dir Folder of the container
+ */
+void
+BndryPlaneContainer::open (const std::string& dir)
+{
+    m_dir = dir;
+
+    Vector<char> buf;
+    ParallelDescriptor::ReadAndBcastFile(header_name(dir), buf);
+    std::istringstream iss(std::string(buf.dataPtr()));
+
+    Header h;
+    if (!read_header(iss, h)) {
+        Abort("BndryPlaneContainer: " + header_name(dir) + " is not a boundary plane container");
+    }
+    if (h.real_size != static_cast<int>(sizeof(Real))) {
+        Abort("BndryPlaneContainer: " + header_name(dir) + " was written with a different precision");
+    }
+    m_nwriters = h.nwriters;
+    m_file_var_names = h.var_names;
+    m_has_owners = (h.version >= 2);
+    m_owners = h.owners;
+
+    m_writer_opened.assign(m_nwriters, 0);
+    m_data_in.resize(m_nwriters);
+    m_index_in.resize(m_nwriters);
+    m_index.resize(m_nwriters);
+}
+
+/**
+ * Opens the index and data files of writer w on first use.
+ *
+ * @param w Rank that wrote the files
+ */
+bool
+BndryPlaneContainer::open_writer (int w)
+{
+    if (!m_writer_opened[w]) {
+        m_writer_opened[w] = 1;
+        auto idx = std::make_unique<std::ifstream>(index_name(m_dir, w), std::ios::binary);
+        if (idx->good()) {
+            m_index_in[w] = std::move(idx);
+            m_data_in[w]  = std::make_unique<std::ifstream>(data_name(m_dir, w), std::ios::binary);
+        }
+    }
+    return m_index_in[w] != nullptr;
+}
+
+/**
+ * Finds a step in the index of writer w.  The entries read so far are kept,
+ * and only those appended since are read.  A restart writes its steps again
+ * after those of the run it restarted from, so the steps need not be sorted
+ * or unique; the last entry of a step is the one that counts.
+ *
+ * @param w Rank that wrote the files
+ * @param t_step Step of the planes
+ */
+std::int64_t
+BndryPlaneContainer::find_step (int w, int t_step)
+{
+    std::ifstream& ifs = *m_index_in[w];
+    auto& index = m_index[w];
+
+    ifs.clear();
+    ifs.seekg(0, std::ios::end);
+    const auto nentries = static_cast<std::size_t>(ifs.tellg() / index_entry_size);
+    if (nentries > index.size()) {
+        ifs.seekg(static_cast<std::streamoff>(index.size()) * index_entry_size);
+        for (std::size_t n = index.size(); n < nentries; ++n) {
+            std::int32_t step = -1;
+            std::int64_t block = -1;
+            ifs.read(reinterpret_cast<char*>(&step), sizeof(step));
+            ifs.read(reinterpret_cast<char*>(&block), sizeof(block));
+            if (!ifs.good()) {
+                throw std::runtime_error("cannot read " + index_name(m_dir, w));
+            }
+            index.emplace_back(step, block);
+        }
+    }
+
+    for (auto it = index.rbegin(); it != index.rend(); ++it) {
+        if (it->first == t_step) return it->second;
+    }
+    return -1;
+}
+
+/**
+ * Reads the patches of one step that overlap the local boxes of each face.
+ *
+ * @param t_step Step of the planes
+ * @param var_names Variables to be read in; density is always read
+ * @param local Patches of each face owned by this rank
+ */
+std::unique_ptr<BndryFileData>
+BndryPlaneContainer::read_step (int t_step,
+                                const Vector<std::string>& var_names,
+                                const Array<Vector<Box>, 2*AMREX_SPACEDIM>& local)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Writers of the patches that overlap ours; all of them for a version 1 header
+    Vector<int> needed(m_nwriters, m_has_owners ? 0 : 1);
+    for (const auto& o : m_owners) {
+        const auto& lb = local[o.ori];
+        if (o.writer < m_nwriters &&
+            std::any_of(lb.begin(), lb.end(), [&] (const Box& b) { return b.intersects(o.box); })) {
+            needed[o.writer] = 1;
+        }
+    }
+
+    Vector<std::string> names(var_names);
+    names.push_back("density");
+
+    auto data = std::make_unique<BndryFileData>();
+    for (const auto& name : names) {
+        data->faces[name];
+    }
+
+    for (int w = 0; w < m_nwriters; ++w) {
+        if (!needed[w] || !open_writer(w)) continue;
+        std::ifstream& dfs = *m_data_in[w];
+
+        const std::int64_t block = find_step(w, t_step);
+        if (block < 0) continue;
+
+        std::int32_t npatch = 0;
+        dfs.clear();
+        dfs.seekg(block);
+        dfs.read(reinterpret_cast<char*>(&npatch), sizeof(npatch));
+        Vector<Patch> table(npatch);
+        dfs.read(reinterpret_cast<char*>(table.data()), npatch * sizeof(Patch));
+        if (!dfs.good()) {
+            throw std::runtime_error("cannot read step " + std::to_string(t_step) + " from " + data_name(m_dir, w));
+        }
+
+        for (const auto& p : table) {
+            const std::string& name = m_file_var_names[p.var];
+            if (data->faces.count(name) == 0) continue;
+
+            const Box bx(IntVect(p.lo), IntVect(p.hi));
+            const auto& lb = local[p.ori];
+            if (std::none_of(lb.begin(), lb.end(), [&] (const Box& b) { return b.intersects(bx); })) {
+                continue;
+            }
+
+            PlaneVector& fabs = data->faces[name][p.ori];
+            fabs.emplace_back(bx, p.ncomp, The_Pinned_Arena());
+            dfs.seekg(block + p.offset);
+            dfs.read(reinterpret_cast<char*>(fabs.back().dataPtr()), bx.numPts() * p.ncomp * sizeof(Real));
+            if (!dfs.good()) {
+                throw std::runtime_error("cannot read step " + std::to_string(t_step) + " from " + data_name(m_dir, w));
+            }
+        }
+    }
+    return data;
+}
@@ -0,0 +1,560 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+
+#include "AMReX_FileSystem.H"
+#include "AMReX_ParallelDescriptor.H"
+#include "AMReX_PlotFileUtil.H"
+#include "AMReX_Utility.H"
+#include "AMReX_VisMF.H"
+#include "ERF_CompressedPlotfile.H"
+
+using namespace amrex;
+
+namespace {
+
+using RealBits = std::conditional<sizeof(Real) == sizeof(std::uint64_t),
+                                  std::uint64_t, std::uint32_t>::type;
+
+// Coding of one component of a FAB
+enum : unsigned char { coding_lossless = 2, coding_quantized = 3 };
+
+// Version of the header and of the codings; only the current one is read
+constexpr int compressed_mf_version = 2;
+
+// Prediction of a value from its neighbours at lower i, j and k
+enum : unsigned char { predict_x = 1, predict_x_linear = 2, predict_lorenzo = 3 };
+
+// Quantized values must fit in 62 bits, so that their differences fit in 63
+constexpr double max_quantized = 4.0e18;
+
+std::string header_name (const std::string& prefix) { return prefix + "_Z_H"; }
+std::string data_name (const std::string& prefix, int rank) { return prefix + "_Z_" + std::to_string(rank); }
+
+template <typename T>
+void put_pod (Vector<unsigned char>& out, const T& v)
+{
+    const auto* c = reinterpret_cast<const unsigned char*>(&v);
+    out.insert(out.end(), c, c + sizeof(T));
+}
+
+template <typename T>
+T get_pod (const unsigned char*& p, const unsigned char* end)
+{
+    if (end - p < static_cast<std::ptrdiff_t>(sizeof(T))) {
+        Abort("ReadCompressedMultiFab: truncated FAB record");
+    }
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return v;
+}
+
+// Unsigned LEB128: 7 bits per byte, low bits first
+void put_varint (Vector<unsigned char>& out, std::uint64_t v)
+{
+    while (v >= 0x80) {
+        out.push_back(static_cast<unsigned char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+std::uint64_t get_varint (const unsigned char*& p, const unsigned char* end)
+{
+    std::uint64_t v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const unsigned char b = *p++;
+        v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) return v;
+    }
+    Abort("ReadCompressedMultiFab: truncated component data");
+    return 0;
+}
+
+// Maps small negative and positive differences to small unsigned integers
+std::uint64_t zigzag (std::int64_t d)
+{
+    return (static_cast<std::uint64_t>(d) << 1) ^ static_cast<std::uint64_t>(d >> 63);
+}
+
+std::int64_t unzigzag (std::uint64_t u)
+{
+    return static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1);
+}
+
+// Maps the bits of a Real to an integer that grows with the value, so that
+// nearby values of either sign are nearby integers
+std::uint64_t real_to_ordered (Real x)
+{
+    constexpr RealBits sign = RealBits(1) << (8*sizeof(RealBits) - 1);
+    RealBits b;
+    std::memcpy(&b, &x, sizeof(b));
+    return static_cast<std::uint64_t>((b & sign) ? static_cast<RealBits>(~b) : (b | sign));
+}
+
+Real ordered_to_real (std::uint64_t u)
+{
+    constexpr RealBits sign = RealBits(1) << (8*sizeof(RealBits) - 1);
+    auto b = static_cast<RealBits>(u);
+    b = (b & sign) ? (b & ~sign) : static_cast<RealBits>(~b);
+    Real x;
+    std::memcpy(&x, &b, sizeof(x));
+    return x;
+}
+
+// Value i,j,k of a component laid out like a FAB; neighbours outside the box
+// count as 0, which turns the Lorenzo predictor into its 2D and 1D forms on the
+// faces and edges of the box
+std::uint64_t at (const Vector<std::uint64_t>& m, const IntVect& len, int i, int j, int k)
+{
+    if (i < 0 || j < 0 || k < 0) return 0;
+    return m[i + len[0] * (j + static_cast<Long>(len[1]) * k)];
+}
+
+std::uint64_t predict (const Vector<std::uint64_t>& m, const IntVect& len,
+                       int i, int j, int k, unsigned char predictor)
+{
+    if (predictor == predict_x) {
+        return at(m, len, i-1, j, k);
+    } else if (predictor == predict_x_linear) {
+        return 2*at(m, len, i-1, j, k) - at(m, len, i-2, j, k);
+    } else {
+        return at(m, len, i-1, j  , k  ) + at(m, len, i  , j-1, k  ) + at(m, len, i  , j  , k-1)
+             - at(m, len, i-1, j-1, k  ) - at(m, len, i-1, j  , k-1) - at(m, len, i  , j-1, k-1)
+             + at(m, len, i-1, j-1, k-1);
+    }
+}
+
+unsigned char plane_byte (std::uint64_t u, int b) { return static_cast<unsigned char>(u >> (8*b)); }
+
+// Byte b of every residual, as alternating runs of zero bytes and of literal bytes
+void encode_plane (const Vector<std::uint64_t>& u, int b, Vector<unsigned char>& out)
+{
+    const auto n = static_cast<Long>(u.size());
+    Long i = 0;
+    while (i < n) {
+        Long z = i;
+        while (z < n && plane_byte(u[z], b) == 0) ++z;
+        // A literal run takes in runs of one or two zeros, which are cheaper
+        // as literals than as a zero run and a new literal run
+        Long e = z;
+        while (e < n) {
+            if (plane_byte(u[e], b) != 0) { ++e; continue; }
+            Long ze = e;
+            while (ze < n && ze < e + 3 && plane_byte(u[ze], b) == 0) ++ze;
+            if (ze == n || ze - e == 3) break;
+            e = ze;
+        }
+        put_varint(out, static_cast<std::uint64_t>(z - i));
+        put_varint(out, static_cast<std::uint64_t>(e - z));
+        for (Long j = z; j < e; ++j) {
+            out.push_back(plane_byte(u[j], b));
+        }
+        i = e;
+    }
+}
+
+// Number of bytes up to the most significant one that is not zero
+int significant_bytes (std::uint64_t u)
+{
+    int n = 0;
+    for (; u != 0; u >>= 8) ++n;
+    return n;
+}
+
+// Number of values sampled to choose the predictor of a component
+constexpr Long predictor_samples = 1024;
+
+/*
+ * The predictor whose residuals are smallest on a sample of the values of m,
+ * measured in significant bytes, which is what the byte planes store.  The
+ * sample is strided through the box, with a stride that is not a multiple of
+ * len[0] so that it does not stay on the same x index.
+ */
+unsigned char choose_predictor (const Vector<std::uint64_t>& m, const IntVect& len)
+{
+    const auto n = static_cast<Long>(m.size());
+    Long stride = std::max(n / predictor_samples, Long(1));
+    if (stride > 1 && stride % len[0] == 0) ++stride;
+
+    unsigned char best = predict_lorenzo;
+    Long best_cost = -1;
+    for (unsigned char predictor : {predict_lorenzo, predict_x, predict_x_linear}) {
+        Long cost = 0;
+        for (Long c = 0; c < n; c += stride) {
+            const int i = static_cast<int>(c % len[0]);
+            const int j = static_cast<int>((c / len[0]) % len[1]);
+            const int k = static_cast<int>(c / (static_cast<Long>(len[0]) * len[1]));
+            cost += significant_bytes(zigzag(static_cast<std::int64_t>(m[c] - predict(m, len, i, j, k, predictor))));
+        }
+        if (best_cost < 0 || cost < best_cost) {
+            best = predictor;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+/*
+ * Codes the integers m of a component of a box with lengths len: each value is
+ * predicted from its neighbours at lower indices, and the zigzagged residuals
+ * are split into byte planes, most significant first, each stored as runs of
+ * zero and literal bytes.  The residuals of a smooth field leave the high
+ * planes nearly empty, and values with short mantissas leave the low planes
+ * empty.  The predictor is chosen on a sample of the values and stored first.
+ */
+void encode_ints (const Vector<std::uint64_t>& m, const IntVect& len, Vector<unsigned char>& out)
+{
+    const unsigned char predictor = choose_predictor(m, len);
+    Vector<std::uint64_t> u(m.size());
+    Long c = 0;
+    for (int k = 0; k < len[2]; ++k) {
+        for (int j = 0; j < len[1]; ++j) {
+            for (int i = 0; i < len[0]; ++i, ++c) {
+                u[c] = zigzag(static_cast<std::int64_t>(m[c] - predict(m, len, i, j, k, predictor)));
+            }
+        }
+    }
+    out.push_back(predictor);
+    for (int b = 7; b >= 0; --b) {
+        encode_plane(u, b, out);
+    }
+}
+
+void decode_ints (const unsigned char* p, const unsigned char* end, const IntVect& len,
+                  Vector<std::uint64_t>& m)
+{
+    const auto predictor = get_pod<unsigned char>(p, end);
+    if (predictor < predict_x || predictor > predict_lorenzo) {
+        Abort("ReadCompressedMultiFab: unknown predictor in component data");
+    }
+    const auto n = static_cast<Long>(m.size());
+    Vector<std::uint64_t> u(n, 0);
+    for (int b = 7; b >= 0; --b) {
+        Long i = 0;
+        while (i < n) {
+            const auto z = static_cast<Long>(get_varint(p, end));
+            const auto l = static_cast<Long>(get_varint(p, end));
+            if (z > n - i || l > n - i - z || end - p < l) {
+                Abort("ReadCompressedMultiFab: truncated component data");
+            }
+            i += z;
+            for (Long j = 0; j < l; ++j) {
+                u[i++] |= static_cast<std::uint64_t>(*p++) << (8*b);
+            }
+        }
+    }
+    Long c = 0;
+    for (int k = 0; k < len[2]; ++k) {
+        for (int j = 0; j < len[1]; ++j) {
+            for (int i = 0; i < len[0]; ++i, ++c) {
+                m[c] = predict(m, len, i, j, k, predictor) + static_cast<std::uint64_t>(unzigzag(u[c]));
+            }
+        }
+    }
+}
+
+// Returns false if a value cannot be quantized with q
+bool quantize (const Real* v, Long n, Real q, Vector<std::uint64_t>& m)
+{
+    for (Long i = 0; i < n; ++i) {
+        const double s = static_cast<double>(v[i]) / static_cast<double>(q);
+        if (!(std::abs(s) < max_quantized)) return false; // also catches NaN and Inf
+        m[i] = static_cast<std::uint64_t>(std::llround(s));
+    }
+    return true;
+}
+
+/**
+ * Codes all components of a host FAB into out: for each component the coding,
+ * the quantum, the number of bytes and the coded values.
+ */
+void encode_fab (const FArrayBox& fab, const Vector<Real>& quanta, Vector<unsigned char>& out)
+{
+    const IntVect len = fab.box().length();
+    const Long npts = fab.box().numPts();
+    Vector<std::uint64_t> m(npts);
+    Vector<unsigned char> comp;
+    for (int n = 0; n < fab.nComp(); ++n) {
+        const Real* v = fab.dataPtr(n);
+        unsigned char coding = coding_lossless;
+        if (quanta[n] > 0.0 && quantize(v, npts, quanta[n], m)) {
+            coding = coding_quantized;
+        } else {
+            for (Long i = 0; i < npts; ++i) {
+                m[i] = real_to_ordered(v[i]);
+            }
+        }
+        comp.clear();
+        encode_ints(m, len, comp);
+        put_pod(out, coding);
+        put_pod(out, (coding == coding_quantized) ? quanta[n] : Real(0.0));
+        put_pod(out, static_cast<std::int64_t>(comp.size()));
+        out.insert(out.end(), comp.begin(), comp.end());
+    }
+}
+
+void decode_fab (const unsigned char* p, const unsigned char* end, FArrayBox& fab)
+{
+    const IntVect len = fab.box().length();
+    const Long npts = fab.box().numPts();
+    Vector<std::uint64_t> m(npts);
+    for (int n = 0; n < fab.nComp(); ++n) {
+        const auto coding = get_pod<unsigned char>(p, end);
+        const auto q      = get_pod<Real>(p, end);
+        const auto nbytes = get_pod<std::int64_t>(p, end);
+        if (nbytes < 0 || end - p < nbytes) {
+            Abort("ReadCompressedMultiFab: truncated FAB record");
+        }
+        const unsigned char* cend = p + nbytes;
+        Real* v = fab.dataPtr(n);
+        if (coding == coding_lossless || coding == coding_quantized) {
+            decode_ints(p, cend, len, m);
+            for (Long i = 0; i < npts; ++i) {
+                v[i] = (coding == coding_lossless)
+                    ? ordered_to_real(m[i])
+                    : static_cast<Real>(static_cast<double>(static_cast<std::int64_t>(m[i])) * static_cast<double>(q));
+            }
+        } else {
+            Abort("ReadCompressedMultiFab: unknown coding of a component");
+        }
+        p = cend;
+    }
+}
+
+} // namespace
+
+/**
+ * Every rank codes the valid boxes it owns and writes them to its own data
+ * file; the I/O processor then writes the header with the offsets of all FABs.
+ *
+ * @param mf Data to be written
+ * @param prefix Path of the MultiFab, e.g. plt00010/Level_0/Cell
+ * @param quanta Absolute precision of each component; 0 for lossless
+ * @param verbose Print the compression ratio if > 0
+ */
+void
+WriteCompressedMultiFab (const MultiFab& mf, const std::string& prefix, const Vector<Real>& quanta,
+                         int verbose)
+{
+    BL_PROFILE("WriteCompressedMultiFab()");
+
+    const int ncomp = mf.nComp();
+    AMREX_ALWAYS_ASSERT(quanta.size() == ncomp);
+
+    const BoxArray& ba = mf.boxArray();
+    const int nfabs = static_cast<int>(ba.size());
+    const int myproc = ParallelDescriptor::MyProc();
+
+    Vector<Long> offsets(nfabs, 0);
+    Vector<Long> nbytes(nfabs, 0);
+
+    std::ofstream ofs;
+    Long offset = 0;
+    Vector<unsigned char> buf;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        FArrayBox host(bx, ncomp, The_Pinned_Arena());
+        host.copy<RunOn::Device>(mf[mfi], bx, 0, bx, 0, ncomp);
+        Gpu::streamSynchronize();
+
+        buf.clear();
+        encode_fab(host, quanta, buf);
+
+        if (!ofs.is_open()) {
+            ofs.open(data_name(prefix, myproc), std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!ofs.good()) {
+                FileOpenFailed(data_name(prefix, myproc));
+            }
+        }
+        ofs.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+
+        offsets[mfi.index()] = offset;
+        nbytes [mfi.index()] = buf.size();
+        offset += buf.size();
+    }
+    if (ofs.is_open()) {
+        ofs.flush();
+        if (!ofs.good()) {
+            Abort("WriteCompressedMultiFab: cannot write " + data_name(prefix, myproc));
+        }
+    }
+
+    ParallelDescriptor::ReduceLongSum(offsets.dataPtr(), nfabs, ParallelDescriptor::IOProcessorNumber());
+    ParallelDescriptor::ReduceLongSum(nbytes.dataPtr() , nfabs, ParallelDescriptor::IOProcessorNumber());
+
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ofstream hdr(header_name(prefix), std::ios::out | std::ios::trunc);
+        if (!hdr.good()) {
+            FileOpenFailed(header_name(prefix));
+        }
+        hdr.precision(17);
+        hdr << "ERF_COMPRESSED_MF " << compressed_mf_version << '\n' << sizeof(Real) << '\n' << ncomp << '\n';
+        for (int n = 0; n < ncomp; ++n) {
+            hdr << quanta[n] << ' ';
+        }
+        hdr << '\n';
+        ba.writeOn(hdr);
+        hdr << '\n' << nfabs << '\n';
+        const DistributionMapping& dm = mf.DistributionMap();
+        for (int i = 0; i < nfabs; ++i) {
+            hdr << dm[i] << ' ' << offsets[i] << ' ' << nbytes[i] << '\n';
+        }
+
+        if (verbose > 0) {
+            Long coded = 0;
+            for (int i = 0; i < nfabs; ++i) {
+                coded += nbytes[i];
+            }
+            const Long raw = ba.numPts() * ncomp * static_cast<Long>(sizeof(Real));
+            Print() << "Compressed " << prefix << ": " << raw << " bytes into " << coded
+                    << ", compression ratio " << static_cast<Real>(raw) / static_cast<Real>(std::max(coded, Long(1)))
+                    << "\n";
+        }
+    }
+}
+
+/**
+ * Every rank reads the FABs it owns from the data files they were written to,
+ * so the reader may run on a different number of ranks than the writer.
+ *
+ * @param mf Data to be read in; defined here if it is not defined yet
+ * @param prefix Path of the MultiFab, e.g. plt00010/Level_0/Cell
+ */
+void
+ReadCompressedMultiFab (MultiFab& mf, const std::string& prefix)
+{
+    BL_PROFILE("ReadCompressedMultiFab()");
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(header_name(prefix), fileCharPtr);
+    std::istringstream is(std::string(fileCharPtr.dataPtr()));
+
+    std::string magic;
+    int version = 0, real_size = 0, ncomp = 0;
+    is >> magic >> version >> real_size >> ncomp;
+    if (magic != "ERF_COMPRESSED_MF") {
+        Abort("ReadCompressedMultiFab: " + header_name(prefix) + " is not a compressed MultiFab");
+    }
+    if (version != compressed_mf_version) {
+        Abort("ReadCompressedMultiFab: " + header_name(prefix) + " was written by another version of the format");
+    }
+    if (real_size != static_cast<int>(sizeof(Real))) {
+        Abort("ReadCompressedMultiFab: " + header_name(prefix) + " was written with a different precision");
+    }
+    Vector<Real> quanta(ncomp);
+    for (auto& q : quanta) {
+        is >> q;
+    }
+
+    BoxArray ba;
+    ba.readFrom(is);
+
+    int nfabs = 0;
+    is >> nfabs;
+    AMREX_ALWAYS_ASSERT(nfabs == ba.size());
+    Vector<int>  ranks(nfabs);
+    Vector<Long> offsets(nfabs);
+    Vector<Long> nbytes(nfabs);
+    for (int i = 0; i < nfabs; ++i) {
+        is >> ranks[i] >> offsets[i] >> nbytes[i];
+    }
+
+    if (!mf.ok()) {
+        mf.define(ba, DistributionMapping{ba}, ncomp, 0);
+    }
+    AMREX_ALWAYS_ASSERT(mf.boxArray() == ba && mf.nComp() == ncomp);
+
+    std::map<int, std::unique_ptr<std::ifstream>> files;
+    Vector<unsigned char> buf;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const int i = mfi.index();
+        auto& ifs = files[ranks[i]];
+        if (!ifs) {
+            ifs = std::make_unique<std::ifstream>(data_name(prefix, ranks[i]), std::ios::binary);
+            if (!ifs->good()) {
+                FileOpenFailed(data_name(prefix, ranks[i]));
+            }
+        }
+        buf.resize(nbytes[i]);
+        ifs->seekg(offsets[i]);
+        ifs->read(reinterpret_cast<char*>(buf.data()), nbytes[i]);
+        if (!ifs->good()) {
+            Abort("ReadCompressedMultiFab: cannot read " + data_name(prefix, ranks[i]));
+        }
+
+        const Box& bx = mfi.validbox();
+        FArrayBox host(bx, ncomp, The_Pinned_Arena());
+        decode_fab(buf.data(), buf.data() + buf.size(), host);
+        mf[mfi].copy<RunOn::Device>(host, bx, 0, bx, 0, ncomp);
+        Gpu::streamSynchronize();
+    }
+}
+
+/**
+ * Copies the Header and job_info of the compressed plotfile and writes each
+ * compressed MultiFab of every level with VisMF, so the result is a native
+ * plotfile.
+ *
+ * @param in_name Compressed plotfile
+ * @param out_name Native plotfile to be written
+ */
+void
+DecompressPlotfile (const std::string& in_name, const std::string& out_name)
+{
+    BL_PROFILE("DecompressPlotfile()");
+
+    Print() << "Decompressing plotfile " << in_name << " into " << out_name << "\n";
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(in_name + "/Header", fileCharPtr);
+    const std::string header(fileCharPtr.dataPtr());
+    std::istringstream is(header);
+
+    // version, variables, dimension, time and finest level
+    std::string word;
+    int ncomp = 0, dim = 0, finest_level = 0;
+    Real time = 0.0;
+    is >> word >> ncomp;
+    for (int n = 0; n < ncomp; ++n) {
+        is >> word;
+    }
+    is >> dim >> time >> finest_level;
+    const int nlevels = finest_level + 1;
+
+    PreBuildDirectorHierarchy(out_name, "Level_", nlevels, true);
+
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ofstream ofs(out_name + "/Header", std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!ofs.good()) {
+            FileOpenFailed(out_name + "/Header");
+        }
+        ofs.write(header.data(), header.size());
+
+        std::ifstream job_in(in_name + "/job_info");
+        if (job_in.good()) {
+            std::ofstream job_out(out_name + "/job_info", std::ios::out | std::ios::trunc);
+            job_out << job_in.rdbuf();
+        }
+    }
+
+    for (int lev = 0; lev < nlevels; ++lev) {
+        for (const std::string mf_prefix : {"Cell", "Nu_nd"}) {
+            const std::string in_mf = MultiFabFileFullPrefix(lev, in_name, "Level_", mf_prefix);
+            if (!FileSystem::Exists(header_name(in_mf))) continue;
+
+            MultiFab mf;
+            ReadCompressedMultiFab(mf, in_mf);
+            VisMF::Write(mf, MultiFabFileFullPrefix(lev, out_name, "Level_", mf_prefix));
+        }
+    }
+}
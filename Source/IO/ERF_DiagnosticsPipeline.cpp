@@ -0,0 +1,92 @@
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <algorithm>
+#include <ERF_DiagnosticsPipeline.H>
+
+using namespace amrex;
+
+DiagnosticsPipeline::DiagnosticsPipeline (int max_queued)
+    : m_max_queued(std::max(max_queued,1))
+{
+    m_thread = std::thread(&DiagnosticsPipeline::worker, this);
+}
+
+DiagnosticsPipeline::~DiagnosticsPipeline ()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+    }
+    m_cv_task.notify_one();
+    m_thread.join();
+
+    if (!m_error.empty()) {
+        amrex::AllPrint() << "DiagnosticsPipeline: " << m_error << std::endl;
+    }
+}
+
+void
+DiagnosticsPipeline::submit (std::function<void()>&& task)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_slot.wait(lock, [this] { return static_cast<int>(m_queue.size()) < m_max_queued; });
+        m_queue.push_back(std::move(task));
+    }
+    m_cv_task.notify_one();
+    check_error();
+}
+
+void
+DiagnosticsPipeline::flush ()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_slot.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+    }
+    check_error();
+}
+
+void
+DiagnosticsPipeline::check_error ()
+{
+    std::string msg;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        msg = m_error;
+    }
+    if (!msg.empty()) {
+        amrex::Abort("DiagnosticsPipeline: " + msg);
+    }
+}
+
+void
+DiagnosticsPipeline::worker ()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv_task.wait(lock, [this] { return m_done || !m_queue.empty(); });
+            // Drain the queue before exiting so nothing is lost at shutdown
+            if (m_queue.empty()) return;
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_busy = true;
+        }
+        m_cv_slot.notify_all();
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_error.empty()) m_error = e.what();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busy = false;
+        }
+        m_cv_slot.notify_all();
+    }
+}
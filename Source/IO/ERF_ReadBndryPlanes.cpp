@@ -1,7 +1,14 @@
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
 #include "AMReX_Gpu.H"
 #include "AMReX_ParmParse.H"
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_VisMF.H>
 #include "ERF_ReadBndryPlanes.H"
+#include "ERF_BndryPlaneLayout.H"
+#include "ERF_BndryPlaneContainer.H"
 #include "IndexDefines.H"
 #include "AMReX_MultiFabUtil.H"
 #include "EOS.H"
@@ -37,39 +44,92 @@ IntVect offset (const int face_dir, const int normal)
 }
 
 /**
- * Function in ReadBndryPlanes class for allocating space
- * for the boundary plane data ERF will need.
+ * Read the fabs of a face that overlap the patches in local straight from the
+ * VisMF files, without any communication, so that it can run on a helper thread.
+ */
+static void read_face_fabs (const std::string& facename, const Vector<Box>& local, PlaneVector& fabs)
+{
+    std::ifstream hfs(facename + "_H");
+    if (!hfs.good()) {
+        throw std::runtime_error("cannot open " + facename + "_H");
+    }
+    VisMF::Header hdr;
+    hfs >> hdr;
+    if (hdr.m_vers != VisMF::Header::Version_v1) {
+        throw std::runtime_error(facename + "_H is not a version 1 VisMF header");
+    }
+
+    // The data files are named relative to the directory of the header
+    const auto slash = facename.rfind('/');
+    const std::string dir = (slash == std::string::npos) ? "" : facename.substr(0, slash+1);
+
+    for (int i = 0; i < hdr.m_ba.size(); ++i) {
+        const Box& fbx = hdr.m_ba[i];
+        if (std::none_of(local.begin(), local.end(), [&] (const Box& b) { return b.intersects(fbx); })) {
+            continue;
+        }
+        const auto& fod = hdr.m_fod[i];
+        std::ifstream dfs(dir + fod.m_name, std::ios::binary);
+        if (!dfs.good()) {
+            throw std::runtime_error("cannot open " + dir + fod.m_name);
+        }
+        dfs.seekg(fod.m_head, std::ios::beg);
+        fabs.emplace_back(The_Pinned_Arena());
+        fabs.back().readFrom(dfs);
+    }
+}
+
+/**
+ * Read the local patches of every face of density and of the variables in var_names
+ * from one boundary file
+ *
+ * @param chkname Directory of the file, e.g. BndryFiles/bndry_output00010
+ * @param var_names Variables to be read in
+ * @param local Patches of each face owned by this rank
+ */
+static std::unique_ptr<BndryFileData>
+read_bndry_file (const std::string& chkname, const Vector<std::string>& var_names,
+                 const Array<Vector<Box>, 2*AMREX_SPACEDIM>& local)
+{
+    auto data = std::make_unique<BndryFileData>();
+
+    Vector<std::string> names(var_names);
+    names.push_back("density");
+
+    for (const auto& name : names) {
+        if (data->faces.count(name) > 0) continue;
+        auto& faces = data->faces[name];
+        std::string filename = MultiFabFileFullPrefix(0, chkname, "Level_", name);
+        for (OrientationIter oit; oit != nullptr; ++oit) {
+            auto ori = oit();
+            if (ori.coordDir() < 2 && !local[ori].empty()) {
+                read_face_fabs(Concatenate(filename + '_', ori, 1), local[ori], faces[ori]);
+            }
+        }
+    }
+    return data;
+}
+
+/**
+ * Function in ReadBndryPlanes class for allocating space for the boundary
+ * plane data ERF will need, distributed like the face patches.  Planes that
+ * were already read on another layout are moved to the current one.
  */
 void ReadBndryPlanes::define_level_data (int /*lev*/)
 {
-    Print() << "ReadBndryPlanes::define_level_data" << std::endl;
-    // *********************************************************
-    // Allocate space for all of the boundary planes we may need
-    // *********************************************************
     int ncomp = BCVars::NumTypes;
-    const Box& domain = m_geom.Domain();
     for (OrientationIter oit; oit != nullptr; ++oit) {
         auto ori = oit();
         if (ori.coordDir() < 2) {
-
-            m_data_n[ori]      = std::make_unique<PlaneVector>();
-            m_data_np1[ori]    = std::make_unique<PlaneVector>();
-            m_data_np2[ori]    = std::make_unique<PlaneVector>();
-            m_data_interp[ori] = std::make_unique<PlaneVector>();
-
-            const auto& lo = domain.loVect();
-            const auto& hi = domain.hiVect();
-
-            IntVect plo(lo);
-            IntVect phi(hi);
-            const int normal = ori.coordDir();
-            plo[normal] = ori.isHigh() ? hi[normal] + 1 : -1;
-            phi[normal] = ori.isHigh() ? hi[normal] + 1 : -1;
-            const Box pbx(plo, phi);
-            m_data_n[ori]->push_back(FArrayBox(pbx, ncomp));
-            m_data_np1[ori]->push_back(FArrayBox(pbx, ncomp));
-            m_data_np2[ori]->push_back(FArrayBox(pbx, ncomp));
-            m_data_interp[ori]->push_back(FArrayBox(pbx, ncomp));
+            for (auto* data : {&m_data_n, &m_data_np1, &m_data_np2, &m_data_interp}) {
+                auto plane = std::make_unique<MultiFab>(m_plane_ba[ori], m_face_dm[ori], ncomp, 0);
+                if ((*data)[ori]) {
+                    plane->ParallelCopy(*(*data)[ori], 0, 0, ncomp);
+                } else {
+                    plane->setVal(0.0);
+                }
+                (*data)[ori] = std::move(plane);
+            }
         }
     }
 }
@@ -80,7 +140,7 @@ void ReadBndryPlanes::define_level_data (int /*lev*/)
  *
  * @param time Constant specifying the time for interpolation
  */
-Vector<std::unique_ptr<PlaneVector>>&
+Vector<std::unique_ptr<MultiFab>>&
 ReadBndryPlanes::interp_in_time (const Real& time)
 {
     AMREX_ALWAYS_ASSERT(m_tn <= time && time <= m_tnp2);
@@ -96,39 +156,134 @@ ReadBndryPlanes::interp_in_time (const Real& time)
 
         // We must now interpolate to a new time
         m_tinterp = time;
+        m_copies_current = false;
 
-        if (time < m_tnp1) {
-            for (OrientationIter oit; oit != nullptr; ++oit) {
-                auto ori = oit();
-                if (ori.coordDir() < 2) {
-                    const int nlevels = m_data_n[ori]->size();
-                    for (int lev = 0; lev < nlevels; ++lev) {
-                        const auto& datn   = (*m_data_n[ori])[lev];
-                        const auto& datnp1 = (*m_data_np1[ori])[lev];
-                        auto& dati = (*m_data_interp[ori])[lev];
-                        dati.linInterp<RunOn::Device>(
-                            datn, 0, datnp1, 0, m_tn, m_tnp1, m_tinterp, datn.box(), 0, dati.nComp());
-                    }
-                }
+        const bool first = (time < m_tnp1);
+        const Real t0 = (first) ? m_tn   : m_tnp1;
+        const Real t1 = (first) ? m_tnp1 : m_tnp2;
+        const Real alpha = (t1 - time) / (t1 - t0);
+
+        for (OrientationIter oit; oit != nullptr; ++oit) {
+            auto ori = oit();
+            if (ori.coordDir() < 2) {
+                const MultiFab& dat0 = (first) ? *m_data_n[ori]   : *m_data_np1[ori];
+                const MultiFab& dat1 = (first) ? *m_data_np1[ori] : *m_data_np2[ori];
+                MultiFab& dati = *m_data_interp[ori];
+                MultiFab::LinComb(dati, alpha, dat0, 0, Real(1.0) - alpha, dat1, 0, 0, dati.nComp(), 0);
             }
-        } else {
-            for (OrientationIter oit; oit != nullptr; ++oit) {
-                auto ori = oit();
-                if (ori.coordDir() < 2) {
-                    const int nlevels = m_data_n[ori]->size();
-                    for (int lev = 0; lev < nlevels; ++lev) {
-                        const auto& datnp1 = (*m_data_np1[ori])[lev];
-                        const auto& datnp2 = (*m_data_np2[ori])[lev];
-                        auto& dati = (*m_data_interp[ori])[lev];
-                        dati.linInterp<RunOn::Device>(
-                            datnp1, 0, datnp2, 0, m_tnp1, m_tnp2, m_tinterp, datnp1.box(), 0,
-                            dati.nComp());
+        }
+    }
+    return m_data_interp;
+}
+
+/**
+ * Function in ReadBndryPlanes class for gathering the pieces of the planes,
+ * interpolated to time, that the boxes of mfs, grown by their ghost cells,
+ * read when those are filled.  Box i of every MultiFab must be the same grid,
+ * owned by the same rank, so that one plane per box holds what all of them
+ * read and each face takes a single copy.  The layout is kept while the
+ * MultiFabs keep theirs, and the copy while the interpolated planes are
+ * unchanged.
+ *
+ * @param time Time at which the planes are needed
+ * @param mfs MultiFabs to be filled
+ */
+const BndryPlaneCopies&
+ReadBndryPlanes::planes_for (const Real& time, const Vector<MultiFab*>& mfs)
+{
+    interp_in_time(time);
+
+    bool same_layout = (m_copy_ba.size() == mfs.size());
+    for (int v = 0; same_layout && v < mfs.size(); ++v) {
+        same_layout = (m_copy_ba[v]    == mfs[v]->boxArray()) &&
+                      (m_copy_dm[v]    == mfs[v]->DistributionMap()) &&
+                      (m_copy_ngrow[v] == mfs[v]->nGrowVect());
+    }
+    if (!same_layout) {
+        set_plane_copies(mfs);
+    }
+
+    if (!m_copies_current) {
+        for (OrientationIter oit; oit != nullptr; ++oit) {
+            auto ori = oit();
+            MultiFab& planes = m_plane_copies.planes[ori];
+            if (ori.coordDir() < 2 && !planes.empty()) {
+                planes.ParallelCopy(*m_data_interp[ori], 0, 0, planes.nComp());
+            }
+        }
+        m_copies_current = true;
+    }
+    return m_plane_copies;
+}
+
+/**
+ * Function in ReadBndryPlanes class for laying out the planes that the boxes
+ * of mfs read, one per box that touches each face, over the union of what the
+ * boxes of every MultiFab read there.
+ *
+ * @param mfs MultiFabs to be filled
+ */
+void ReadBndryPlanes::set_plane_copies (const Vector<MultiFab*>& mfs)
+{
+    AMREX_ALWAYS_ASSERT(!mfs.empty());
+    const int nboxes = mfs[0]->boxArray().size();
+    const DistributionMapping& dm = mfs[0]->DistributionMap();
+
+    m_copy_ba.clear();
+    m_copy_dm.clear();
+    m_copy_ngrow.clear();
+    for (const auto* mf : mfs) {
+        AMREX_ALWAYS_ASSERT(mf->boxArray().size() == nboxes && mf->DistributionMap() == dm);
+        m_copy_ba.push_back(mf->boxArray());
+        m_copy_dm.push_back(mf->DistributionMap());
+        m_copy_ngrow.push_back(mf->nGrowVect());
+    }
+
+    const Box& domain = m_geom.Domain();
+    for (OrientationIter oit; oit != nullptr; ++oit) {
+        auto ori = oit();
+        if (ori.coordDir() < 2) {
+            const int normal = ori.coordDir();
+            const int plane  = ori.isHigh() ? domain.bigEnd(normal) + 1 : domain.smallEnd(normal) - 1;
+
+            BoxList bl;
+            Vector<int> pmap;
+            Vector<int>& plane_index = m_plane_copies.index[ori];
+            plane_index.assign(nboxes, -1);
+            for (int i = 0; i < nboxes; ++i) {
+                Box pbx;
+                for (const auto* mf : mfs) {
+                    const Box& gbx = amrex::grow(mf->boxArray()[i], mf->nGrowVect());
+                    const bool touches = ori.isHigh() ? gbx.bigEnd(normal)   >= domain.bigEnd(normal)
+                                                      : gbx.smallEnd(normal) <= domain.smallEnd(normal);
+                    if (!touches) continue;
+
+                    // The fill clamps the tangential indices to the domain
+                    IntVect lo = gbx.smallEnd();
+                    IntVect hi = gbx.bigEnd();
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        lo[d] = std::min(std::max(lo[d], domain.smallEnd(d)), domain.bigEnd(d));
+                        hi[d] = std::min(std::max(hi[d], domain.smallEnd(d)), domain.bigEnd(d));
                     }
+                    lo[normal] = plane;
+                    hi[normal] = plane;
+                    pbx = pbx.ok() ? amrex::minBox(pbx, Box(lo, hi)) : Box(lo, hi);
                 }
+                if (!pbx.ok()) continue;
+
+                plane_index[i] = static_cast<int>(pmap.size());
+                bl.push_back(pbx);
+                pmap.push_back(dm[i]);
+            }
+
+            MultiFab& planes = m_plane_copies.planes[ori];
+            planes.clear();
+            if (!pmap.empty()) {
+                planes.define(BoxArray(bl), DistributionMapping(pmap), m_data_interp[ori]->nComp(), 0);
             }
         }
     }
-    return m_data_interp;
+    m_copies_current = false;
 }
 
 /**
@@ -146,6 +301,10 @@ ReadBndryPlanes::ReadBndryPlanes (const Geometry& geom, const Real& rdOcp_in)
 
     last_file_read = -1;
 
+    // How many files to read ahead on a helper thread
+    pp.query("bndry_prefetch", m_prefetch_depth);
+    AMREX_ALWAYS_ASSERT(m_prefetch_depth >= 0);
+
     m_tinterp = -1.;
 
     // What folder will the time series of planes be read from
@@ -182,6 +341,17 @@ ReadBndryPlanes::ReadBndryPlanes (const Geometry& geom, const Real& rdOcp_in)
     // time.dat will be in the same folder as the time series of data
     m_time_file = m_filename + "/time.dat";
 
+    // The planes are either in a folder per step or in a container
+    int is_container = 0;
+    if (ParallelDescriptor::IOProcessor()) {
+        is_container = FileExists(BndryPlaneContainer::header_name(m_filename)) ? 1 : 0;
+    }
+    ParallelDescriptor::Bcast(&is_container, 1, ParallelDescriptor::IOProcessorNumber());
+    if (is_container) {
+        m_container = std::make_unique<BndryPlaneContainer>();
+        m_container->open(m_filename);
+    }
+
     // each pointer (at at given time) has 6 components, one for each orientation
     // TODO: we really only need 4 not 6
     int size = 2*AMREX_SPACEDIM;
@@ -191,6 +361,9 @@ ReadBndryPlanes::ReadBndryPlanes (const Geometry& geom, const Real& rdOcp_in)
     m_data_interp.resize(size);
 }
 
+// Defined here, where BndryPlaneContainer is complete
+ReadBndryPlanes::~ReadBndryPlanes () = default;
+
 /**
  * Function in ReadBndryPlanes class for reading the external file
  * specifying time data and broadcasting this data across MPI ranks.
@@ -206,16 +379,32 @@ void ReadBndryPlanes::read_time_file ()
 
     if (ParallelDescriptor::IOProcessor()) {
 
-        std::string line;
         std::ifstream time_file(m_time_file);
         if (!time_file.good()) {
             Abort("Cannot find time file: " + m_time_file);
         }
-        while (std::getline(time_file, line)) {
-            ++time_file_length;
+        m_in_timesteps.clear();
+        m_in_times.clear();
+        int step;
+        Real time;
+        while (time_file >> step >> time) {
+            // A restart writes its steps again after those of the run it
+            // restarted from; the later entries replace the earlier ones
+            while (!m_in_timesteps.empty() && m_in_timesteps.back() >= step) {
+                m_in_timesteps.pop_back();
+                m_in_times.pop_back();
+            }
+            m_in_timesteps.push_back(step);
+            m_in_times.push_back(time);
         }
-
         time_file.close();
+        time_file_length = static_cast<int>(m_in_times.size());
+
+        // Sanity check that there are no mis-orderings
+        for (int i = 1; i < time_file_length; ++i) {
+            if (m_in_times[i] <= m_in_times[i-1])
+                Error("Bad time in time.dat file");
+        }
     }
 
     ParallelDescriptor::Bcast(
@@ -226,21 +415,6 @@ void ReadBndryPlanes::read_time_file ()
     m_in_times.resize(time_file_length);
     m_in_timesteps.resize(time_file_length);
 
-    if (ParallelDescriptor::IOProcessor()) {
-        std::ifstream time_file(m_time_file);
-        for (int i = 0; i < time_file_length; ++i) {
-            time_file >> m_in_timesteps[i] >> m_in_times[i];
-        }
-        // Sanity check that there are no duplicates or mis-orderings
-        for (int i = 1; i < time_file_length; ++i) {
-            if (m_in_timesteps[i] <= m_in_timesteps[i-1])
-                Error("Bad timestep in time.dat file");
-            if (m_in_times[i] <= m_in_times[i-1])
-                Error("Bad time in time.dat file");
-        }
-        time_file.close();
-    }
-
     ParallelDescriptor::Bcast(
         m_in_timesteps.data(), time_file_length,
         ParallelDescriptor::IOProcessorNumber(),
@@ -251,10 +425,8 @@ void ReadBndryPlanes::read_time_file ()
         ParallelDescriptor::IOProcessorNumber(),
         ParallelDescriptor::Communicator());
 
-    // Allocate data we will need -- for now just at one level
-    int lev = 0;
-    define_level_data(lev);
-    Print() << "Successfully read time file and allocated data" << std::endl;
+    // The data are allocated by read_input_files, once the layout of the faces is known
+    Print() << "Successfully read time file" << std::endl;
 }
 
 /**
@@ -263,27 +435,25 @@ void ReadBndryPlanes::read_time_file ()
  *
  * @param time Current time
  * @param dt Current timestep
+ * @param grids BoxArray at level 0, which sets how the faces are split over the ranks
+ * @param dmap DistributionMapping at level 0
  * @param m_bc_extdir_vals Container storing the external dirichlet boundary conditions we are reading from the input files
  */
 void ReadBndryPlanes::read_input_files (Real time,
                                         Real dt,
+                                        const BoxArray& grids,
+                                        const DistributionMapping& dmap,
                                         Array<Array<Real, AMREX_SPACEDIM*2>,AMREX_SPACEDIM+NVAR_max> m_bc_extdir_vals)
 {
     BL_PROFILE("ERF::ReadBndryPlanes::read_input_files");
 
+    set_layout(grids, dmap);
+
     // Assert that both the current time and the next time are within the bounds
     // of the data that we can read
     AMREX_ALWAYS_ASSERT((m_in_times[0] <= time) && (time <= m_in_times.back()));
     AMREX_ALWAYS_ASSERT((m_in_times[0] <= time+dt) && (time+dt <= m_in_times.back()));
 
-    int ncomp = 1;
-
-    const Box& domain = m_geom.Domain();
-    BoxArray ba(domain);
-    DistributionMapping dm{ba};
-    BndryRegister bndryn(ba, dm, m_in_rad, m_out_rad, m_extent_rad, ncomp);
-    bndryn.setVal(1.0e13);
-
     // The first time we enter this routine we read the first three files
     if (last_file_read == -1)
     {
@@ -327,6 +497,9 @@ void ReadBndryPlanes::read_input_files (Real time,
         last_file_read = new_read;
     }
 
+    // Keep the helper thread busy with the files we will need next
+    start_prefetch();
+
     AMREX_ASSERT(time    >= m_tn && time    <= m_tnp2);
     AMREX_ASSERT(time+dt >= m_tn && time+dt <= m_tnp2);
 }
@@ -340,7 +513,7 @@ void ReadBndryPlanes::read_input_files (Real time,
  * @param m_bc_extdir_vals Container storing the external dirichlet boundary conditions we are reading from the input files
  */
 void ReadBndryPlanes::read_file (const int idx,
-                                 Vector<std::unique_ptr<PlaneVector>>& data_to_fill,
+                                 Vector<std::unique_ptr<MultiFab>>& data_to_fill,
                                  Array<Array<Real, AMREX_SPACEDIM*2>,AMREX_SPACEDIM+NVAR_max> m_bc_extdir_vals)
 {
     const int t_step = m_in_timesteps[idx];
@@ -349,9 +522,19 @@ void ReadBndryPlanes::read_file (const int idx,
     const std::string level_prefix = "Level_";
     const int lev = 0;
 
-    const Box& domain = m_geom.Domain();
-    BoxArray ba(domain);
-    DistributionMapping dm{ba};
+    // Faces read ahead by the helper thread, if any
+    std::unique_ptr<BndryFileData> prefetched;
+    bool read_ahead = take_prefetched(idx, prefetched);
+
+    // A container is always read by each rank for its own patches
+    if (m_container && !read_ahead) {
+        try {
+            prefetched = m_container->read_step(t_step, m_var_names, m_local_faces);
+        } catch (const std::exception& e) {
+            Abort(std::string("ReadBndryPlanes: ") + e.what());
+        }
+        read_ahead = true;
+    }
 
     GpuArray<GpuArray<Real, AMREX_SPACEDIM*2>, AMREX_SPACEDIM+NVAR_max> l_bc_extdir_vals_d;
 
@@ -371,29 +554,23 @@ void ReadBndryPlanes::read_file (const int idx,
 
     // We need to initialize all the components because we may not fill all of them from files,
     //    but the loop in the interpolate routine goes over all the components anyway
-    int ncomp_for_bc = BCVars::NumTypes;
     for (OrientationIter oit; oit != nullptr; ++oit) {
         auto ori = oit();
         if (ori.coordDir() < 2) {
-            FArrayBox& d = (*data_to_fill[ori])[lev];
-            const auto& bx = d.box();
-            Array4<Real> d_arr = d.array();
-            ParallelFor(
-                bx, ncomp_for_bc, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
-                d_arr(i,j,k,n) = 0.;
-            });
+            data_to_fill[ori]->setVal(0.0);
         }
     }
 
     // Read density for primitive to conserved conversions
     std::string filenamer = MultiFabFileFullPrefix(lev, chkname1, level_prefix, "density");
-    BndryRegister bndry_r(ba, dm, m_in_rad, m_out_rad, m_extent_rad, 1);
-    bndry_r.setVal(1.0e13);
+    Array<MultiFab, 2*AMREX_SPACEDIM> bndry_r;
     for (OrientationIter oit; oit != nullptr; ++oit) {
           auto ori = oit();
           if (ori.coordDir() < 2) {
+              bndry_r[ori].define(m_face_ba[ori], m_face_dm[ori], 1, 0);
+              bndry_r[ori].setVal(1.0e13);
               std::string facenamer = Concatenate(filenamer + '_', ori, 1);
-              bndry_r[ori].read(facenamer);
+              read_face(bndry_r[ori], facenamer, read_ahead, prefetched.get(), "density", ori);
           }
     }
 
@@ -423,43 +600,34 @@ void ReadBndryPlanes::read_file (const int idx,
 
         // Print() << "Reading " << chkname1 << " for variable " << var_name << " with n_offset == " << n_offset << std::endl;
 
-        BndryRegister bndry(ba, dm, m_in_rad, m_out_rad, m_extent_rad, ncomp);
-        bndry.setVal(1.0e13);
-
         // *********************************************************
-        // Read in the BndryReg for all non-z faces
+        // Read in the patches of all non-z faces that we own
         // *********************************************************
+        Array<MultiFab, 2*AMREX_SPACEDIM> bndry;
         for (OrientationIter oit; oit != nullptr; ++oit) {
           auto ori = oit();
           if (ori.coordDir() < 2) {
 
+            bndry[ori].define(m_face_ba[ori], m_face_dm[ori], ncomp, 0);
+            bndry[ori].setVal(1.0e13);
+
             std::string facename1 = Concatenate(filename1 + '_', ori, 1);
-            bndry[ori].read(facename1);
+            read_face(bndry[ori], facename1, read_ahead, prefetched.get(), var_name, ori);
 
             const int normal = ori.coordDir();
             const IntVect v_offset = offset(ori.faceDir(), normal);
 
-            const auto& bbx = (*data_to_fill[ori])[lev].box();
-
             // *********************************************************
-            // Copy from the BndryReg into a MultiFab then use copyTo
-            //     to write from the MultiFab to a single FAB for each face
+            // Convert the patches into the planes, which have the same
+            //     owners, so the data never leave this rank
             // *********************************************************
-            MultiFab bndryMF(
-                bndry[ori].boxArray(), bndry[ori].DistributionMap(),
-                ncomp, 0, MFInfo());
+            for (MFIter mfi(bndry[ori]); mfi.isValid(); ++mfi) {
 
-            for (MFIter mfi(bndryMF); mfi.isValid(); ++mfi) {
-
-                const auto& vbx = mfi.validbox();
                 const auto& bndry_read_arr   = bndry[ori].array(mfi);
                 const auto& bndry_read_r_arr = bndry_r[ori].array(mfi);
-                const auto& bndry_mf_arr     = bndryMF.array(mfi);
+                const Array4<Real> bndry_mf_arr(data_to_fill[ori]->array(mfi), n_offset);
 
-                const auto& bx = bbx & vbx;
-                if (bx.isEmpty()) {
-                    continue;
-                }
+                const Box& bx = m_plane_ba[ori][mfi.index()];
 
                 // We average the two cell-centered data points in the normal direction
                 //    to define a Dirichlet value on the face itself.
@@ -533,8 +701,146 @@ void ReadBndryPlanes::read_file (const int idx,
                 }
 
             } // mfi
-            bndryMF.copyTo((*data_to_fill[ori])[lev], 0, n_offset, ncomp);
           } // coordDir < 2
         } // ori
     } // var_name
 }
+
+/**
+ * Function in ReadBndryPlanes to split the faces of the domain like the level 0
+ * grids next to them, so that each rank reads the patches it owns.
+ *
+ * @param grids BoxArray at level 0
+ * @param dmap DistributionMapping at level 0
+ */
+void ReadBndryPlanes::set_layout (const BoxArray& grids, const DistributionMapping& dmap)
+{
+    if (m_grids == grids && m_dmap == dmap) return;
+    m_grids = grids;
+    m_dmap  = dmap;
+
+    const Box& domain = m_geom.Domain();
+    const int myproc = ParallelDescriptor::MyProc();
+    for (OrientationIter oit; oit != nullptr; ++oit) {
+        auto ori = oit();
+        if (ori.coordDir() < 2) {
+            bndry_face_layout(domain, ori, grids, dmap, m_in_rad, m_out_rad,
+                              m_face_ba[ori], m_face_dm[ori]);
+            m_local_faces[ori].clear();
+            for (int i = 0; i < m_face_ba[ori].size(); ++i) {
+                if (m_face_dm[ori][i] == myproc) m_local_faces[ori].push_back(m_face_ba[ori][i]);
+            }
+
+            // The boundary fill reads the layer just outside the domain
+            const int normal = ori.coordDir();
+            const int plane  = ori.isHigh() ? domain.bigEnd(normal) + 1 : domain.smallEnd(normal) - 1;
+            BoxList bl;
+            for (int i = 0; i < m_face_ba[ori].size(); ++i) {
+                Box b = m_face_ba[ori][i];
+                b.setRange(normal, plane, 1);
+                bl.push_back(b);
+            }
+            m_plane_ba[ori] = BoxArray(bl);
+        }
+    }
+
+    // Allocate the planes, or move those already read, on the new layout
+    define_level_data(0);
+    m_copies_current = false;
+
+    // Files being read ahead hold the patches of the old layout
+    m_prefetch.clear();
+}
+
+/**
+ * Function in ReadBndryPlanes to start reading the files after last_file_read
+ * on helper threads, keeping at most m_prefetch_depth of them in flight.
+ * Each rank reads the patches it owns, without communication.
+ */
+void ReadBndryPlanes::start_prefetch ()
+{
+    if (m_prefetch_depth == 0 || !has_local_faces()) return;
+
+    const int last_file = static_cast<int>(m_in_times.size()) - 1;
+    const int idx_end = std::min(last_file_read + m_prefetch_depth, last_file);
+    for (int idx = last_file_read + 1; idx <= idx_end; ++idx) {
+        if (m_prefetch.count(idx) > 0) continue;
+        if (m_container) {
+            m_prefetch[idx] = std::async(std::launch::async, &BndryPlaneContainer::read_step, m_container.get(),
+                                         m_in_timesteps[idx], m_var_names, m_local_faces);
+        } else {
+            const std::string chkname = m_filename + Concatenate("/bndry_output", m_in_timesteps[idx]);
+            m_prefetch[idx] = std::async(std::launch::async, read_bndry_file, chkname, m_var_names, m_local_faces);
+        }
+    }
+}
+
+/**
+ * Function in ReadBndryPlanes to collect the file read ahead for index idx,
+ * waiting for the helper thread if it is not done yet.
+ *
+ * Every rank must call this: unless all of them have their patches, the
+ * faces are read collectively from disk.
+ *
+ * @param idx Index of the file in m_in_timesteps
+ * @param data The local patches of the file if they were read ahead
+ * @return true if the faces were read ahead
+ */
+bool ReadBndryPlanes::take_prefetched (const int idx, std::unique_ptr<BndryFileData>& data)
+{
+    if (m_prefetch_depth == 0) return false;
+
+    BL_PROFILE("ERF::ReadBndryPlanes::take_prefetched");
+
+    int ok = has_local_faces() ? 0 : 1;
+    auto it = m_prefetch.find(idx);
+    if (it != m_prefetch.end()) {
+        try {
+            data = it->second.get();
+            ok = 1;
+        } catch (const std::exception& e) {
+            Warning(std::string("ReadBndryPlanes: reading ahead failed, reading again: ") + e.what());
+        }
+        m_prefetch.erase(it);
+    }
+    ParallelDescriptor::ReduceIntMin(ok);
+
+    return (ok == 1);
+}
+
+/**
+ * Function in ReadBndryPlanes to fill the patches of one face, either from
+ * the faces read ahead or (collectively) from disk.
+ *
+ * @param face Face to fill
+ * @param facename Name of the face on disk
+ * @param read_ahead true if the file was read ahead (on every rank)
+ * @param data Local patches read ahead
+ * @param var_name Variable of the face
+ * @param ori Orientation of the face
+ */
+void ReadBndryPlanes::read_face (MultiFab& face, const std::string& facename,
+                                 const bool read_ahead, const BndryFileData* data,
+                                 const std::string& var_name, const Orientation ori)
+{
+    if (!read_ahead) {
+        // The patches in the file need not match ours
+        MultiFab file_mf;
+        VisMF::Read(file_mf, facename);
+        face.ParallelCopy(file_mf, 0, 0, face.nComp());
+        return;
+    }
+
+    for (MFIter mfi(face); mfi.isValid(); ++mfi) {
+        AMREX_ALWAYS_ASSERT(data != nullptr);
+        FArrayBox& dst = face[mfi];
+        for (const auto& src : data->faces.at(var_name)[ori]) {
+            const Box bx = dst.box() & src.box();
+            if (bx.ok()) {
+                dst.copy<RunOn::Device>(src, bx, 0, bx, 0, std::min(dst.nComp(), src.nComp()));
+            }
+        }
+    }
+    // The pinned source is released at the end of read_file
+    Gpu::streamSynchronize();
+}
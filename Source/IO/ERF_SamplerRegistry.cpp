@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "AMReX_ParmParse.H"
+#include "AMReX_ParallelDescriptor.H"
+#include "ERF_SamplerRegistry.H"
+
+using namespace amrex;
+
+namespace {
+
+const char sampler_magic[] = "ERF_SAMPLER 1\n";
+
+enum { HeaderMissing, HeaderMatches, HeaderDiffers };
+
+// Compare the header of an existing sampler file with the probes of a group
+int
+header_state (const std::string& filename, const Vector<IntVect>& cells, int ncomp)
+{
+    std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+    if (!ifs.good() || ifs.tellg() <= 0) return HeaderMissing;
+    ifs.seekg(0);
+
+    char magic[sizeof(sampler_magic)-1];
+    std::int32_t hdr[2];
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(hdr), sizeof(hdr));
+    if (!ifs.good() || std::string(magic, sizeof(magic)) != sampler_magic ||
+        hdr[0] != static_cast<std::int32_t>(cells.size()) || hdr[1] != ncomp) {
+        return HeaderDiffers;
+    }
+    for (const auto& iv : cells) {
+        std::int32_t ijk[AMREX_SPACEDIM];
+        ifs.read(reinterpret_cast<char*>(ijk), sizeof(ijk));
+        if (!ifs.good() || ijk[0] != iv[0] || ijk[1] != iv[1] || ijk[2] != iv[2]) {
+            return HeaderDiffers;
+        }
+    }
+    return HeaderMatches;
+}
+
+}
+
+/**
+ * Constructor for the registry; reads the groups and writes the file headers
+ *
+ * Each group named in <prefix>.sampler_groups takes
+ *   <prefix>.<group>.points   = i j k  i j k ...   (cells)
+ *   <prefix>.<group>.lines    = i j    i j ...     (vertical lines through the domain)
+ *   <prefix>.<group>.interval = sampling interval in steps (default 1)
+ *   <prefix>.<group>.file     = output file name (default <group>.bin)
+ *
+ * @param pp_prefix Prefix of the inputs
+ * @param domain Level 0 domain
+ * @param ncons Number of components of the conserved state
+ */
+SamplerRegistry::SamplerRegistry (const std::string& pp_prefix, const Box& domain, int ncons)
+    : m_ncomp(ncons + AMREX_SPACEDIM)
+{
+    ParmParse pp(pp_prefix);
+
+    Vector<std::string> names;
+    pp.queryarr("sampler_groups", names);
+
+    int ngrp   = static_cast<int>(names.size());
+    int nprocs = ParallelDescriptor::NProcs();
+    int stride = std::max(1, nprocs / std::max(ngrp,1));
+
+    m_groups.resize(ngrp);
+    for (int ig = 0; ig < ngrp; ++ig) {
+        Group& g = m_groups[ig];
+        g.name     = names[ig];
+        g.filename = g.name + ".bin";
+        g.writer   = (ig * stride) % nprocs;
+
+        ParmParse ppg(pp_prefix + "." + g.name);
+        ppg.query("interval", g.interval);
+        ppg.query("file", g.filename);
+        AMREX_ALWAYS_ASSERT(g.interval > 0);
+
+        Vector<int> pts, lines;
+        ppg.queryarr("points", pts);
+        ppg.queryarr("lines" , lines);
+        if (pts.size() % AMREX_SPACEDIM != 0 || lines.size() % 2 != 0) {
+            Abort("SamplerRegistry: " + g.name + ".points needs (i,j,k) triples and .lines needs (i,j) pairs");
+        }
+
+        for (int n = 0; n < pts.size(); n += AMREX_SPACEDIM) {
+            g.cells.push_back(IntVect(pts[n], pts[n+1], pts[n+2]));
+        }
+        for (int n = 0; n < lines.size(); n += 2) {
+            for (int k = domain.smallEnd(2); k <= domain.bigEnd(2); ++k) {
+                g.cells.push_back(IntVect(lines[n], lines[n+1], k));
+            }
+        }
+        if (g.cells.empty()) {
+            Abort("SamplerRegistry: group " + g.name + " has no probes");
+        }
+        for (const auto& iv : g.cells) {
+            if (!domain.contains(iv)) {
+                Abort("SamplerRegistry: a probe of group " + g.name + " is outside the domain");
+            }
+        }
+
+        if (ParallelDescriptor::MyProc() == g.writer) {
+            // Append to an existing file on restart if it holds the same probes; otherwise
+            //    move on to <file>.1, <file>.2, ... so records of different layouts never mix
+            const std::string base = g.filename;
+            int state = header_state(g.filename, g.cells, m_ncomp);
+            for (int n = 1; state == HeaderDiffers; ++n) {
+                g.filename = base + "." + std::to_string(n);
+                state = header_state(g.filename, g.cells, m_ncomp);
+            }
+            if (g.filename != base) {
+                AllPrint() << "SamplerRegistry: the probes of group " << g.name << " differ from those in "
+                           << base << "; writing to " << g.filename << " instead" << std::endl;
+            }
+            bool has_header = (state == HeaderMatches);
+            g.ofs = std::make_shared<std::ofstream>(g.filename, std::ios::binary | std::ios::out | std::ios::app);
+            if (!g.ofs->good()) {
+                FileOpenFailed(g.filename);
+            }
+            if (!has_header) {
+                g.ofs->write(sampler_magic, sizeof(sampler_magic)-1);
+                std::int32_t hdr[2] = {static_cast<std::int32_t>(g.cells.size()),
+                                       static_cast<std::int32_t>(m_ncomp)};
+                g.ofs->write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+                for (const auto& iv : g.cells) {
+                    std::int32_t ijk[AMREX_SPACEDIM] = {iv[0], iv[1], iv[2]};
+                    g.ofs->write(reinterpret_cast<const char*>(ijk), sizeof(ijk));
+                }
+                g.ofs->flush();
+            }
+        }
+    }
+}
+
+/**
+ * Finds the box (and so the rank) that owns every probe.
+ *
+ * @param ba Level 0 BoxArray of the cell-centered data
+ * @param dm Level 0 DistributionMapping
+ */
+void
+SamplerRegistry::set_owners (const BoxArray& ba, const DistributionMapping& dm)
+{
+    if (m_ba == ba && m_dm == dm) return;
+    m_ba = ba;
+    m_dm = dm;
+
+    int myproc = ParallelDescriptor::MyProc();
+    int nprocs = ParallelDescriptor::NProcs();
+    int nboxes = static_cast<int>(ba.size());
+
+    for (auto& g : m_groups) {
+        // Probes of each box, in the order they appear in the group
+        Vector<Vector<int>> box_probes(nboxes);
+        for (int p = 0; p < g.cells.size(); ++p) {
+            const IntVect& iv = g.cells[p];
+            auto isects = ba.intersections(Box(iv,iv), true, 0);
+            AMREX_ALWAYS_ASSERT(!isects.empty());
+            box_probes[isects[0].first].push_back(p);
+        }
+
+        // Every rank packs its probes box by box, in the order MFIter visits
+        // its boxes, so all ranks can work out the layout of the gathered buffer
+        g.local_offset.clear();
+        g.local_cell.clear();
+        g.nowned = 0;
+        Vector<int> rank_count(nprocs, 0);
+        for (int bi = 0; bi < nboxes; ++bi) {
+            const auto& probes = box_probes[bi];
+            rank_count[dm[bi]] += static_cast<int>(probes.size());
+            if (dm[bi] != myproc) continue;
+
+            Vector<IntVect> h_cell;
+            for (int p : probes) h_cell.push_back(g.cells[p]);
+            g.local_offset.push_back(g.nowned);
+            g.local_cell.emplace_back(h_cell.size());
+            Gpu::copy(Gpu::hostToDevice, h_cell.begin(), h_cell.end(), g.local_cell.back().begin());
+            g.nowned += static_cast<int>(probes.size());
+        }
+
+        g.recv_count.clear();
+        g.recv_disp.clear();
+        g.recv_id.clear();
+        if (myproc == g.writer) {
+            g.recv_count.resize(nprocs);
+            g.recv_disp.resize(nprocs);
+            int disp = 0;
+            for (int r = 0; r < nprocs; ++r) {
+                g.recv_count[r] = rank_count[r] * m_ncomp;
+                g.recv_disp[r]  = disp;
+                disp += g.recv_count[r];
+            }
+            // Rank by rank, then box by box, as the ranks pack them
+            Vector<Vector<int>> rank_probes(nprocs);
+            for (int bi = 0; bi < nboxes; ++bi) {
+                auto& rp = rank_probes[dm[bi]];
+                rp.insert(rp.end(), box_probes[bi].begin(), box_probes[bi].end());
+            }
+            for (const auto& rp : rank_probes) {
+                g.recv_id.insert(g.recv_id.end(), rp.begin(), rp.end());
+            }
+        }
+    }
+}
+
+/**
+ * Samples the groups that are due and hands the writes to the pipeline.
+ *
+ * @param nstep Current step
+ * @param time Current time
+ * @param cons Conserved state at level 0
+ * @param xvel X-velocity at level 0
+ * @param yvel Y-velocity at level 0
+ * @param zvel Z-velocity at level 0
+ * @param pipeline Diagnostics pipeline, or nullptr to write right away
+ */
+void
+SamplerRegistry::sample (int nstep, Real time,
+                         const MultiFab& cons, const MultiFab& xvel,
+                         const MultiFab& yvel, const MultiFab& zvel,
+                         DiagnosticsPipeline* pipeline)
+{
+    BL_PROFILE("SamplerRegistry::sample()");
+
+    AMREX_ALWAYS_ASSERT(m_ba == cons.boxArray() && m_dm == cons.DistributionMap());
+
+    const int ncons = cons.nComp();
+    const int ncomp = m_ncomp;
+
+    for (auto& g : m_groups) {
+        if (nstep % g.interval != 0) continue;
+
+        int nsend = g.nowned * ncomp;
+        Gpu::DeviceVector<Real> d_buf(nsend);
+        Real* buf = d_buf.data();
+
+        for (MFIter mfi(cons); mfi.isValid(); ++mfi) {
+            int li  = mfi.LocalIndex();
+            int npl = static_cast<int>(g.local_cell[li].size());
+            if (npl == 0) continue;
+
+            const auto cons_arr = cons.const_array(mfi);
+            const auto u_arr    = xvel.const_array(mfi);
+            const auto v_arr    = yvel.const_array(mfi);
+            const auto w_arr    = zvel.const_array(mfi);
+            const int      off   = g.local_offset[li];
+            const IntVect* cells = g.local_cell[li].data();
+
+            ParallelFor(npl, [=] AMREX_GPU_DEVICE (int p) noexcept
+            {
+                int i = cells[p][0];
+                int j = cells[p][1];
+                int k = cells[p][2];
+                Real* val = buf + (off + p)*ncomp;
+                for (int n = 0; n < ncons; ++n) {
+                    val[n] = cons_arr(i,j,k,n);
+                }
+                val[ncons  ] = 0.5 * (u_arr(i,j,k) + u_arr(i+1,j  ,k  ));
+                val[ncons+1] = 0.5 * (v_arr(i,j,k) + v_arr(i  ,j+1,k  ));
+                val[ncons+2] = 0.5 * (w_arr(i,j,k) + w_arr(i  ,j  ,k+1));
+            });
+        }
+
+        // Gather only the owned probes onto the writer
+        Vector<Real> h_send(nsend);
+        Gpu::copy(Gpu::deviceToHost, d_buf.begin(), d_buf.end(), h_send.begin());
+
+        bool is_writer = (ParallelDescriptor::MyProc() == g.writer);
+        int nvals = static_cast<int>(g.cells.size()) * ncomp;
+        Vector<Real> h_recv(is_writer ? nvals : 0);
+        ParallelDescriptor::Gatherv(h_send.data(), nsend, h_recv.data(),
+                                    g.recv_count, g.recv_disp, g.writer);
+
+        if (is_writer) {
+            // Put the probes back in file order
+            Vector<Real> h_buf(nvals);
+            for (int q = 0; q < g.recv_id.size(); ++q) {
+                std::copy(h_recv.begin() + q*ncomp, h_recv.begin() + (q+1)*ncomp,
+                          h_buf.begin() + g.recv_id[q]*ncomp);
+            }
+
+            std::shared_ptr<std::ofstream> ofs = g.ofs;
+            std::function<void()> task = [ofs,time,h_buf] ()
+            {
+                Vector<double> rec(h_buf.size()+1);
+                rec[0] = static_cast<double>(time);
+                for (int n = 0; n < h_buf.size(); ++n) {
+                    rec[n+1] = static_cast<double>(h_buf[n]);
+                }
+                ofs->write(reinterpret_cast<const char*>(rec.data()), rec.size()*sizeof(double));
+                ofs->flush();
+            };
+            if (pipeline) {
+                pipeline->submit(std::move(task));
+            } else {
+                task();
+            }
+        }
+    }
+}
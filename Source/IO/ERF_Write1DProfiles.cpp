@@ -2,6 +2,7 @@
 
 #include "ERF.H"
 #include "EOS.H"
+#include "BatchedPlaneAverage.H"
 
 using namespace amrex;
 
@@ -60,106 +61,116 @@ ERF::write_1D_profiles (Real time)
 
         auto const& dx = geom[0].CellSizeArray();
         if (ParallelDescriptor::IOProcessor()) {
-            if (NumDataLogs() > 1) {
-                std::ostream& data_log1 = DataLog(1);
-                if (data_log1.good()) {
-                  // Write the quantities at this time
-                  for (int k = 0; k < hu_size; k++) {
-                      Real z;
-                      if (zlevels_stag.size() > 1) {
-                          z = 0.5 * (zlevels_stag[k] + zlevels_stag[k+1]);
-                      } else {
-                          z = (k + 0.5)* dx[2];
-                      }
-                      data_log1 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
-                                << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                                << h_avg_u[k]   << " " << h_avg_v[k]   << " " << h_avg_w[k]     << " "
-                                << h_avg_rho[k] << " " << h_avg_th[k]  << " " << h_avg_ksgs[k] << " "
-                                << h_avg_Kmv[k] << " " << h_avg_Khv[k] << " "
-                                << h_avg_qv[k]  << " " << h_avg_qc[k]  << " " << h_avg_qr[k]    << " "
-                                << h_avg_qi[k]  << " " << h_avg_qs[k]  << " " << h_avg_qg[k]
-                                << std::endl;
-                  } // loop over z
-                } // if good
-            } // NumDataLogs
-
-            if (NumDataLogs() > 2) {
-                std::ostream& data_log2 = DataLog(2);
-                if (data_log2.good()) {
-                  // Write the perturbational quantities at this time
-                  for (int k = 0; k < hu_size; k++) {
-                      Real z;
-                      if (zlevels_stag.size() > 1) {
-                          z = 0.5 * (zlevels_stag[k] + zlevels_stag[k+1]);
-                      } else {
-                          z = (k + 0.5)* dx[2];
-                      }
-                      Real thv = h_avg_th[k] * (1 + 0.61*h_avg_qv[k] - h_avg_qc[k] - h_avg_qr[k]);
-                      data_log2 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
-                                << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                                << h_avg_uu[k]   - h_avg_u[k]*h_avg_u[k]  << " "
-                                << h_avg_uv[k]   - h_avg_u[k]*h_avg_v[k]  << " "
-                                << h_avg_uw[k]   - h_avg_u[k]*h_avg_w[k]  << " "
-                                << h_avg_vv[k]   - h_avg_v[k]*h_avg_v[k]  << " "
-                                << h_avg_vw[k]   - h_avg_v[k]*h_avg_w[k]  << " "
-                                << h_avg_ww[k]   - h_avg_w[k]*h_avg_w[k]  << " "
-                                << h_avg_uth[k]  - h_avg_u[k]*h_avg_th[k] << " "
-                                << h_avg_vth[k]  - h_avg_v[k]*h_avg_th[k] << " "
-                                << h_avg_wth[k]  - h_avg_w[k]*h_avg_th[k] << " "
-                                << h_avg_thth[k] - h_avg_th[k]*h_avg_th[k] << " "
-                                // Note: <u'_i u'_i u'_j> =   <u_i u_i u_j>
-                                //                        -   <u_i u_i> * <u_j>
-                                //                        - 2*<u_i> * <u_i u_j>
-                                //                        + 2*<u_i>*<u_i> * <u_j>
-                                << h_avg_uiuiu[k]
-                                 - (h_avg_uu[k] + h_avg_vv[k] + h_avg_ww[k])*h_avg_u[k]
-                                 - 2*(h_avg_u[k]*h_avg_uu[k] + h_avg_v[k]*h_avg_uv[k] + h_avg_w[k]*h_avg_uw[k])
-                                 + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + h_avg_w[k]*h_avg_w[k])*h_avg_u[k]
-                                   << " " // (u'_i u'_i)u'
-                                << h_avg_uiuiv[k]
-                                 - (h_avg_uu[k] + h_avg_vv[k] + h_avg_ww[k])*h_avg_v[k]
-                                 - 2*(h_avg_u[k]*h_avg_uv[k] + h_avg_v[k]*h_avg_vv[k] + h_avg_w[k]*h_avg_vw[k])
-                                 + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + h_avg_w[k]*h_avg_w[k])*h_avg_v[k]
-                                   << " " // (u'_i u'_i)v'
-                                << h_avg_uiuiw[k]
-                                 - (h_avg_uu[k] + h_avg_vv[k] + h_avg_ww[k])*h_avg_w[k]
-                                 - 2*(h_avg_u[k]*h_avg_uw[k] + h_avg_v[k]*h_avg_vw[k] + h_avg_w[k]*h_avg_ww[k])
-                                 + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + h_avg_w[k]*h_avg_w[k])*h_avg_w[k]
-                                   << " " // (u'_i u'_i)w'
-                                << h_avg_pu[k]   - h_avg_p[k]*h_avg_u[k] << " "
-                                << h_avg_pv[k]   - h_avg_p[k]*h_avg_v[k] << " "
-                                << h_avg_pw[k]   - h_avg_p[k]*h_avg_w[k] << " "
-                                << h_avg_wqv[k]  - h_avg_qv[k]*h_avg_w[k] << " "
-                                << h_avg_wqc[k]  - h_avg_qc[k]*h_avg_w[k] << " "
-                                << h_avg_wqr[k]  - h_avg_qr[k]*h_avg_w[k] << " "
-                                << h_avg_wthv[k] - h_avg_w[k]*thv
-                                << std::endl;
-                  } // loop over z
-                } // if good
-            } // NumDataLogs
-
-            if (NumDataLogs() > 3 && time > 0.) {
-                std::ostream& data_log3 = DataLog(3);
-                if (data_log3.good()) {
-                  // Write the average stresses
-                  for (int k = 0; k < hu_size; k++) {
-                      Real z;
-                      if (zlevels_stag.size() > 1) {
-                          z = 0.5 * (zlevels_stag[k] + zlevels_stag[k+1]);
-                      } else {
-                          z = (k + 0.5)* dx[2];
-                      }
-                      data_log3 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
-                                << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                                << h_avg_tau11[k]  << " " << h_avg_tau12[k] << " " << h_avg_tau13[k] << " "
-                                << h_avg_tau22[k]  << " " << h_avg_tau23[k] << " " << h_avg_tau33[k] << " "
-                                << h_avg_sgshfx[k] << " "
-                                << h_avg_sgsq1fx[k] << " " << h_avg_sgsq2fx[k] << " "
-                                << h_avg_sgsdiss[k]
-                                << std::endl;
-                  } // loop over z
-                } // if good
-            } // if (NumDataLogs() > 3)
+            // The profiles are copied into the task, so they can be written while we go on
+            write_diagnostics([this,time,hu_size,dx,datwidth,datprecision,timeprecision,zlevels=zlevels_stag,
+                               h_avg_u,h_avg_v,h_avg_w,h_avg_rho,h_avg_th,h_avg_ksgs,h_avg_Kmv,h_avg_Khv,h_avg_qv,
+                               h_avg_qc,h_avg_qr,h_avg_wqv,h_avg_wqc,h_avg_wqr,h_avg_qi,h_avg_qs,h_avg_qg,h_avg_wth,
+                               h_avg_wthv,h_avg_uth,h_avg_vth,h_avg_thth,h_avg_uu,h_avg_uv,h_avg_uw,h_avg_vv,h_avg_vw,
+                               h_avg_ww,h_avg_uiuiu,h_avg_uiuiv,h_avg_uiuiw,h_avg_p,h_avg_pu,h_avg_pv,h_avg_pw,
+                               h_avg_tau11,h_avg_tau12,h_avg_tau13,h_avg_tau22,h_avg_tau23,h_avg_tau33,h_avg_sgshfx,
+                               h_avg_sgsq1fx,h_avg_sgsq2fx,h_avg_sgsdiss] ()
+            {
+                if (NumDataLogs() > 1) {
+                    std::ostream& data_log1 = DataLog(1);
+                    if (data_log1.good()) {
+                      // Write the quantities at this time
+                      for (int k = 0; k < hu_size; k++) {
+                          Real z;
+                          if (zlevels.size() > 1) {
+                              z = 0.5 * (zlevels[k] + zlevels[k+1]);
+                          } else {
+                              z = (k + 0.5)* dx[2];
+                          }
+                          data_log1 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
+                                    << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
+                                    << h_avg_u[k]   << " " << h_avg_v[k]   << " " << h_avg_w[k]     << " "
+                                    << h_avg_rho[k] << " " << h_avg_th[k]  << " " << h_avg_ksgs[k] << " "
+                                    << h_avg_Kmv[k] << " " << h_avg_Khv[k] << " "
+                                    << h_avg_qv[k]  << " " << h_avg_qc[k]  << " " << h_avg_qr[k]    << " "
+                                    << h_avg_qi[k]  << " " << h_avg_qs[k]  << " " << h_avg_qg[k]
+                                    << std::endl;
+                      } // loop over z
+                    } // if good
+                } // NumDataLogs
+
+                if (NumDataLogs() > 2) {
+                    std::ostream& data_log2 = DataLog(2);
+                    if (data_log2.good()) {
+                      // Write the perturbational quantities at this time
+                      for (int k = 0; k < hu_size; k++) {
+                          Real z;
+                          if (zlevels.size() > 1) {
+                              z = 0.5 * (zlevels[k] + zlevels[k+1]);
+                          } else {
+                              z = (k + 0.5)* dx[2];
+                          }
+                          Real thv = h_avg_th[k] * (1 + 0.61*h_avg_qv[k] - h_avg_qc[k] - h_avg_qr[k]);
+                          data_log2 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
+                                    << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
+                                    << h_avg_uu[k]   - h_avg_u[k]*h_avg_u[k]  << " "
+                                    << h_avg_uv[k]   - h_avg_u[k]*h_avg_v[k]  << " "
+                                    << h_avg_uw[k]   - h_avg_u[k]*h_avg_w[k]  << " "
+                                    << h_avg_vv[k]   - h_avg_v[k]*h_avg_v[k]  << " "
+                                    << h_avg_vw[k]   - h_avg_v[k]*h_avg_w[k]  << " "
+                                    << h_avg_ww[k]   - h_avg_w[k]*h_avg_w[k]  << " "
+                                    << h_avg_uth[k]  - h_avg_u[k]*h_avg_th[k] << " "
+                                    << h_avg_vth[k]  - h_avg_v[k]*h_avg_th[k] << " "
+                                    << h_avg_wth[k]  - h_avg_w[k]*h_avg_th[k] << " "
+                                    << h_avg_thth[k] - h_avg_th[k]*h_avg_th[k] << " "
+                                    // Note: <u'_i u'_i u'_j> =   <u_i u_i u_j>
+                                    //                        -   <u_i u_i> * <u_j>
+                                    //                        - 2*<u_i> * <u_i u_j>
+                                    //                        + 2*<u_i>*<u_i> * <u_j>
+                                    << h_avg_uiuiu[k]
+                                     - (h_avg_uu[k] + h_avg_vv[k] + h_avg_ww[k])*h_avg_u[k]
+                                     - 2*(h_avg_u[k]*h_avg_uu[k] + h_avg_v[k]*h_avg_uv[k] + h_avg_w[k]*h_avg_uw[k])
+                                     + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + h_avg_w[k]*h_avg_w[k])*h_avg_u[k]
+                                       << " " // (u'_i u'_i)u'
+                                    << h_avg_uiuiv[k]
+                                     - (h_avg_uu[k] + h_avg_vv[k] + h_avg_ww[k])*h_avg_v[k]
+                                     - 2*(h_avg_u[k]*h_avg_uv[k] + h_avg_v[k]*h_avg_vv[k] + h_avg_w[k]*h_avg_vw[k])
+                                     + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + h_avg_w[k]*h_avg_w[k])*h_avg_v[k]
+                                       << " " // (u'_i u'_i)v'
+                                    << h_avg_uiuiw[k]
+                                     - (h_avg_uu[k] + h_avg_vv[k] + h_avg_ww[k])*h_avg_w[k]
+                                     - 2*(h_avg_u[k]*h_avg_uw[k] + h_avg_v[k]*h_avg_vw[k] + h_avg_w[k]*h_avg_ww[k])
+                                     + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + h_avg_w[k]*h_avg_w[k])*h_avg_w[k]
+                                       << " " // (u'_i u'_i)w'
+                                    << h_avg_pu[k]   - h_avg_p[k]*h_avg_u[k] << " "
+                                    << h_avg_pv[k]   - h_avg_p[k]*h_avg_v[k] << " "
+                                    << h_avg_pw[k]   - h_avg_p[k]*h_avg_w[k] << " "
+                                    << h_avg_wqv[k]  - h_avg_qv[k]*h_avg_w[k] << " "
+                                    << h_avg_wqc[k]  - h_avg_qc[k]*h_avg_w[k] << " "
+                                    << h_avg_wqr[k]  - h_avg_qr[k]*h_avg_w[k] << " "
+                                    << h_avg_wthv[k] - h_avg_w[k]*thv
+                                    << std::endl;
+                      } // loop over z
+                    } // if good
+                } // NumDataLogs
+
+                if (NumDataLogs() > 3 && time > 0.) {
+                    std::ostream& data_log3 = DataLog(3);
+                    if (data_log3.good()) {
+                      // Write the average stresses
+                      for (int k = 0; k < hu_size; k++) {
+                          Real z;
+                          if (zlevels.size() > 1) {
+                              z = 0.5 * (zlevels[k] + zlevels[k+1]);
+                          } else {
+                              z = (k + 0.5)* dx[2];
+                          }
+                          data_log3 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
+                                    << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
+                                    << h_avg_tau11[k]  << " " << h_avg_tau12[k] << " " << h_avg_tau13[k] << " "
+                                    << h_avg_tau22[k]  << " " << h_avg_tau23[k] << " " << h_avg_tau33[k] << " "
+                                    << h_avg_sgshfx[k] << " "
+                                    << h_avg_sgsq1fx[k] << " " << h_avg_sgsq2fx[k] << " "
+                                    << h_avg_sgsdiss[k]
+                                    << std::endl;
+                      } // loop over z
+                    } // if good
+                } // if (NumDataLogs() > 3)
+            });
         } // if IOProcessor
     } // if (NumDataLogs() > 1)
 }
@@ -231,34 +242,6 @@ ERF::derive_diag_profiles(Real /*time*/,
         Array<const MultiFab*,3>{&vars_new[lev][Vars::xvel],&vars_new[lev][Vars::yvel],&vars_new[lev][Vars::zvel]});
 
     int zdir = 2;
-    auto domain = geom[0].Domain();
-
-    // Sum in the horizontal plane
-    h_avg_u  = sumToLine(mf_vels ,0,1,domain,zdir);
-    h_avg_v  = sumToLine(mf_vels ,1,1,domain,zdir);
-    h_avg_w  = sumToLine(mf_vels ,2,1,domain,zdir);
-
-    int hu_size =  h_avg_u.size();
-
-    // Divide by the total number of cells we are averaging over
-    Real area_z = static_cast<Real>(domain.length(0)*domain.length(1));
-    for (int k = 0; k < hu_size; ++k) {
-        h_avg_u[k] /= area_z; h_avg_v[k] /= area_z; h_avg_w[k] /= area_z;
-    }
-
-    Gpu::DeviceVector<Real> d_avg_u(hu_size, Real(0.0));
-    Gpu::DeviceVector<Real> d_avg_v(hu_size, Real(0.0));
-    Gpu::DeviceVector<Real> d_avg_w(hu_size, Real(0.0));
-
-#if 0
-    auto* avg_u_ptr = d_avg_u.data();
-    auto* avg_v_ptr = d_avg_v.data();
-    auto* avg_w_ptr = d_avg_w.data();
-#endif
-
-    Gpu::copy(Gpu::hostToDevice, h_avg_u.begin(), h_avg_u.end(), d_avg_u.begin());
-    Gpu::copy(Gpu::hostToDevice, h_avg_v.begin(), h_avg_v.end(), d_avg_v.begin());
-    Gpu::copy(Gpu::hostToDevice, h_avg_w.begin(), h_avg_w.end(), d_avg_w.begin());
 
     int nvars = vars_new[lev][Vars::cons].nComp();
     MultiFab mf_cons(vars_new[lev][Vars::cons], make_alias, 0, nvars);
@@ -291,7 +274,6 @@ ERF::derive_diag_profiles(Real /*time*/,
                 ksgs = cons_arr(i,j,k,RhoQKE_comp) / cons_arr(i,j,k,Rho_comp);
             }
             fab_arr(i, j, k, 2) = ksgs;
-#if 1
             if (l_use_kturb) {
                 fab_arr(i, j, k, 3) = eta_arr(i,j,k,EddyDiff::Mom_v); // Kmv
                 fab_arr(i, j, k, 4) = eta_arr(i,j,k,EddyDiff::Theta_v); // Khv
@@ -299,13 +281,6 @@ ERF::derive_diag_profiles(Real /*time*/,
                 fab_arr(i, j, k, 3) = 0.0;
                 fab_arr(i, j, k, 4) = 0.0;
             }
-#else
-            // Here we hijack the "Kturb" variable name to print out the resolved kinetic energy
-            Real upert = u_cc_arr(i,j,k) - avg_u_ptr[k];
-            Real vpert = v_cc_arr(i,j,k) - avg_v_ptr[k];
-            Real wpert = w_cc_arr(i,j,k) - avg_w_ptr[k];
-            fab_arr(i, j, k, 3) = 0.5 * (upert*upert + vpert*vpert + wpert*wpert);
-#endif
             fab_arr(i, j, k, 5) = u_cc_arr(i,j,k) * u_cc_arr(i,j,k);   // u*u
             fab_arr(i, j, k, 6) = u_cc_arr(i,j,k) * v_cc_arr(i,j,k);   // u*v
             fab_arr(i, j, k, 7) = u_cc_arr(i,j,k) * w_cc_arr(i,j,k);   // u*w
@@ -398,79 +373,54 @@ ERF::derive_diag_profiles(Real /*time*/,
         } // mfi
     } // use_moisture
 
-    h_avg_rho   = sumToLine(mf_out, 0,1,domain,zdir);
-    h_avg_th    = sumToLine(mf_out, 1,1,domain,zdir);
-    h_avg_ksgs  = sumToLine(mf_out, 2,1,domain,zdir);
-    h_avg_Kmv   = sumToLine(mf_out, 3,1,domain,zdir);
-    h_avg_Khv   = sumToLine(mf_out, 4,1,domain,zdir);
-    h_avg_uu    = sumToLine(mf_out, 5,1,domain,zdir);
-    h_avg_uv    = sumToLine(mf_out, 6,1,domain,zdir);
-    h_avg_uw    = sumToLine(mf_out, 7,1,domain,zdir);
-    h_avg_vv    = sumToLine(mf_out, 8,1,domain,zdir);
-    h_avg_vw    = sumToLine(mf_out, 9,1,domain,zdir);
-    h_avg_ww    = sumToLine(mf_out,10,1,domain,zdir);
-    h_avg_uth   = sumToLine(mf_out,11,1,domain,zdir);
-    h_avg_vth   = sumToLine(mf_out,12,1,domain,zdir);
-    h_avg_wth   = sumToLine(mf_out,13,1,domain,zdir);
-    h_avg_thth  = sumToLine(mf_out,14,1,domain,zdir);
-    h_avg_uiuiu = sumToLine(mf_out,15,1,domain,zdir);
-    h_avg_uiuiv = sumToLine(mf_out,16,1,domain,zdir);
-    h_avg_uiuiw = sumToLine(mf_out,17,1,domain,zdir);
-    h_avg_p     = sumToLine(mf_out,18,1,domain,zdir);
-    h_avg_pu    = sumToLine(mf_out,19,1,domain,zdir);
-    h_avg_pv    = sumToLine(mf_out,20,1,domain,zdir);
-    h_avg_pw    = sumToLine(mf_out,21,1,domain,zdir);
-    h_avg_qv    = sumToLine(mf_out,22,1,domain,zdir);
-    h_avg_qc    = sumToLine(mf_out,23,1,domain,zdir);
-    h_avg_qr    = sumToLine(mf_out,24,1,domain,zdir);
-    h_avg_wqv   = sumToLine(mf_out,25,1,domain,zdir);
-    h_avg_wqc   = sumToLine(mf_out,26,1,domain,zdir);
-    h_avg_wqr   = sumToLine(mf_out,27,1,domain,zdir);
-    h_avg_qi    = sumToLine(mf_out,28,1,domain,zdir);
-    h_avg_qs    = sumToLine(mf_out,29,1,domain,zdir);
-    h_avg_qg    = sumToLine(mf_out,30,1,domain,zdir);
-    h_avg_wthv  = sumToLine(mf_out,31,1,domain,zdir);
-
-    // Divide by the total number of cells we are averaging over
-    int h_avg_u_size = static_cast<int>(h_avg_u.size());
-    for (int k = 0; k < h_avg_u_size; ++k) {
-        h_avg_rho[k] /= area_z;
-        h_avg_ksgs[k]  /= area_z;
-        h_avg_Kmv[k]   /= area_z;
-        h_avg_Khv[k]   /= area_z;
-        h_avg_th[k]    /= area_z;
-        h_avg_thth[k]  /= area_z;
-        h_avg_uu[k]    /= area_z;
-        h_avg_uv[k]    /= area_z;
-        h_avg_uw[k]    /= area_z;
-        h_avg_vv[k]    /= area_z;
-        h_avg_vw[k]    /= area_z;
-        h_avg_ww[k]    /= area_z;
-        h_avg_uth[k]   /= area_z;
-        h_avg_vth[k]   /= area_z;
-        h_avg_wth[k]   /= area_z;
-        h_avg_uiuiu[k] /= area_z;
-        h_avg_uiuiv[k] /= area_z;
-        h_avg_uiuiw[k] /= area_z;
-        h_avg_p[k]     /= area_z;
-        h_avg_pu[k]    /= area_z;
-        h_avg_pv[k]    /= area_z;
-        h_avg_pw[k]    /= area_z;
-        h_avg_qv[k]    /= area_z;
-        h_avg_qc[k]    /= area_z;
-        h_avg_qr[k]    /= area_z;
-        h_avg_wqv[k]   /= area_z;
-        h_avg_wqc[k]   /= area_z;
-        h_avg_wqr[k]   /= area_z;
-        h_avg_qi[k]    /= area_z;
-        h_avg_qs[k]    /= area_z;
-        h_avg_qg[k]    /= area_z;
-        h_avg_wthv[k]  /= area_z;
-    }
+    // Average the velocities and all the products in the horizontal plane,
+    // with a single reduction across ranks
+    BatchedPlaneAverage havg(geom[0], zdir);
+    int ivels = havg.add(&mf_vels);
+    int iout  = havg.add(&mf_out);
+    havg();
+
+    havg.line_average(ivels, 0, h_avg_u);
+    havg.line_average(ivels, 1, h_avg_v);
+    havg.line_average(ivels, 2, h_avg_w);
+
+    havg.line_average(iout, 0, h_avg_rho);
+    havg.line_average(iout, 1, h_avg_th);
+    havg.line_average(iout, 2, h_avg_ksgs);
+    havg.line_average(iout, 3, h_avg_Kmv);
+    havg.line_average(iout, 4, h_avg_Khv);
+    havg.line_average(iout, 5, h_avg_uu);
+    havg.line_average(iout, 6, h_avg_uv);
+    havg.line_average(iout, 7, h_avg_uw);
+    havg.line_average(iout, 8, h_avg_vv);
+    havg.line_average(iout, 9, h_avg_vw);
+    havg.line_average(iout,10, h_avg_ww);
+    havg.line_average(iout,11, h_avg_uth);
+    havg.line_average(iout,12, h_avg_vth);
+    havg.line_average(iout,13, h_avg_wth);
+    havg.line_average(iout,14, h_avg_thth);
+    havg.line_average(iout,15, h_avg_uiuiu);
+    havg.line_average(iout,16, h_avg_uiuiv);
+    havg.line_average(iout,17, h_avg_uiuiw);
+    havg.line_average(iout,18, h_avg_p);
+    havg.line_average(iout,19, h_avg_pu);
+    havg.line_average(iout,20, h_avg_pv);
+    havg.line_average(iout,21, h_avg_pw);
+    havg.line_average(iout,22, h_avg_qv);
+    havg.line_average(iout,23, h_avg_qc);
+    havg.line_average(iout,24, h_avg_qr);
+    havg.line_average(iout,25, h_avg_wqv);
+    havg.line_average(iout,26, h_avg_wqc);
+    havg.line_average(iout,27, h_avg_wqr);
+    havg.line_average(iout,28, h_avg_qi);
+    havg.line_average(iout,29, h_avg_qs);
+    havg.line_average(iout,30, h_avg_qg);
+    havg.line_average(iout,31, h_avg_wthv);
 
 #if 0
     // Here we print the integrated total kinetic energy as computed in the 1D profile above
     Real sum = 0.;
+    int h_avg_u_size = static_cast<int>(h_avg_u.size());
     Real dz = geom[0].ProbHi(2) / static_cast<Real>(h_avg_u_size);
     for (int k = 0; k < h_avg_u_size; ++k) {
         sum += h_avg_kturb[k] * h_avg_rho[k] * dz;
@@ -535,30 +485,18 @@ ERF::derive_stress_profiles (Gpu::HostVector<Real>& h_avg_tau11, Gpu::HostVector
         });
     }
 
-    int zdir = 2;
-    auto domain = geom[0].Domain();
-
-    h_avg_tau11 = sumToLine(mf_out,0,1,domain,zdir);
-    h_avg_tau12 = sumToLine(mf_out,1,1,domain,zdir);
-    h_avg_tau13 = sumToLine(mf_out,2,1,domain,zdir);
-    h_avg_tau22 = sumToLine(mf_out,3,1,domain,zdir);
-    h_avg_tau23 = sumToLine(mf_out,4,1,domain,zdir);
-    h_avg_tau33 = sumToLine(mf_out,5,1,domain,zdir);
-    h_avg_hfx3  = sumToLine(mf_out,6,1,domain,zdir);
-    h_avg_q1fx3 = sumToLine(mf_out,7,1,domain,zdir);
-    h_avg_q2fx3 = sumToLine(mf_out,8,1,domain,zdir);
-    h_avg_diss  = sumToLine(mf_out,9,1,domain,zdir);
-
-    int ht_size =  h_avg_tau11.size();
-
-    // Divide by the total number of cells we are averaging over
-    Real area_z = static_cast<Real>(domain.length(0)*domain.length(1));
-    for (int k = 0; k < ht_size; ++k) {
-        h_avg_tau11[k] /= area_z; h_avg_tau12[k] /= area_z; h_avg_tau13[k] /= area_z;
-        h_avg_tau22[k] /= area_z; h_avg_tau23[k] /= area_z;
-        h_avg_tau33[k] /= area_z;
-        h_avg_hfx3[k] /= area_z;
-        h_avg_q1fx3[k] /= area_z; h_avg_q2fx3[k] /= area_z;
-        h_avg_diss[k] /= area_z;
-    }
+    BatchedPlaneAverage havg(geom[0], 2);
+    havg.add(&mf_out);
+    havg();
+
+    havg.line_average(0, 0, h_avg_tau11);
+    havg.line_average(0, 1, h_avg_tau12);
+    havg.line_average(0, 2, h_avg_tau13);
+    havg.line_average(0, 3, h_avg_tau22);
+    havg.line_average(0, 4, h_avg_tau23);
+    havg.line_average(0, 5, h_avg_tau33);
+    havg.line_average(0, 6, h_avg_hfx3);
+    havg.line_average(0, 7, h_avg_q1fx3);
+    havg.line_average(0, 8, h_avg_q2fx3);
+    havg.line_average(0, 9, h_avg_diss);
 }
@@ -2,6 +2,7 @@
 
 #include "ERF.H"
 #include "EOS.H"
+#include "BatchedPlaneAverage.H"
 
 using namespace amrex;
 
@@ -68,204 +69,214 @@ ERF::write_1D_profiles_stag (Real time)
 
         auto const& dx = geom[0].CellSizeArray();
         if (ParallelDescriptor::IOProcessor()) {
-            if (NumDataLogs() > 1) {
-                std::ostream& data_log1 = DataLog(1);
-                if (data_log1.good()) {
-                  // Write the quantities at this time
-                  for (int k = 0; k < unstag_size; k++) {
-                      Real z = (zlevels_stag.size() > 1) ? zlevels_stag[k] : k * dx[2];
+            // The profiles are copied into the task, so they can be written while we go on
+            write_diagnostics([this,time,unstag_size,dx,datwidth,datprecision,timeprecision,zlevels=zlevels_stag,
+                               h_avg_u,h_avg_v,h_avg_w,h_avg_rho,h_avg_th,h_avg_ksgs,h_avg_Kmv,h_avg_Khv,h_avg_qv,
+                               h_avg_qc,h_avg_qr,h_avg_wqv,h_avg_wqc,h_avg_wqr,h_avg_qi,h_avg_qs,h_avg_qg,h_avg_wth,
+                               h_avg_wthv,h_avg_uth,h_avg_vth,h_avg_thth,h_avg_uu,h_avg_uv,h_avg_uw,h_avg_vv,h_avg_vw,
+                               h_avg_ww,h_avg_uiuiu,h_avg_uiuiv,h_avg_uiuiw,h_avg_p,h_avg_pu,h_avg_pv,h_avg_pw,
+                               h_avg_tau11,h_avg_tau12,h_avg_tau13,h_avg_tau22,h_avg_tau23,h_avg_tau33,h_avg_sgshfx,
+                               h_avg_sgsq1fx,h_avg_sgsq2fx,h_avg_sgsdiss] ()
+            {
+                if (NumDataLogs() > 1) {
+                    std::ostream& data_log1 = DataLog(1);
+                    if (data_log1.good()) {
+                      // Write the quantities at this time
+                      for (int k = 0; k < unstag_size; k++) {
+                          Real z = (zlevels.size() > 1) ? zlevels[k] : k * dx[2];
+                          data_log1 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
+                                    << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
+                                    << h_avg_u[k]   << " " << h_avg_v[k]   << " " << h_avg_w[k]     << " "
+                                    << h_avg_rho[k] << " " << h_avg_th[k]  << " " << h_avg_ksgs[k] << " "
+                                    << h_avg_Kmv[k] << " " << h_avg_Khv[k] << " "
+                                    << h_avg_qv[k]  << " " << h_avg_qc[k]  << " " << h_avg_qr[k]    << " "
+                                    << h_avg_qi[k]  << " " << h_avg_qs[k]  << " " << h_avg_qg[k]
+                                    << std::endl;
+                      } // loop over z
+                      // Write top face values
+                      Real z = (zlevels.size() > 1) ? zlevels[unstag_size] : unstag_size * dx[2];
                       data_log1 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
                                 << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                                << h_avg_u[k]   << " " << h_avg_v[k]   << " " << h_avg_w[k]     << " "
-                                << h_avg_rho[k] << " " << h_avg_th[k]  << " " << h_avg_ksgs[k] << " "
-                                << h_avg_Kmv[k] << " " << h_avg_Khv[k] << " "
-                                << h_avg_qv[k]  << " " << h_avg_qc[k]  << " " << h_avg_qr[k]    << " "
-                                << h_avg_qi[k]  << " " << h_avg_qs[k]  << " " << h_avg_qg[k]
+                                << 0 << " " << 0 << " " << h_avg_w[unstag_size+1] << " "
+                                << 0 << " " << 0 << " " << 0 << " " // rho, theta, ksgs
+                                << 0 << " " << 0 << " "             // Kmv, Khv
+                                << 0 << " " << 0 << " " << 0 << " " // qv, qc, qr
+                                << 0 << " " << 0 << " " << 0        // qi, qs, qg
+                                << std::endl;
+                    } // if good
+                } // NumDataLogs
+
+                if (NumDataLogs() > 2) {
+                    std::ostream& data_log2 = DataLog(2);
+                    if (data_log2.good()) {
+                      // Write the perturbational quantities at this time
+                      // For surface values (k=0), assume w = uw = vw = ww = 0
+                      Real w_cc  = h_avg_w[1] / 2;  // w at first cell center
+                      Real uw_cc = h_avg_uw[1] / 2; // u*w at first cell center
+                      Real vw_cc = h_avg_vw[1] / 2; // v*w at first cell center
+                      Real ww_cc = h_avg_ww[1] / 2; // w*w at first cell center
+                      data_log2 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
+                                << std::setw(datwidth) << std::setprecision(datprecision) << 0 << " "
+                                << h_avg_uu[0]   - h_avg_u[0]*h_avg_u[0]   << " " // u'u'
+                                << h_avg_uv[0]   - h_avg_u[0]*h_avg_v[0]   << " " // u'v'
+                                << 0                                       << " " // u'w'
+                                << h_avg_vv[0]   - h_avg_v[0]*h_avg_v[0]   << " " // v'v'
+                                << 0                                       << " " // v'w'
+                                << 0                                       << " " // w'w'
+                                << h_avg_uth[0]  - h_avg_u[0]*h_avg_th[0]  << " " // u'th'
+                                << h_avg_vth[0]  - h_avg_v[0]*h_avg_th[0]  << " " // v'th'
+                                << 0                                       << " " // w'th'
+                                << h_avg_thth[0] - h_avg_th[0]*h_avg_th[0] << " " // th'th'
+                                << h_avg_uiuiu[0]
+                                 - (h_avg_uu[0] + h_avg_vv[0] + ww_cc)*h_avg_u[0]
+                                 - 2*(h_avg_u[0]*h_avg_uu[0] + h_avg_v[0]*h_avg_uv[0] + w_cc*uw_cc)
+                                 + 2*(h_avg_u[0]*h_avg_u[0] + h_avg_v[0]*h_avg_v[0] + w_cc*w_cc)*h_avg_u[0]
+                                   << " " // (u'_i u'_i)u'
+                                << h_avg_uiuiv[0]
+                                 - (h_avg_uu[0] + h_avg_vv[0] + ww_cc)*h_avg_v[0]
+                                 - 2*(h_avg_u[0]*h_avg_uv[0] + h_avg_v[0]*h_avg_vv[0] + w_cc*vw_cc)
+                                 + 2*(h_avg_u[0]*h_avg_u[0] + h_avg_v[0]*h_avg_v[0] + w_cc*w_cc)*h_avg_v[0]
+                                   << " " // (u'_i u'_i)v'
+                                << 0 << " " // (u'_i u'_i)w'
+                                << h_avg_pu[0]   - h_avg_p[0]*h_avg_u[0]   << " " // p'u'
+                                << h_avg_pv[0]   - h_avg_p[0]*h_avg_v[0]   << " " // p'v'
+                                << 0                                       << " " // p'w'
+                                << 0                                       << " " // qv'w'
+                                << 0                                       << " " // qc'w'
+                                << 0                                       << " " // qr'w'
+                                << 0                                              // thv'w'
                                 << std::endl;
-                  } // loop over z
-                  // Write top face values
-                  Real z = (zlevels_stag.size() > 1) ? zlevels_stag[unstag_size] : unstag_size * dx[2];
-                  data_log1 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
-                            << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                            << 0 << " " << 0 << " " << h_avg_w[unstag_size+1] << " "
-                            << 0 << " " << 0 << " " << 0 << " " // rho, theta, ksgs
-                            << 0 << " " << 0 << " "             // Kmv, Khv
-                            << 0 << " " << 0 << " " << 0 << " " // qv, qc, qr
-                            << 0 << " " << 0 << " " << 0        // qi, qs, qg
-                            << std::endl;
-                } // if good
-            } // NumDataLogs
-
-            if (NumDataLogs() > 2) {
-                std::ostream& data_log2 = DataLog(2);
-                if (data_log2.good()) {
-                  // Write the perturbational quantities at this time
-                  // For surface values (k=0), assume w = uw = vw = ww = 0
-                  Real w_cc  = h_avg_w[1] / 2;  // w at first cell center
-                  Real uw_cc = h_avg_uw[1] / 2; // u*w at first cell center
-                  Real vw_cc = h_avg_vw[1] / 2; // v*w at first cell center
-                  Real ww_cc = h_avg_ww[1] / 2; // w*w at first cell center
-                  data_log2 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
-                            << std::setw(datwidth) << std::setprecision(datprecision) << 0 << " "
-                            << h_avg_uu[0]   - h_avg_u[0]*h_avg_u[0]   << " " // u'u'
-                            << h_avg_uv[0]   - h_avg_u[0]*h_avg_v[0]   << " " // u'v'
-                            << 0                                       << " " // u'w'
-                            << h_avg_vv[0]   - h_avg_v[0]*h_avg_v[0]   << " " // v'v'
-                            << 0                                       << " " // v'w'
-                            << 0                                       << " " // w'w'
-                            << h_avg_uth[0]  - h_avg_u[0]*h_avg_th[0]  << " " // u'th'
-                            << h_avg_vth[0]  - h_avg_v[0]*h_avg_th[0]  << " " // v'th'
-                            << 0                                       << " " // w'th'
-                            << h_avg_thth[0] - h_avg_th[0]*h_avg_th[0] << " " // th'th'
-                            << h_avg_uiuiu[0]
-                             - (h_avg_uu[0] + h_avg_vv[0] + ww_cc)*h_avg_u[0]
-                             - 2*(h_avg_u[0]*h_avg_uu[0] + h_avg_v[0]*h_avg_uv[0] + w_cc*uw_cc)
-                             + 2*(h_avg_u[0]*h_avg_u[0] + h_avg_v[0]*h_avg_v[0] + w_cc*w_cc)*h_avg_u[0]
-                               << " " // (u'_i u'_i)u'
-                            << h_avg_uiuiv[0]
-                             - (h_avg_uu[0] + h_avg_vv[0] + ww_cc)*h_avg_v[0]
-                             - 2*(h_avg_u[0]*h_avg_uv[0] + h_avg_v[0]*h_avg_vv[0] + w_cc*vw_cc)
-                             + 2*(h_avg_u[0]*h_avg_u[0] + h_avg_v[0]*h_avg_v[0] + w_cc*w_cc)*h_avg_v[0]
-                               << " " // (u'_i u'_i)v'
-                            << 0 << " " // (u'_i u'_i)w'
-                            << h_avg_pu[0]   - h_avg_p[0]*h_avg_u[0]   << " " // p'u'
-                            << h_avg_pv[0]   - h_avg_p[0]*h_avg_v[0]   << " " // p'v'
-                            << 0                                       << " " // p'w'
-                            << 0                                       << " " // qv'w'
-                            << 0                                       << " " // qc'w'
-                            << 0                                       << " " // qr'w'
-                            << 0                                              // thv'w'
-                            << std::endl;
-
-                  // For internal values, interpolate scalar quantities to faces
-                  for (int k = 1; k < unstag_size; k++) {
-                      Real z = (zlevels_stag.size() > 1) ? zlevels_stag[k] : k * dx[2];
-                      Real uface  = 0.5*(h_avg_u[k]  + h_avg_u[k-1]);
-                      Real vface  = 0.5*(h_avg_v[k]  + h_avg_v[k-1]);
-                      Real thface = 0.5*(h_avg_th[k] + h_avg_th[k-1]);
-                      Real pface  = 0.5*(h_avg_p[k]  + h_avg_p[k-1]);
-                      Real qvface = 0.5*(h_avg_qv[k] + h_avg_qv[k-1]);
-                      Real qcface = 0.5*(h_avg_qc[k] + h_avg_qc[k-1]);
-                      Real qrface = 0.5*(h_avg_qr[k] + h_avg_qr[k-1]);
-                      Real uuface = 0.5*(h_avg_uu[k] + h_avg_uu[k-1]);
-                      Real vvface = 0.5*(h_avg_vv[k] + h_avg_vv[k-1]);
+
+                      // For internal values, interpolate scalar quantities to faces
+                      for (int k = 1; k < unstag_size; k++) {
+                          Real z = (zlevels.size() > 1) ? zlevels[k] : k * dx[2];
+                          Real uface  = 0.5*(h_avg_u[k]  + h_avg_u[k-1]);
+                          Real vface  = 0.5*(h_avg_v[k]  + h_avg_v[k-1]);
+                          Real thface = 0.5*(h_avg_th[k] + h_avg_th[k-1]);
+                          Real pface  = 0.5*(h_avg_p[k]  + h_avg_p[k-1]);
+                          Real qvface = 0.5*(h_avg_qv[k] + h_avg_qv[k-1]);
+                          Real qcface = 0.5*(h_avg_qc[k] + h_avg_qc[k-1]);
+                          Real qrface = 0.5*(h_avg_qr[k] + h_avg_qr[k-1]);
+                          Real uuface = 0.5*(h_avg_uu[k] + h_avg_uu[k-1]);
+                          Real vvface = 0.5*(h_avg_vv[k] + h_avg_vv[k-1]);
+                          Real thvface = thface * (1 + 0.61*qvface - qcface - qrface);
+                          w_cc   = 0.5*(h_avg_w[k-1]  + h_avg_w[k]);
+                          uw_cc  = 0.5*(h_avg_uw[k-1] + h_avg_uw[k]);
+                          vw_cc  = 0.5*(h_avg_vw[k-1] + h_avg_vw[k]);
+                          ww_cc  = 0.5*(h_avg_ww[k-1] + h_avg_ww[k]);
+                          data_log2 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
+                                    << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
+                                    << h_avg_uu[k]   - h_avg_u[k]*h_avg_u[k]   << " " // u'u'
+                                    << h_avg_uv[k]   - h_avg_u[k]*h_avg_v[k]   << " " // u'v'
+                                    << h_avg_uw[k]   -      uface*h_avg_w[k]   << " " // u'w'
+                                    << h_avg_vv[k]   - h_avg_v[k]*h_avg_v[k]   << " " // v'v'
+                                    << h_avg_vw[k]   -      vface*h_avg_w[k]   << " " // v'w'
+                                    << h_avg_ww[k]   - h_avg_w[k]*h_avg_w[k]   << " " // w'w'
+                                    << h_avg_uth[k]  - h_avg_u[k]*h_avg_th[k]  << " " // u'th'
+                                    << h_avg_vth[k]  - h_avg_v[k]*h_avg_th[k]  << " " // v'th'
+                                    << h_avg_wth[k]  - h_avg_w[k]*thface       << " " // w'th'
+                                    << h_avg_thth[k] - h_avg_th[k]*h_avg_th[k] << " " // th'th'
+                                    // Note: <u'_i u'_i u'_j> =   <u_i u_i u_j>
+                                    //                        -   <u_i u_i> * <u_j>
+                                    //                        - 2*<u_i> * <u_i u_j>
+                                    //                        + 2*<u_i>*<u_i> * <u_j>
+                                    << h_avg_uiuiu[k]
+                                     - (h_avg_uu[k] + h_avg_vv[k] + ww_cc)*h_avg_u[k]
+                                     - 2*(h_avg_u[k]*h_avg_uu[k] + h_avg_v[k]*h_avg_uv[k] + w_cc*uw_cc)
+                                     + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + w_cc*w_cc)*h_avg_u[k]
+                                       << " " // cell-centered (u'_i u'_i)u'
+                                    << h_avg_uiuiv[k]
+                                     - (h_avg_uu[k] + h_avg_vv[k] + ww_cc)*h_avg_v[k]
+                                     - 2*(h_avg_u[k]*h_avg_uv[k] + h_avg_v[k]*h_avg_vv[k] + w_cc*vw_cc)
+                                     + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + w_cc*w_cc)*h_avg_v[k]
+                                       << " " // cell-centered (u'_i u'_i)v'
+                                    << h_avg_uiuiw[k]
+                                     - (uuface + vvface + h_avg_ww[k])*h_avg_w[k]
+                                     - 2*(uface*h_avg_uw[k] + vface*h_avg_vw[k] + h_avg_w[k]*h_avg_ww[k])
+                                     + 2*(uface*uface + vface*vface + h_avg_w[k]*h_avg_w[k])*h_avg_w[k]
+                                       << " " // face-centered (u'_i u'_i)w'
+                                    << h_avg_pu[k]   - h_avg_p[k]*h_avg_u[k]   << " " // cell-centered p'u'
+                                    << h_avg_pv[k]   - h_avg_p[k]*h_avg_v[k]   << " " // cell-centered p'v'
+                                    << h_avg_pw[k]   -      pface*h_avg_w[k]   << " " // face-centered p'w'
+                                    << h_avg_wqv[k]  -     qvface*h_avg_w[k]   << " "
+                                    << h_avg_wqc[k]  -     qcface*h_avg_w[k]   << " "
+                                    << h_avg_wqr[k]  -     qrface*h_avg_w[k]   << " "
+                                    << h_avg_wthv[k] -    thvface*h_avg_w[k]
+                                    << std::endl;
+                      } // loop over z
+
+                      // Write top face values, extrapolating scalar quantities
+                      const int k = unstag_size;
+                      Real uface  = 1.5*h_avg_u[k-1]  - 0.5*h_avg_u[k-2];
+                      Real vface  = 1.5*h_avg_v[k-1]  - 0.5*h_avg_v[k-2];
+                      Real thface = 1.5*h_avg_th[k-1] - 0.5*h_avg_th[k-2];
+                      Real pface  = 1.5*h_avg_p[k-1]  - 0.5*h_avg_p[k-2];
+                      Real qvface = 1.5*h_avg_qv[k-1] - 0.5*h_avg_qv[k-2];
+                      Real qcface = 1.5*h_avg_qc[k-1] - 0.5*h_avg_qc[k-2];
+                      Real qrface = 1.5*h_avg_qr[k-1] - 0.5*h_avg_qr[k-2];
+                      Real uuface = 1.5*h_avg_uu[k-1] - 0.5*h_avg_uu[k-2];
+                      Real vvface = 1.5*h_avg_vv[k-1] - 0.5*h_avg_vv[k-2];
                       Real thvface = thface * (1 + 0.61*qvface - qcface - qrface);
-                      w_cc   = 0.5*(h_avg_w[k-1]  + h_avg_w[k]);
-                      uw_cc  = 0.5*(h_avg_uw[k-1] + h_avg_uw[k]);
-                      vw_cc  = 0.5*(h_avg_vw[k-1] + h_avg_vw[k]);
-                      ww_cc  = 0.5*(h_avg_ww[k-1] + h_avg_ww[k]);
+                      Real z = (zlevels.size() > 1) ? zlevels[unstag_size] : unstag_size * dx[2];
                       data_log2 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
                                 << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                                << h_avg_uu[k]   - h_avg_u[k]*h_avg_u[k]   << " " // u'u'
-                                << h_avg_uv[k]   - h_avg_u[k]*h_avg_v[k]   << " " // u'v'
-                                << h_avg_uw[k]   -      uface*h_avg_w[k]   << " " // u'w'
-                                << h_avg_vv[k]   - h_avg_v[k]*h_avg_v[k]   << " " // v'v'
-                                << h_avg_vw[k]   -      vface*h_avg_w[k]   << " " // v'w'
-                                << h_avg_ww[k]   - h_avg_w[k]*h_avg_w[k]   << " " // w'w'
-                                << h_avg_uth[k]  - h_avg_u[k]*h_avg_th[k]  << " " // u'th'
-                                << h_avg_vth[k]  - h_avg_v[k]*h_avg_th[k]  << " " // v'th'
-                                << h_avg_wth[k]  - h_avg_w[k]*thface       << " " // w'th'
-                                << h_avg_thth[k] - h_avg_th[k]*h_avg_th[k] << " " // th'th'
-                                // Note: <u'_i u'_i u'_j> =   <u_i u_i u_j>
-                                //                        -   <u_i u_i> * <u_j>
-                                //                        - 2*<u_i> * <u_i u_j>
-                                //                        + 2*<u_i>*<u_i> * <u_j>
-                                << h_avg_uiuiu[k]
-                                 - (h_avg_uu[k] + h_avg_vv[k] + ww_cc)*h_avg_u[k]
-                                 - 2*(h_avg_u[k]*h_avg_uu[k] + h_avg_v[k]*h_avg_uv[k] + w_cc*uw_cc)
-                                 + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + w_cc*w_cc)*h_avg_u[k]
-                                   << " " // cell-centered (u'_i u'_i)u'
-                                << h_avg_uiuiv[k]
-                                 - (h_avg_uu[k] + h_avg_vv[k] + ww_cc)*h_avg_v[k]
-                                 - 2*(h_avg_u[k]*h_avg_uv[k] + h_avg_v[k]*h_avg_vv[k] + w_cc*vw_cc)
-                                 + 2*(h_avg_u[k]*h_avg_u[k] + h_avg_v[k]*h_avg_v[k] + w_cc*w_cc)*h_avg_v[k]
-                                   << " " // cell-centered (u'_i u'_i)v'
+                                << 0                                     << " " // u'u'
+                                << 0                                     << " " // u'v'
+                                << h_avg_uw[k]   -      uface*h_avg_w[k] << " " // u'w'
+                                << 0                                     << " " // v'v'
+                                << h_avg_vw[k]   -      vface*h_avg_w[k] << " " // v'w'
+                                << h_avg_ww[k]   - h_avg_w[k]*h_avg_w[k] << " " // w'w'
+                                << 0                                     << " " // u'th'
+                                << 0                                     << " " // v'th'
+                                << h_avg_wth[k]  -     thface*h_avg_w[k] << " " // w'th'
+                                << 0                                     << " " // th'th'
+                                << 0                                     << " " // (u'_i u'_i)u'
+                                << 0                                     << " " // (u'_i u'_i)v'
                                 << h_avg_uiuiw[k]
                                  - (uuface + vvface + h_avg_ww[k])*h_avg_w[k]
                                  - 2*(uface*h_avg_uw[k] + vface*h_avg_vw[k] + h_avg_w[k]*h_avg_ww[k])
                                  + 2*(uface*uface + vface*vface + h_avg_w[k]*h_avg_w[k])*h_avg_w[k]
-                                   << " " // face-centered (u'_i u'_i)w'
-                                << h_avg_pu[k]   - h_avg_p[k]*h_avg_u[k]   << " " // cell-centered p'u'
-                                << h_avg_pv[k]   - h_avg_p[k]*h_avg_v[k]   << " " // cell-centered p'v'
-                                << h_avg_pw[k]   -      pface*h_avg_w[k]   << " " // face-centered p'w'
-                                << h_avg_wqv[k]  -     qvface*h_avg_w[k]   << " "
-                                << h_avg_wqc[k]  -     qcface*h_avg_w[k]   << " "
-                                << h_avg_wqr[k]  -     qrface*h_avg_w[k]   << " "
+                                   << " " // (u'_i u'_i)w'
+                                << 0                                     << " " // pu'
+                                << 0                                     << " " // pv'
+                                << h_avg_pw[k]   -      pface*h_avg_w[k] << " " // pw'
+                                << h_avg_wqv[k]  -     qvface*h_avg_w[k] << " "
+                                << h_avg_wqc[k]  -     qcface*h_avg_w[k] << " "
+                                << h_avg_wqr[k]  -     qrface*h_avg_w[k] << " "
                                 << h_avg_wthv[k] -    thvface*h_avg_w[k]
                                 << std::endl;
-                  } // loop over z
-
-                  // Write top face values, extrapolating scalar quantities
-                  const int k = unstag_size;
-                  Real uface  = 1.5*h_avg_u[k-1]  - 0.5*h_avg_u[k-2];
-                  Real vface  = 1.5*h_avg_v[k-1]  - 0.5*h_avg_v[k-2];
-                  Real thface = 1.5*h_avg_th[k-1] - 0.5*h_avg_th[k-2];
-                  Real pface  = 1.5*h_avg_p[k-1]  - 0.5*h_avg_p[k-2];
-                  Real qvface = 1.5*h_avg_qv[k-1] - 0.5*h_avg_qv[k-2];
-                  Real qcface = 1.5*h_avg_qc[k-1] - 0.5*h_avg_qc[k-2];
-                  Real qrface = 1.5*h_avg_qr[k-1] - 0.5*h_avg_qr[k-2];
-                  Real uuface = 1.5*h_avg_uu[k-1] - 0.5*h_avg_uu[k-2];
-                  Real vvface = 1.5*h_avg_vv[k-1] - 0.5*h_avg_vv[k-2];
-                  Real thvface = thface * (1 + 0.61*qvface - qcface - qrface);
-                  Real z = (zlevels_stag.size() > 1) ? zlevels_stag[unstag_size] : unstag_size * dx[2];
-                  data_log2 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
-                            << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                            << 0                                     << " " // u'u'
-                            << 0                                     << " " // u'v'
-                            << h_avg_uw[k]   -      uface*h_avg_w[k] << " " // u'w'
-                            << 0                                     << " " // v'v'
-                            << h_avg_vw[k]   -      vface*h_avg_w[k] << " " // v'w'
-                            << h_avg_ww[k]   - h_avg_w[k]*h_avg_w[k] << " " // w'w'
-                            << 0                                     << " " // u'th'
-                            << 0                                     << " " // v'th'
-                            << h_avg_wth[k]  -     thface*h_avg_w[k] << " " // w'th'
-                            << 0                                     << " " // th'th'
-                            << 0                                     << " " // (u'_i u'_i)u'
-                            << 0                                     << " " // (u'_i u'_i)v'
-                            << h_avg_uiuiw[k]
-                             - (uuface + vvface + h_avg_ww[k])*h_avg_w[k]
-                             - 2*(uface*h_avg_uw[k] + vface*h_avg_vw[k] + h_avg_w[k]*h_avg_ww[k])
-                             + 2*(uface*uface + vface*vface + h_avg_w[k]*h_avg_w[k])*h_avg_w[k]
-                               << " " // (u'_i u'_i)w'
-                            << 0                                     << " " // pu'
-                            << 0                                     << " " // pv'
-                            << h_avg_pw[k]   -      pface*h_avg_w[k] << " " // pw'
-                            << h_avg_wqv[k]  -     qvface*h_avg_w[k] << " "
-                            << h_avg_wqc[k]  -     qcface*h_avg_w[k] << " "
-                            << h_avg_wqr[k]  -     qrface*h_avg_w[k] << " "
-                            << h_avg_wthv[k] -    thvface*h_avg_w[k]
-                            << std::endl;
-                } // if good
-            } // NumDataLogs
-
-            if (NumDataLogs() > 3 && time > 0.) {
-                std::ostream& data_log3 = DataLog(3);
-                if (data_log3.good()) {
-                  // Write the average stresses
-                  for (int k = 0; k < unstag_size; k++) {
-                      Real z = (zlevels_stag.size() > 1) ? zlevels_stag[k] : k * dx[2];
+                    } // if good
+                } // NumDataLogs
+
+                if (NumDataLogs() > 3 && time > 0.) {
+                    std::ostream& data_log3 = DataLog(3);
+                    if (data_log3.good()) {
+                      // Write the average stresses
+                      for (int k = 0; k < unstag_size; k++) {
+                          Real z = (zlevels.size() > 1) ? zlevels[k] : k * dx[2];
+                          data_log3 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
+                                    << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
+                                    << h_avg_tau11[k]  << " " << h_avg_tau12[k] << " " << h_avg_tau13[k] << " "
+                                    << h_avg_tau22[k]  << " " << h_avg_tau23[k] << " " << h_avg_tau33[k] << " "
+                                    << h_avg_sgshfx[k] << " "
+                                    << h_avg_sgsq1fx[k] << " " << h_avg_sgsq2fx[k] << " "
+                                    << h_avg_sgsdiss[k]
+                                    << std::endl;
+                      } // loop over z
+                      // Write top face values
+                      Real NANval = 0.0;
+                      Real z = (zlevels.size() > 1) ? zlevels[unstag_size] : unstag_size * dx[2];
                       data_log3 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
                                 << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                                << h_avg_tau11[k]  << " " << h_avg_tau12[k] << " " << h_avg_tau13[k] << " "
-                                << h_avg_tau22[k]  << " " << h_avg_tau23[k] << " " << h_avg_tau33[k] << " "
-                                << h_avg_sgshfx[k] << " "
-                                << h_avg_sgsq1fx[k] << " " << h_avg_sgsq2fx[k] << " "
-                                << h_avg_sgsdiss[k]
+                                << NANval << " " << NANval << " " << h_avg_tau13[unstag_size] << " "
+                                << NANval << " " << h_avg_tau23[unstag_size] << " " << NANval << " "
+                                << h_avg_sgshfx[unstag_size] << " "
+                                << h_avg_sgsq1fx[unstag_size] << " " << h_avg_sgsq2fx[unstag_size] << " "
+                                << NANval
                                 << std::endl;
-                  } // loop over z
-                  // Write top face values
-                  Real NANval = 0.0;
-                  Real z = (zlevels_stag.size() > 1) ? zlevels_stag[unstag_size] : unstag_size * dx[2];
-                  data_log3 << std::setw(datwidth) << std::setprecision(timeprecision) << time << " "
-                            << std::setw(datwidth) << std::setprecision(datprecision) << z << " "
-                            << NANval << " " << NANval << " " << h_avg_tau13[unstag_size] << " "
-                            << NANval << " " << h_avg_tau23[unstag_size] << " " << NANval << " "
-                            << h_avg_sgshfx[unstag_size] << " "
-                            << h_avg_sgsq1fx[unstag_size] << " " << h_avg_sgsq2fx[unstag_size] << " "
-                            << NANval
-                            << std::endl;
-                } // if good
-            } // if (NumDataLogs() > 3)
+                    } // if good
+                } // if (NumDataLogs() > 3)
+            });
         } // if IOProcessor
     } // if (NumDataLogs() > 1)
 }
@@ -338,9 +349,6 @@ ERF::derive_diag_profiles_stag (Real /*time*/,
     MultiFab  w_fc(vars_new[lev][Vars::zvel], make_alias, 0, 1); // w at face centers (staggered)
 
     int zdir = 2;
-    auto domain = geom[0].Domain();
-    Box stag_domain = domain;
-    stag_domain.convert(IntVect(0,0,1));
 
     int nvars = vars_new[lev][Vars::cons].nComp();
     MultiFab mf_cons(vars_new[lev][Vars::cons], make_alias, 0, nvars);
@@ -523,88 +531,51 @@ ERF::derive_diag_profiles_stag (Real /*time*/,
         } // mfi
     } // use_moisture
 
-    // Sum in the horizontal plane
-    h_avg_u = sumToLine(u_cc,0,1,     domain,zdir);
-    h_avg_v = sumToLine(v_cc,0,1,     domain,zdir);
-    h_avg_w = sumToLine(w_fc,0,1,stag_domain,zdir);
-
-    h_avg_rho   = sumToLine(mf_out, 0,1,domain,zdir);
-    h_avg_th    = sumToLine(mf_out, 1,1,domain,zdir);
-    h_avg_ksgs  = sumToLine(mf_out, 2,1,domain,zdir);
-    h_avg_Kmv   = sumToLine(mf_out, 3,1,domain,zdir);
-    h_avg_Khv   = sumToLine(mf_out, 4,1,domain,zdir);
-    h_avg_uu    = sumToLine(mf_out, 5,1,domain,zdir);
-    h_avg_uv    = sumToLine(mf_out, 6,1,domain,zdir);
-    h_avg_vv    = sumToLine(mf_out, 7,1,domain,zdir);
-    h_avg_uth   = sumToLine(mf_out, 8,1,domain,zdir);
-    h_avg_vth   = sumToLine(mf_out, 9,1,domain,zdir);
-    h_avg_thth  = sumToLine(mf_out,10,1,domain,zdir);
-    h_avg_uiuiu = sumToLine(mf_out,11,1,domain,zdir);
-    h_avg_uiuiv = sumToLine(mf_out,12,1,domain,zdir);
-    h_avg_p     = sumToLine(mf_out,13,1,domain,zdir);
-    h_avg_pu    = sumToLine(mf_out,14,1,domain,zdir);
-    h_avg_pv    = sumToLine(mf_out,15,1,domain,zdir);
-    h_avg_qv    = sumToLine(mf_out,16,1,domain,zdir);
-    h_avg_qc    = sumToLine(mf_out,17,1,domain,zdir);
-    h_avg_qr    = sumToLine(mf_out,18,1,domain,zdir);
-    h_avg_qi    = sumToLine(mf_out,19,1,domain,zdir);
-    h_avg_qs    = sumToLine(mf_out,20,1,domain,zdir);
-    h_avg_qg    = sumToLine(mf_out,21,1,domain,zdir);
-
-    h_avg_uw    = sumToLine(mf_out_stag,0,1,stag_domain,zdir);
-    h_avg_vw    = sumToLine(mf_out_stag,1,1,stag_domain,zdir);
-    h_avg_ww    = sumToLine(mf_out_stag,2,1,stag_domain,zdir);
-    h_avg_wth   = sumToLine(mf_out_stag,3,1,stag_domain,zdir);
-    h_avg_uiuiw = sumToLine(mf_out_stag,4,1,stag_domain,zdir);
-    h_avg_pw    = sumToLine(mf_out_stag,5,1,stag_domain,zdir);
-    h_avg_wqv   = sumToLine(mf_out_stag,6,1,stag_domain,zdir);
-    h_avg_wqc   = sumToLine(mf_out_stag,7,1,stag_domain,zdir);
-    h_avg_wqr   = sumToLine(mf_out_stag,8,1,stag_domain,zdir);
-    h_avg_wthv  = sumToLine(mf_out_stag,9,1,stag_domain,zdir);
-
-    // Divide by the total number of cells we are averaging over
-    Real area_z = static_cast<Real>(domain.length(0)*domain.length(1));
-    int unstag_size = h_avg_w.size() - 1; // _un_staggered heights
-    for (int k = 0; k < unstag_size; ++k) {
-        h_avg_u[k]     /= area_z;
-        h_avg_v[k]     /= area_z;
-        h_avg_rho[k]   /= area_z;
-        h_avg_ksgs[k]  /= area_z;
-        h_avg_Kmv[k]   /= area_z;
-        h_avg_Khv[k]   /= area_z;
-        h_avg_th[k]    /= area_z;
-        h_avg_thth[k]  /= area_z;
-        h_avg_uu[k]    /= area_z;
-        h_avg_uv[k]    /= area_z;
-        h_avg_vv[k]    /= area_z;
-        h_avg_uth[k]   /= area_z;
-        h_avg_vth[k]   /= area_z;
-        h_avg_uiuiu[k] /= area_z;
-        h_avg_uiuiv[k] /= area_z;
-        h_avg_p[k]     /= area_z;
-        h_avg_pu[k]    /= area_z;
-        h_avg_pv[k]    /= area_z;
-        h_avg_qv[k]    /= area_z;
-        h_avg_qc[k]    /= area_z;
-        h_avg_qr[k]    /= area_z;
-        h_avg_qi[k]    /= area_z;
-        h_avg_qs[k]    /= area_z;
-        h_avg_qg[k]    /= area_z;
-    }
-
-    for (int k = 0; k < unstag_size+1; ++k) { // staggered heights
-        h_avg_w[k]     /= area_z;
-        h_avg_uw[k]    /= area_z;
-        h_avg_vw[k]    /= area_z;
-        h_avg_ww[k]    /= area_z;
-        h_avg_wth[k]   /= area_z;
-        h_avg_uiuiw[k] /= area_z;
-        h_avg_pw[k]    /= area_z;
-        h_avg_wqv[k]   /= area_z;
-        h_avg_wqc[k]   /= area_z;
-        h_avg_wqr[k]   /= area_z;
-        h_avg_wthv[k]  /= area_z;
-    }
+    // Average in the horizontal plane, with a single reduction across ranks
+    BatchedPlaneAverage havg(geom[0], zdir);
+    int ivels = havg.add(&mf_vels);
+    int iw    = havg.add(&w_fc);
+    int iout  = havg.add(&mf_out);
+    int istag = havg.add(&mf_out_stag);
+    havg();
+
+    havg.line_average(ivels, 0, h_avg_u);
+    havg.line_average(ivels, 1, h_avg_v);
+    havg.line_average(iw   , 0, h_avg_w);
+
+    havg.line_average(iout, 0, h_avg_rho);
+    havg.line_average(iout, 1, h_avg_th);
+    havg.line_average(iout, 2, h_avg_ksgs);
+    havg.line_average(iout, 3, h_avg_Kmv);
+    havg.line_average(iout, 4, h_avg_Khv);
+    havg.line_average(iout, 5, h_avg_uu);
+    havg.line_average(iout, 6, h_avg_uv);
+    havg.line_average(iout, 7, h_avg_vv);
+    havg.line_average(iout, 8, h_avg_uth);
+    havg.line_average(iout, 9, h_avg_vth);
+    havg.line_average(iout,10, h_avg_thth);
+    havg.line_average(iout,11, h_avg_uiuiu);
+    havg.line_average(iout,12, h_avg_uiuiv);
+    havg.line_average(iout,13, h_avg_p);
+    havg.line_average(iout,14, h_avg_pu);
+    havg.line_average(iout,15, h_avg_pv);
+    havg.line_average(iout,16, h_avg_qv);
+    havg.line_average(iout,17, h_avg_qc);
+    havg.line_average(iout,18, h_avg_qr);
+    havg.line_average(iout,19, h_avg_qi);
+    havg.line_average(iout,20, h_avg_qs);
+    havg.line_average(iout,21, h_avg_qg);
+
+    havg.line_average(istag, 0, h_avg_uw);
+    havg.line_average(istag, 1, h_avg_vw);
+    havg.line_average(istag, 2, h_avg_ww);
+    havg.line_average(istag, 3, h_avg_wth);
+    havg.line_average(istag, 4, h_avg_uiuiw);
+    havg.line_average(istag, 5, h_avg_pw);
+    havg.line_average(istag, 6, h_avg_wqv);
+    havg.line_average(istag, 7, h_avg_wqc);
+    havg.line_average(istag, 8, h_avg_wqr);
+    havg.line_average(istag, 9, h_avg_wthv);
 }
 
 void
@@ -679,42 +650,25 @@ ERF::derive_stress_profiles_stag (Gpu::HostVector<Real>& h_avg_tau11, Gpu::HostV
         });
     }
 
-    int zdir = 2;
-    auto domain = geom[0].Domain();
-    Box stag_domain = domain;
-    stag_domain.convert(IntVect(0,0,1));
-
-    h_avg_tau11 = sumToLine(mf_out,0,1,domain,zdir);
-    h_avg_tau12 = sumToLine(mf_out,1,1,domain,zdir);
-//  h_avg_tau13 = sumToLine(mf_out,2,1,domain,zdir);
-    h_avg_tau22 = sumToLine(mf_out,3,1,domain,zdir);
-//  h_avg_tau23 = sumToLine(mf_out,4,1,domain,zdir);
-    h_avg_tau33 = sumToLine(mf_out,5,1,domain,zdir);
-//  h_avg_hfx3  = sumToLine(mf_out,6,1,domain,zdir);
-//  h_avg_q1fx3 = sumToLine(mf_out,7,1,domain,zdir);
-//  h_avg_q2fx3 = sumToLine(mf_out,8,1,domain,zdir);
-    h_avg_diss  = sumToLine(mf_out,9,1,domain,zdir);
-
-    h_avg_tau13 = sumToLine(mf_out_stag,0,1,stag_domain,zdir);
-    h_avg_tau23 = sumToLine(mf_out_stag,1,1,stag_domain,zdir);
-    h_avg_hfx3  = sumToLine(mf_out_stag,2,1,stag_domain,zdir);
-    h_avg_q1fx3 = sumToLine(mf_out_stag,3,1,stag_domain,zdir);
-    h_avg_q2fx3 = sumToLine(mf_out_stag,4,1,stag_domain,zdir);
-
-    int ht_size =  h_avg_tau11.size(); // _un_staggered
-
-    // Divide by the total number of cells we are averaging over
-    Real area_z = static_cast<Real>(domain.length(0)*domain.length(1));
-    for (int k = 0; k < ht_size; ++k) {
-        h_avg_tau11[k] /= area_z; h_avg_tau12[k] /= area_z;
-        h_avg_tau22[k] /= area_z;
-        h_avg_tau33[k] /= area_z;
-        h_avg_diss[k] /= area_z;
-    }
-    for (int k = 0; k < ht_size+1; ++k) { // staggered heights
-        h_avg_tau13[k] /= area_z;
-        h_avg_tau23[k] /= area_z;
-        h_avg_hfx3[k] /= area_z;
-        h_avg_q1fx3[k] /= area_z; h_avg_q2fx3[k] /= area_z;
-    }
+    BatchedPlaneAverage havg(geom[0], 2);
+    int iout  = havg.add(&mf_out);
+    int istag = havg.add(&mf_out_stag);
+    havg();
+
+    havg.line_average(iout, 0, h_avg_tau11);
+    havg.line_average(iout, 1, h_avg_tau12);
+//  havg.line_average(iout, 2, h_avg_tau13);
+    havg.line_average(iout, 3, h_avg_tau22);
+//  havg.line_average(iout, 4, h_avg_tau23);
+    havg.line_average(iout, 5, h_avg_tau33);
+//  havg.line_average(iout, 6, h_avg_hfx3);
+//  havg.line_average(iout, 7, h_avg_q1fx3);
+//  havg.line_average(iout, 8, h_avg_q2fx3);
+    havg.line_average(iout, 9, h_avg_diss);
+
+    havg.line_average(istag, 0, h_avg_tau13);
+    havg.line_average(istag, 1, h_avg_tau23);
+    havg.line_average(istag, 2, h_avg_hfx3);
+    havg.line_average(istag, 3, h_avg_q1fx3);
+    havg.line_average(istag, 4, h_avg_q2fx3);
 }
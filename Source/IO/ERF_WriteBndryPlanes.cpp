@@ -2,46 +2,15 @@
 #include "AMReX_ParmParse.H"
 #include "AMReX_PlotFileUtil.H"
 #include "AMReX_MultiFabUtil.H"
+#include "AMReX_VisMF.H"
 #include "ERF_WriteBndryPlanes.H"
+#include "ERF_BndryPlaneLayout.H"
+#include "AMReX_Utility.H"
 #include "IndexDefines.H"
 #include "Derive.H"
 
 using namespace amrex;
 
-/**
- * Copies the contents of one boundary register to another in either x or y dimensions.
- *
- * @param oit Orientation iterator used for determining which dimension we are to copy
- * @param b1 Boundary register containing the source data
- * @param b2 Boundary register containing the destination data
- */
-void br_shift (OrientationIter oit, const BndryRegister& b1, BndryRegister& b2)
-{
-    auto ori = oit();
-    int ncomp = b1[ori].nComp();
-    if (ori.coordDir() < 2) {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-        for (FabSetIter bfsi(b1[ori]); bfsi.isValid(); ++bfsi) {
-            int idx = bfsi.index();
-            const Box& bx1 = b1[ori].boxArray()[idx];
-            const Box& bx2 = b2[ori].boxArray()[idx];
-
-            // Copy onto a boundary register based on a box starting at (0,0,0)
-            Array4<Real>       dest_arr = b2[ori][idx].array();
-            Array4<Real const>  src_arr = b1[ori][idx].const_array();
-            int ioff = bx1.smallEnd(0) - bx2.smallEnd(0);
-            int joff = bx1.smallEnd(1) - bx2.smallEnd(1);
-            ParallelFor(bx2, ncomp,
-            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept
-            {
-                dest_arr(i,j,k,n) = src_arr(i+ioff,j+joff,k,n);
-            });
-        }
-    }
-}
-
 // Default to level 0
 int WriteBndryPlanes::bndry_lev = 0;
 
@@ -101,6 +70,16 @@ WriteBndryPlanes::WriteBndryPlanes (Vector<BoxArray>& grids,
 
     m_time_file = m_filename + "/time.dat";
 
+    // "native" writes a folder of VisMF files per step, "container" appends
+    // every step to one file per rank (see BndryPlaneContainer)
+    std::string format = "native";
+    pp.query("bndry_output_format", format);
+    if (format == "container") {
+        m_use_container = true;
+    } else if (format != "native") {
+        Error("WriteBndryPlanes: bndry_output_format must be native or container");
+    }
+
     if (pp.contains("bndry_output_var_names"))
     {
         int num_vars = pp.countval("bndry_output_var_names");
@@ -132,16 +111,29 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
     //Print() << "Writing boundary planes at time " << time << std::endl;
 
     const std::string level_prefix = "Level_";
-    PreBuildDirectorHierarchy(chkname, level_prefix, 1, true);
+    if (m_use_container) {
+        if (!m_container) {
+            if (ParallelDescriptor::IOProcessor()) {
+                if (!UtilCreateDirectory(m_filename, 0755)) {
+                    CreateDirectoryFailed(m_filename);
+                }
+            }
+            ParallelDescriptor::Barrier();
+            m_container = std::make_unique<BndryPlaneContainer>();
+        }
+    } else {
+        PreBuildDirectorHierarchy(chkname, level_prefix, 1, true);
+    }
 
-    // note: by using the entire domain box we end up using 1 processor
-    // to hold all boundaries
-    BoxArray ba(target_box);
-    DistributionMapping dm{ba};
+    // Patches of this rank for the container, in host memory, and the
+    // patches of all ranks for its header
+    Vector<BndryPlaneContainer::Patch> patches;
+    Vector<FArrayBox> host_fabs;
+    Vector<BndryPlaneContainer::Owner> owners;
 
-    IntVect new_hi = target_box.bigEnd() - target_box.smallEnd();
-    Box target_box_shifted(IntVect(0,0,0),new_hi);
-    BoxArray ba_shifted(target_box_shifted);
+    // The faces are split like the grids next to them, so every rank
+    // writes the patches of the faces it owns
+    const IntVect shift = -target_box.smallEnd();
 
     int n_moist_var = NMOIST_max - (S.nComp() - NVAR_max);
     bool ismoist = (n_moist_var >= 1);
@@ -158,13 +150,59 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
             ncomp = 1;
         }
 
-        BndryRegister bndry        (ba        , dm, m_in_rad, m_out_rad, m_extent_rad, ncomp);
-        BndryRegister bndry_shifted(ba_shifted, dm, m_in_rad, m_out_rad, m_extent_rad, ncomp);
+        // Copy each face of the target box from src and write it, indexed from (0,0,0)
+        auto write_faces = [&] (const MultiFab& src, int src_comp)
+        {
+            for (OrientationIter oit; oit != nullptr; ++oit) {
+                auto ori = oit();
+                if (ori.coordDir() < 2) {
+                    BoxArray fba;
+                    DistributionMapping fdm;
+                    bndry_face_layout(target_box, ori, src.boxArray(), src.DistributionMap(),
+                                      m_in_rad, m_out_rad, fba, fdm);
+
+                    MultiFab face(fba, fdm, ncomp, 0);
+                    face.ParallelCopy(src, src_comp, 0, ncomp, IntVect(0), IntVect(0),
+                                      m_geom[bndry_lev].periodicity());
+
+                    BoxArray fba_shifted(fba);
+                    fba_shifted.shift(shift);
+                    MultiFab face_shifted(fba_shifted, fdm, ncomp, 0);
+                    for (MFIter mfi(face); mfi.isValid(); ++mfi) {
+                        face_shifted[mfi].copy<RunOn::Device>(face[mfi], mfi.validbox(), 0,
+                                                              face_shifted[mfi].box(), 0, ncomp);
+                    }
+
+                    if (m_use_container) {
+                        for (int n = 0; n < fba_shifted.size(); ++n) {
+                            owners.push_back({fdm[n], static_cast<int>(ori), fba_shifted[n]});
+                        }
+                        for (MFIter mfi(face_shifted); mfi.isValid(); ++mfi) {
+                            const Box& bx = mfi.validbox();
+                            host_fabs.emplace_back(bx, ncomp, The_Pinned_Arena());
+                            host_fabs.back().copy<RunOn::Device>(face_shifted[mfi], bx, 0, bx, 0, ncomp);
+                            BndryPlaneContainer::Patch p;
+                            p.var   = i;
+                            p.ori   = ori;
+                            p.ncomp = ncomp;
+                            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                                p.lo[d] = bx.smallEnd(d);
+                                p.hi[d] = bx.bigEnd(d);
+                            }
+                            p.offset = 0;
+                            patches.push_back(p);
+                        }
+                    } else {
+                        std::string facename = Concatenate(filename + '_', ori, 1);
+                        VisMF::Write(face_shifted, facename);
+                    }
+                }
+            }
+        };
 
-        int nghost = 0;
         if (var_name == "density")
         {
-            bndry.copyFrom(S, nghost, Rho_comp, 0, ncomp, m_geom[bndry_lev].periodicity());
+            write_faces(S, Rho_comp);
 
         } else if (var_name == "temperature") {
 
@@ -178,7 +216,7 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
                     derived::erf_dertemp(bx, Temp[mfi], 0, 1, S[mfi], m_geom[bndry_lev], time, nullptr, bndry_lev);
                 }
             }
-            bndry.copyFrom(Temp, nghost, 0, 0, ncomp, m_geom[bndry_lev].periodicity());
+            write_faces(Temp, 0);
         } else if (var_name == "scalar") {
 
             MultiFab Temp(S.boxArray(),S.DistributionMap(),ncomp,0);
@@ -187,7 +225,7 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
                 const Box& bx = mfi.tilebox();
                 derived::erf_derrhodivide(bx, Temp[mfi], S[mfi], RhoKE_comp);
             }
-            bndry.copyFrom(Temp, nghost, 0, 0, ncomp, m_geom[bndry_lev].periodicity());
+            write_faces(Temp, 0);
 
         } else if (var_name == "ke") {
 
@@ -197,7 +235,7 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
                 const Box& bx = mfi.tilebox();
                 derived::erf_derrhodivide(bx, Temp[mfi], S[mfi], RhoKE_comp);
             }
-            bndry.copyFrom(Temp, nghost, 0, 0, ncomp, m_geom[bndry_lev].periodicity());
+            write_faces(Temp, 0);
 
         } else if (var_name == "qke") {
 
@@ -207,7 +245,7 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
                 const Box& bx = mfi.tilebox();
                 derived::erf_derrhodivide(bx, Temp[mfi], S[mfi], RhoQKE_comp);
             }
-            bndry.copyFrom(Temp, nghost, 0, 0, ncomp, m_geom[bndry_lev].periodicity());
+            write_faces(Temp, 0);
 
         } else if (var_name == "qv") {
             if (S.nComp() > RhoQ2_comp) {
@@ -217,7 +255,7 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
                     const Box& bx = mfi.tilebox();
                     derived::erf_derrhodivide(bx, Temp[mfi], S[mfi], RhoQ1_comp);
                 }
-                bndry.copyFrom(Temp, nghost, 0, 0, ncomp, m_geom[bndry_lev].periodicity());
+                write_faces(Temp, 0);
             }
         } else if (var_name == "qc") {
             if (S.nComp() > RhoQ2_comp) {
@@ -227,28 +265,30 @@ void WriteBndryPlanes::write_planes (const int t_step, const Real time,
                     const Box& bx = mfi.tilebox();
                     derived::erf_derrhodivide(bx, Temp[mfi], S[mfi], RhoQ2_comp);
                 }
-                bndry.copyFrom(Temp, nghost, 0, 0, ncomp, m_geom[bndry_lev].periodicity());
+                write_faces(Temp, 0);
             }
         } else if (var_name == "velocity") {
             MultiFab Vel(S.boxArray(), S.DistributionMap(), 3, m_out_rad);
             average_face_to_cellcenter(Vel,0,Array<const MultiFab*,3>{&xvel,&yvel,&zvel});
-            bndry.copyFrom(Vel, nghost, 0, 0, ncomp, m_geom[bndry_lev].periodicity());
+            write_faces(Vel, 0);
         } else {
             //Print() << "Trying to write planar output for " << var_name << std::endl;
             Error("Don't know how to output this variable");
         }
 
-        for (OrientationIter oit; oit != nullptr; ++oit) {
-            auto ori = oit();
-            if (ori.coordDir() < 2) {
-                std::string facename = Concatenate(filename + '_', ori, 1);
-                br_shift(oit, bndry, bndry_shifted);
-                bndry_shifted[ori].write(facename);
-            }
-        }
-
     } // loop over num_vars
 
+    if (m_use_container) {
+        Gpu::streamSynchronize();
+        Vector<const FArrayBox*> fabs;
+        for (const auto& fab : host_fabs) {
+            fabs.push_back(&fab);
+        }
+        // The header lists the patches before a reader can find them in an index
+        m_container->add_owners(m_filename, m_var_names, owners);
+        m_container->append(m_filename, t_step, patches, fabs);
+    }
+
     // Writing time.dat
     if (ParallelDescriptor::IOProcessor()) {
         std::ofstream oftime(m_time_file, std::ios::out | std::ios::app);
@@ -1,6 +1,7 @@
 #include <iomanip>
 
 #include "ERF.H"
+#include "BatchedPlaneAverage.H"
 
 using namespace amrex;
 
@@ -65,21 +66,31 @@ ERF::sum_integrated_quantities (Real time)
         scal_ml += volWgtSumMF(lev,vars_new[lev][Vars::cons],RhoScalar_comp,*mapfac_m[lev],true,true);
     }
 
+    // Total water on level 0: the moist scalars plus the precipitation accumulated at the
+    //    surface, stored in mm, i.e. kg/m^2 of water, in the lowest cell
+    const int n_qstate = micro->Get_Qstate_Size();
+    Real water_sl = 0.0;
+    for (int q = 0; q < n_qstate; ++q) {
+        water_sl += volWgtSumMF(0,vars_new[0][Vars::cons],RhoQ1_comp+q,*mapfac_m[0],true,false);
+    }
+    const Real dzinv = geom[0].InvCellSize(2);
+    for (const auto& accum : micro->Get_Qmoist_Accum(0)) {
+        water_sl += dzinv * volWgtSumMF(0,*accum.first,0,*mapfac_m[0],true,false) * accum.second/1000.0;
+    }
+
     Gpu::HostVector<Real> h_avg_ustar; h_avg_ustar.resize(1);
     Gpu::HostVector<Real> h_avg_tstar; h_avg_tstar.resize(1);
     Gpu::HostVector<Real> h_avg_olen; h_avg_olen.resize(1);
     if ((m_most != nullptr) && (NumDataLogs() > 0)) {
-        Box domain = geom[0].Domain();
-        int zdir = 2;
-        h_avg_ustar = sumToLine(*m_most->get_u_star(0),0,1,domain,zdir);
-        h_avg_tstar = sumToLine(*m_most->get_t_star(0),0,1,domain,zdir);
-        h_avg_olen  = sumToLine(*m_most->get_olen(0),0,1,domain,zdir);
-
-        // Divide by the total number of cells we are averaging over
-        Real area_z = static_cast<Real>(domain.length(0)*domain.length(1));
-        h_avg_ustar[0] /= area_z;
-        h_avg_tstar[0] /= area_z;
-        h_avg_olen[0]  /= area_z;
+        BatchedPlaneAverage havg(geom[0], 2);
+        int iustar = havg.add(m_most->get_u_star(0));
+        int itstar = havg.add(m_most->get_t_star(0));
+        int iolen  = havg.add(m_most->get_olen(0));
+        havg();
+
+        h_avg_ustar[0] = havg.line_average(iustar, 0, 0);
+        h_avg_tstar[0] = havg.line_average(itstar, 0, 0);
+        h_avg_olen[0]  = havg.line_average(iolen , 0, 0);
 
     } else {
         h_avg_ustar[0] = 0.;
@@ -87,8 +98,8 @@ ERF::sum_integrated_quantities (Real time)
         h_avg_olen[0]  = 0.;
     }
 
-    const int nfoo = 6;
-    Real foo[nfoo] = {mass_sl,rhth_sl,scal_sl,mass_ml,rhth_ml,scal_ml};
+    const int nfoo = 7;
+    Real foo[nfoo] = {mass_sl,rhth_sl,scal_sl,mass_ml,rhth_ml,scal_ml,water_sl};
 #ifdef AMREX_LAZY
     Lazy::QueueReduction([=]() mutable {
 #endif
@@ -103,6 +114,7 @@ ERF::sum_integrated_quantities (Real time)
         mass_ml = foo[i++];
         rhth_ml = foo[i++];
         scal_ml = foo[i++];
+        water_sl = foo[i++];
 
         Print() << '\n';
         if (finest_level ==  0) {
@@ -122,31 +134,40 @@ ERF::sum_integrated_quantities (Real time)
            Print() << "TIME= " << time << " RHO THETA   SL/ML = " << rhth_sl << " " << rhth_ml << '\n';
            Print() << "TIME= " << time << " RHO SCALAR  SL/ML = " << scal_sl << " " << scal_ml << '\n';
         }
+        if (n_qstate > 0) {
+           Print() << "TIME= " << time << " TOTAL WATER       = " << std::setprecision(15) << water_sl << '\n';
+        }
 
         // The first data log only holds scalars
         if (NumDataLogs() > 0)
         {
-            int n_d = 0;
-            std::ostream& data_log1 = DataLog(n_d);
-            if (data_log1.good()) {
-                if (time == 0.0) {
-                    data_log1 << std::setw(datwidth) << "          time";
-                    data_log1 << std::setw(datwidth) << "          u_star";
-                    data_log1 << std::setw(datwidth) << "          t_star";
-                    data_log1 << std::setw(datwidth) << "          olen";
-                    data_log1 << std::endl;
-                } // time = 0
-
-              // Write the quantities at this time
-              data_log1 << std::setw(datwidth) << time;
-              data_log1 << std::setw(datwidth) << std::setprecision(datprecision)
-                        << h_avg_ustar[0];
-              data_log1 << std::setw(datwidth) << std::setprecision(datprecision)
-                        << h_avg_tstar[0];
-              data_log1 << std::setw(datwidth) << std::setprecision(datprecision)
-                        << h_avg_olen[0];
-              data_log1 << std::endl;
-            } // if good
+            Real ustar = h_avg_ustar[0];
+            Real tstar = h_avg_tstar[0];
+            Real olen  = h_avg_olen[0];
+            write_diagnostics([this,time,ustar,tstar,olen,datwidth,datprecision] ()
+            {
+                int n_d = 0;
+                std::ostream& data_log1 = DataLog(n_d);
+                if (data_log1.good()) {
+                    if (time == 0.0) {
+                        data_log1 << std::setw(datwidth) << "          time";
+                        data_log1 << std::setw(datwidth) << "          u_star";
+                        data_log1 << std::setw(datwidth) << "          t_star";
+                        data_log1 << std::setw(datwidth) << "          olen";
+                        data_log1 << std::endl;
+                    } // time = 0
+
+                  // Write the quantities at this time
+                  data_log1 << std::setw(datwidth) << time;
+                  data_log1 << std::setw(datwidth) << std::setprecision(datprecision)
+                            << ustar;
+                  data_log1 << std::setw(datwidth) << std::setprecision(datprecision)
+                            << tstar;
+                  data_log1 << std::setw(datwidth) << std::setprecision(datprecision)
+                            << olen;
+                  data_log1 << std::endl;
+                } // if good
+            });
         } // loop over i
       } // if IOProcessor
 #ifdef AMREX_LAZY
@@ -262,15 +283,18 @@ ERF::sample_points (int /*lev*/, Real time, IntVect cell, MultiFab& mf)
 
         // HERE DO WHATEVER YOU WANT TO THE DATA BEFORE WRITING
 
-        std::ostream& sample_log = SamplePointLog(ifile);
-        if (sample_log.good()) {
-          sample_log << std::setw(datwidth) << time;
-          for (int i = 0; i < ncomp; ++i)
-          {
-              sample_log << std::setw(datwidth) << my_point[i];
-          }
-          sample_log << std::endl;
-        } // if good
+        write_diagnostics([this,ifile,time,ncomp,datwidth,my_point] ()
+        {
+            std::ostream& sample_log = SamplePointLog(ifile);
+            if (sample_log.good()) {
+              sample_log << std::setw(datwidth) << time;
+              for (int i = 0; i < ncomp; ++i)
+              {
+                  sample_log << std::setw(datwidth) << my_point[i];
+              }
+              sample_log << std::endl;
+            } // if good
+        });
     } // only write from processor that holds the cell
 }
 
@@ -316,52 +340,46 @@ ERF::sample_lines (int lev, Real time, IntVect cell, MultiFab& mf)
     {
         // HERE DO WHATEVER YOU WANT TO THE DATA BEFORE WRITING
 
-        std::ostream& sample_log = SampleLineLog(ifile);
-        if (sample_log.good()) {
-          sample_log << std::setw(datwidth) << std::setprecision(datprecision) << time;
-          const auto& my_line_arr = my_line[0].const_array();
-          const auto& my_line_vels_arr = my_line_vels[0].const_array();
-          const auto& my_line_tau11_arr = my_line_tau11[0].const_array();
-          const auto& my_line_tau12_arr = my_line_tau12[0].const_array();
-          const auto& my_line_tau13_arr = my_line_tau13[0].const_array();
-          const auto& my_line_tau22_arr = my_line_tau22[0].const_array();
-          const auto& my_line_tau23_arr = my_line_tau23[0].const_array();
-          const auto& my_line_tau33_arr = my_line_tau33[0].const_array();
-          const Box&  my_box = my_line[0].box();
-          const int klo = my_box.smallEnd(2);
-          const int khi = my_box.bigEnd(2);
-          int i = cell[0];
-          int j = cell[1];
-          for (int n = 0; n < ncomp; n++) {
-              for (int k = klo; k <= khi; k++) {
-                  sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_arr(i,j,k,n);
-              }
-          }
-          for (int n = 0; n < AMREX_SPACEDIM; n++) {
-              for (int k = klo; k <= khi; k++) {
-                  sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_vels_arr(i,j,k,n);
+        // Copy the line out in the order it is written so the formatting can be deferred
+        const auto& my_line_arr = my_line[0].const_array();
+        const auto& my_line_vels_arr = my_line_vels[0].const_array();
+        const Box&  my_box = my_line[0].box();
+        const int klo = my_box.smallEnd(2);
+        const int khi = my_box.bigEnd(2);
+        int i = cell[0];
+        int j = cell[1];
+
+        Vector<Real> my_vals;
+        my_vals.reserve((ncomp + AMREX_SPACEDIM + 6) * (khi - klo + 1));
+        for (int n = 0; n < ncomp; n++) {
+            for (int k = klo; k <= khi; k++) {
+                my_vals.push_back(my_line_arr(i,j,k,n));
+            }
+        }
+        for (int n = 0; n < AMREX_SPACEDIM; n++) {
+            for (int k = klo; k <= khi; k++) {
+                my_vals.push_back(my_line_vels_arr(i,j,k,n));
+            }
+        }
+        for (const MultiFab* tau : {&my_line_tau11, &my_line_tau12, &my_line_tau13,
+                                    &my_line_tau22, &my_line_tau23, &my_line_tau33}) {
+            const auto& my_line_tau_arr = (*tau)[0].const_array();
+            for (int k = klo; k <= khi; k++) {
+                my_vals.push_back(my_line_tau_arr(i,j,k));
+            }
+        }
+
+        write_diagnostics([this,ifile,time,datwidth,datprecision,my_vals=std::move(my_vals)] ()
+        {
+            std::ostream& sample_log = SampleLineLog(ifile);
+            if (sample_log.good()) {
+              sample_log << std::setw(datwidth) << std::setprecision(datprecision) << time;
+              for (const auto& val : my_vals) {
+                  sample_log << std::setw(datwidth) << std::setprecision(datprecision) << val;
               }
-          }
-          for (int k = klo; k <= khi; k++) {
-              sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_tau11_arr(i,j,k);
-          }
-          for (int k = klo; k <= khi; k++) {
-              sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_tau12_arr(i,j,k);
-          }
-          for (int k = klo; k <= khi; k++) {
-              sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_tau13_arr(i,j,k);
-          }
-          for (int k = klo; k <= khi; k++) {
-              sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_tau22_arr(i,j,k);
-          }
-          for (int k = klo; k <= khi; k++) {
-              sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_tau23_arr(i,j,k);
-          }
-          for (int k = klo; k <= khi; k++) {
-              sample_log << std::setw(datwidth) << std::setprecision(datprecision) << my_line_tau33_arr(i,j,k);
-          }
-          sample_log << std::endl;
-        } // if good
+              sample_log << std::endl;
+            } // if good
+        });
     } // mfi
 }
 
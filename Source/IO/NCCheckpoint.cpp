@@ -15,6 +15,9 @@ ERF::WriteNCCheckpointFile () const
 
     Print() << "Writing NetCDF checkpoint " << checkpointname << "\n";
 
+    // Make sure the logs are up to date with the checkpoint we restart from
+    flush_diagnostics();
+
     const int nlevels = finest_level+1;
 
     // ---- ParallelDescriptor::IOProcessor() creates the directories
@@ -213,21 +216,20 @@ ERF::ReadNCCheckpointFile ()
     // read in the MultiFab data
     for (int lev = 0; lev <= finest_level; ++lev)
     {
-
         MultiFab cons(grids[lev],dmap[lev],nc_cons,0);
-        WriteNCMultiFab(cons, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(cons, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
         MultiFab::Copy(vars_new[lev][Vars::cons],cons,0,0,nc_cons,0);
 
         MultiFab xvel(convert(grids[lev],IntVect(1,0,0)),dmap[lev],1,0);
-        WriteNCMultiFab(xvel, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(xvel, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "XFace"));
         MultiFab::Copy(vars_new[lev][Vars::xvel],xvel,0,0,1,0);
 
         MultiFab yvel(convert(grids[lev],IntVect(0,1,0)),dmap[lev],1,0);
-        WriteNCMultiFab(yvel, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(yvel, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "YFace"));
         MultiFab::Copy(vars_new[lev][Vars::yvel],yvel,0,0,1,0);
 
         MultiFab zvel(convert(grids[lev],IntVect(0,0,1)),dmap[lev],1,0);
-        WriteNCMultiFab(zvel, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "Cell"));
+        ReadNCMultiFab(zvel, MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "ZFace"));
         MultiFab::Copy(vars_new[lev][Vars::zvel],zvel,0,0,1,0);
 
         // Copy from new into old just in case
@@ -439,6 +439,87 @@ void NCVar::par_access (const int cmode) const
     check_nc_error(nc_var_par_access(ncid, varid, cmode));
 }
 
+namespace {
+
+/**
+ * Collective access to a different number of slices on each rank: the
+ * variable is switched to collective access, and every rank makes as many
+ * calls as the rank with the most slices, with empty slices once it runs out.
+ *
+ * @param access Function reading or writing one slice
+ * @param ptr Pointers to the data of the slices on this rank
+ * @param start Starting indices of the slices
+ * @param count Count sizes of the slices
+ * @param ndim Number of dimensions of the variable
+ * @param comm Communicator the file was opened with
+ */
+template <typename T, typename F>
+void access_all (F const& access, const std::vector<T*>& ptr,
+                 const std::vector<std::vector<size_t>>& start,
+                 const std::vector<std::vector<size_t>>& count,
+                 int ndim, MPI_Comm comm)
+{
+    int nlocal = static_cast<int>(ptr.size());
+    int nmax   = nlocal;
+    MPI_Allreduce(&nlocal, &nmax, 1, MPI_INT, MPI_MAX, comm);
+
+    const std::vector<size_t> zeros(ndim, 0);
+    T dummy{};
+    for (int n = 0; n < nmax; ++n) {
+        if (n < nlocal) {
+            check_nc_error(access(start[n].data(), count[n].data(), ptr[n]));
+        } else {
+            check_nc_error(access(zeros.data(), zeros.data(), &dummy));
+        }
+    }
+}
+
+} // namespace
+
+void NCVar::put_all (const std::vector<const double*>& dptr,
+                     const std::vector<std::vector<size_t>>& start,
+                     const std::vector<std::vector<size_t>>& count,
+                     MPI_Comm comm) const
+{
+    par_access(NC_COLLECTIVE);
+    access_all([this] (const size_t* st, const size_t* ct, const double* p)
+               { return nc_put_vara_double(ncid, varid, st, ct, p); },
+               dptr, start, count, ndim(), comm);
+}
+
+void NCVar::put_all (const std::vector<const float*>& dptr,
+                     const std::vector<std::vector<size_t>>& start,
+                     const std::vector<std::vector<size_t>>& count,
+                     MPI_Comm comm) const
+{
+    par_access(NC_COLLECTIVE);
+    access_all([this] (const size_t* st, const size_t* ct, const float* p)
+               { return nc_put_vara_float(ncid, varid, st, ct, p); },
+               dptr, start, count, ndim(), comm);
+}
+
+void NCVar::get_all (const std::vector<double*>& dptr,
+                     const std::vector<std::vector<size_t>>& start,
+                     const std::vector<std::vector<size_t>>& count,
+                     MPI_Comm comm) const
+{
+    par_access(NC_COLLECTIVE);
+    access_all([this] (const size_t* st, const size_t* ct, double* p)
+               { return nc_get_vara_double(ncid, varid, st, ct, p); },
+               dptr, start, count, ndim(), comm);
+}
+
+void NCVar::get_all (const std::vector<float*>& dptr,
+                     const std::vector<std::vector<size_t>>& start,
+                     const std::vector<std::vector<size_t>>& count,
+                     MPI_Comm comm) const
+{
+    par_access(NC_COLLECTIVE);
+    access_all([this] (const size_t* st, const size_t* ct, float* p)
+               { return nc_get_vara_float(ncid, varid, st, ct, p); },
+               dptr, start, count, ndim(), comm);
+}
+
 std::string NCGroup::name () const
 {
     size_t nlen;
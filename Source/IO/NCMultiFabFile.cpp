@@ -19,71 +19,82 @@
 
 using namespace amrex;
 
+/**
+ * Reads a MultiFab written by WriteNCMultiFab.  The coordinator rank reads
+ * every box, and the data are then copied to the ranks that own them.
+ *
+ * @param mf MultiFab to fill; it must have the boxes of the file and no ghost cells
+ * @param name File name without the "_Data.nc" suffix
+ * @param coordinatorProc Rank that reads the file
+ */
 void
 ERF::ReadNCMultiFab (FabArray<FArrayBox> &mf,
-                     const std::string  &mf_name,
-                     int /*coordinatorProc*/,
+                     const std::string& name,
+                     int coordinatorProc,
                      int /*allow_empty_mf*/) {
 
-    const std::string& FullPath = amrex::Concatenate(check_file,istep[0],5);
+    if (nc_parallel_io) {
+        ReadNCMultiFabPar(mf, name);
+        return;
+    }
 
-    Print() << "Reading MultiFab NetCDF checkpoint file to path: " << FullPath << "\n";
+    AMREX_ALWAYS_ASSERT(mf.nGrow() == 0);
 
-    if (amrex::ParallelDescriptor::IOProcessor())
-    {
-      static const std::string Suffix(mf_name);
-      auto ncf = ncutils::NCFile::create(FullPath+Suffix, NC_CLOBBER | NC_NETCDF4);
-
-      // int num_pts = static_cast<int>(ncf.dim("num_points").len());
-      int ncomp   = static_cast<int>(ncf.dim("num_componts").len());
-      int nbox    = static_cast<int>(ncf.dim("num_box").len());
-      int ngrow   = 0;
-
-      BoxList boxlist;
-      amrex::Vector<std::string> plt_var_names;
+    const BoxArray& ba = mf.boxArray();
+    const int nbox  = ba.size();
+    const int ncomp = mf.nComp();
 
-      for (int nb(0); nb < nbox; ++nb) {
-          amrex::IntVect smallend(AMREX_SPACEDIM);
-          amrex::IntVect bigend(AMREX_SPACEDIM);
-          amrex::IntVect btype(AMREX_SPACEDIM);
+    DistributionMapping dm_io(Vector<int>(nbox, coordinatorProc));
+    FabArray<FArrayBox> mf_io(ba, dm_io, ncomp, 0);
 
-          auto nbb = static_cast<unsigned long int>(nb);
-          ncf.var("SmallEnd").get(smallend.begin(), {0}, {nbb, AMREX_SPACEDIM});
-          ncf.var("BigEnd"  ).get(bigend.begin()  , {0}, {nbb, AMREX_SPACEDIM});
-          ncf.var("BoxType" ).get(btype.begin()   , {0}, {nbb, AMREX_SPACEDIM});
-
-          std::stringstream ss;
-          ss << btype;
-          std::string typ_name = ss.str();
-          plt_var_names.push_back(typ_name+"_"+std::to_string(nb));
+    if (ParallelDescriptor::MyProc() == coordinatorProc)
+    {
+      auto ncf = ncutils::NCFile::open(name+"_Data.nc", NC_NOWRITE);
 
-          boxlist.push_back(amrex::Box(smallend, bigend, btype));
+      if (static_cast<int>(ncf.dim("num_blocks").len())    != nbox ||
+          static_cast<int>(ncf.dim("num_variables").len()) != nbox*ncomp) {
+          Abort("ReadNCMultiFab: " + name + "_Data.nc does not match the MultiFab");
       }
 
-      BoxArray boxarray(boxlist);
-      DistributionMapping dm(boxarray);
-      mf.define(boxarray, dm, ncomp, ngrow, MFInfo(), FArrayBoxFactory());
-
-      for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-           auto ncomp_mf   = mf.nComp();
-           auto num_pts_mf  = static_cast<long unsigned int>(mf.get(mfi).numPts());
-
-           for (int k(0); k < ncomp_mf; ++k) {
-               auto *dataPtr = mf.get(mfi).dataPtr(k);
-               ncf.var(plt_var_names[mfi.index()*ncomp_mf+k]).get(dataPtr, {0}, {num_pts_mf});
-            }
+      for (MFIter mfi(mf_io); mfi.isValid(); ++mfi) {
+          const std::string comp_name = std::to_string(mfi.index());
+          const auto num_pts_mf = static_cast<long unsigned int>(mf_io.get(mfi).numPts());
+          for (int k(0); k < ncomp; ++k) {
+              auto *dataPtr = mf_io.get(mfi).dataPtr(k);
+              ncf.var("var_"+comp_name+"_"+std::to_string(k)).get(dataPtr, {0}, {num_pts_mf});
+          }
       }
+      ncf.close();
+    }
 
-
-   }
+    mf.ParallelCopy(mf_io, 0, 0, ncomp);
 }
 
-
+/**
+ * Writes a MultiFab into one NetCDF file from the I/O rank, which first
+ * gathers every box, as one variable var_<box>_<component> per box and
+ * component.
+ *
+ * @param fab MultiFab to write; it must not have ghost cells
+ * @param name File name without the "_Data.nc" suffix
+ */
 void
 ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
                       const std::string& name,
                       bool /*set_ghost*/) {
 
+    if (nc_parallel_io) {
+        WriteNCMultiFabPar(fab, name);
+        return;
+    }
+
+    AMREX_ALWAYS_ASSERT(fab.nGrow() == 0);
+
+    // Gather every box onto the I/O rank
+    DistributionMapping dm_io(Vector<int>(fab.boxArray().size(), ParallelDescriptor::IOProcessorNumber()));
+    FabArray<FArrayBox> fab_io(fab.boxArray(), dm_io, fab.nComp(), 0);
+    fab_io.ParallelCopy(fab, 0, 0, fab.nComp());
+
     if (amrex::ParallelDescriptor::IOProcessor())
     {
       static const std::string Suffix{"_Data.nc"};
@@ -102,10 +113,10 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
         amrex::Vector<std::string> plt_var_names;
         amrex::Vector<std::string> npts_names;
         amrex::Vector<int> num_pts;
-        for (MFIter mfi(fab); mfi.isValid(); ++mfi) {
-           auto ncomp            = fab.nComp();
+        for (MFIter mfi(fab_io); mfi.isValid(); ++mfi) {
+           auto ncomp            = fab_io.nComp();
            std::string comp_name = std::to_string(mfi.index());
-           int num_points        = fab.get(mfi).numPts();
+           int num_points        = fab_io.get(mfi).numPts();
            for (int k(0); k < ncomp; ++k) {
               plt_var_names.push_back("var_"+comp_name+"_"+std::to_string(k));
               npts_names.push_back("numpts_"+comp_name+"_"+std::to_string(k));
@@ -114,7 +125,7 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
         }
 
         auto nvar      = plt_var_names.size();
-        auto nbox      = fab.local_size();
+        auto nbox      = fab_io.local_size();
 
         amrex::Vector<std::string> lo_names;
         amrex::Vector<std::string> hi_names;
@@ -145,10 +156,10 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
 
         ncf.exit_def_mode();
 
-        for (MFIter mfi(fab); mfi.isValid(); ++mfi) {
-            auto ncomp_mf   = fab.nComp();
-            auto box        = fab.get(mfi).box();
-            auto num_pts_mf = fab.get(mfi).numPts();
+        for (MFIter mfi(fab_io); mfi.isValid(); ++mfi) {
+            auto ncomp_mf   = fab_io.nComp();
+            auto box        = fab_io.get(mfi).box();
+            auto num_pts_mf = fab_io.get(mfi).numPts();
 
             amrex::IntVect smallend = box.smallEnd();
             amrex::IntVect bigend   = box.bigEnd();
@@ -160,7 +171,7 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
             ncf.var(typ_names[mfi.index()]).put(itype.begin()   , {index, 0}, {1, AMREX_SPACEDIM});
 
             for (int k(0); k < ncomp_mf; ++k) {
-                const auto *dataPtr = fab.get(mfi).dataPtr(k);
+                const auto *dataPtr = fab_io.get(mfi).dataPtr(k);
                 ncf.var(plt_var_names[mfi.index()*ncomp_mf+k]).put(dataPtr, {0}, {static_cast<long unsigned int>(num_pts_mf)});
              }
         }
@@ -168,3 +179,144 @@ ERF::WriteNCMultiFab (const FabArray<FArrayBox> &fab,
       }
    }
 }
+
+/**
+ * Writes a MultiFab into one NetCDF file, with every rank writing its own boxes
+ * collectively through MPI-IO.  The boxes are stored as SmallEnd, BigEnd and
+ * BoxType(num_boxes, num_dimension), and the data of all boxes, in the order of
+ * the BoxArray, as data(num_components, num_points).
+ *
+ * @param fab MultiFab to write; it must not have ghost cells
+ * @param name File name without the "_Data.nc" suffix
+ */
+void
+ERF::WriteNCMultiFabPar (const FabArray<FArrayBox> &fab,
+                         const std::string& name)
+{
+    AMREX_ALWAYS_ASSERT(fab.nGrow() == 0);
+
+    const BoxArray& ba = fab.boxArray();
+    const int nbox  = ba.size();
+    const int ncomp = fab.nComp();
+
+    Vector<long unsigned int> box_offset(nbox, 0);
+    long unsigned int num_pts = 0;
+    for (int nb = 0; nb < nbox; ++nb) {
+        box_offset[nb] = num_pts;
+        num_pts += ba[nb].numPts();
+    }
+
+    const MPI_Comm comm = ParallelDescriptor::Communicator();
+    auto ncf = ncutils::NCFile::create_par(name+"_Data.nc", NC_CLOBBER | NC_NETCDF4 | NC_MPIIO,
+                                           comm, MPI_INFO_NULL);
+
+    const std::string ndim_name  = "num_dimension";
+    const std::string nb_name    = "num_boxes";
+    const std::string np_name    = "num_points";
+    const std::string ncomp_name = "num_components";
+
+    ncf.enter_def_mode();
+    ncf.put_attr("title", "ERF NetCDF MultiFab Data");
+    ncf.def_dim(ndim_name,  AMREX_SPACEDIM);
+    ncf.def_dim(nb_name,    nbox);
+    ncf.def_dim(np_name,    num_pts);
+    ncf.def_dim(ncomp_name, ncomp);
+    ncf.def_var("SmallEnd", ncutils::NCDType::Int,  {nb_name, ndim_name});
+    ncf.def_var("BigEnd"  , ncutils::NCDType::Int,  {nb_name, ndim_name});
+    ncf.def_var("BoxType" , ncutils::NCDType::Int,  {nb_name, ndim_name});
+    ncf.def_var("data"    , ncutils::NCDType::Real, {ncomp_name, np_name});
+    ncf.exit_def_mode();
+
+    // The box table is small and written by one rank
+    if (ParallelDescriptor::IOProcessor()) {
+        Vector<int> lo, hi, typ;
+        for (int nb = 0; nb < nbox; ++nb) {
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                lo.push_back(ba[nb].smallEnd(d));
+                hi.push_back(ba[nb].bigEnd(d));
+                typ.push_back(ba[nb].type(d));
+            }
+        }
+        const auto nbb = static_cast<long unsigned int>(nbox);
+        auto var_lo  = ncf.var("SmallEnd");
+        auto var_hi  = ncf.var("BigEnd");
+        auto var_typ = ncf.var("BoxType");
+        var_lo .par_access(NC_INDEPENDENT);
+        var_hi .par_access(NC_INDEPENDENT);
+        var_typ.par_access(NC_INDEPENDENT);
+        var_lo .put(lo.data() , {0, 0}, {nbb, AMREX_SPACEDIM});
+        var_hi .put(hi.data() , {0, 0}, {nbb, AMREX_SPACEDIM});
+        var_typ.put(typ.data(), {0, 0}, {nbb, AMREX_SPACEDIM});
+    }
+
+    std::vector<const Real*> dptr;
+    std::vector<std::vector<size_t>> start, count;
+    for (MFIter mfi(fab); mfi.isValid(); ++mfi) {
+        const auto npts = static_cast<size_t>(fab[mfi].box().numPts());
+        for (int k = 0; k < ncomp; ++k) {
+            dptr.push_back(fab[mfi].dataPtr(k));
+            start.push_back({static_cast<size_t>(k), box_offset[mfi.index()]});
+            count.push_back({1, npts});
+        }
+    }
+    ncf.var("data").put_all(dptr, start, count, comm);
+
+    ncf.close();
+}
+
+/**
+ * Reads a MultiFab written by WriteNCMultiFabPar, with every rank reading its
+ * own boxes collectively through MPI-IO.
+ *
+ * @param mf MultiFab to fill; it must have the boxes of the file and no ghost cells
+ * @param name File name without the "_Data.nc" suffix
+ */
+void
+ERF::ReadNCMultiFabPar (FabArray<FArrayBox> &mf,
+                        const std::string& name)
+{
+    AMREX_ALWAYS_ASSERT(mf.nGrow() == 0);
+
+    const BoxArray& ba = mf.boxArray();
+    const int nbox  = ba.size();
+    const int ncomp = mf.nComp();
+
+    const MPI_Comm comm = ParallelDescriptor::Communicator();
+    auto ncf = ncutils::NCFile::open_par(name+"_Data.nc", NC_NOWRITE, comm, MPI_INFO_NULL);
+
+    if (static_cast<int>(ncf.dim("num_boxes").len())      != nbox ||
+        static_cast<int>(ncf.dim("num_components").len()) != ncomp) {
+        Abort("ReadNCMultiFabPar: " + name + "_Data.nc does not match the MultiFab");
+    }
+
+    Vector<int> lo(nbox*AMREX_SPACEDIM);
+    auto var_lo = ncf.var("SmallEnd");
+    var_lo.par_access(NC_INDEPENDENT);
+    var_lo.get(lo.data(), {0, 0}, {static_cast<long unsigned int>(nbox), AMREX_SPACEDIM});
+
+    Vector<long unsigned int> box_offset(nbox, 0);
+    long unsigned int num_pts = 0;
+    for (int nb = 0; nb < nbox; ++nb) {
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            if (lo[nb*AMREX_SPACEDIM+d] != ba[nb].smallEnd(d)) {
+                Abort("ReadNCMultiFabPar: the boxes of " + name + "_Data.nc do not match the MultiFab");
+            }
+        }
+        box_offset[nb] = num_pts;
+        num_pts += ba[nb].numPts();
+    }
+
+    std::vector<Real*> dptr;
+    std::vector<std::vector<size_t>> start, count;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const auto npts = static_cast<size_t>(mf[mfi].box().numPts());
+        for (int k = 0; k < ncomp; ++k) {
+            dptr.push_back(mf[mfi].dataPtr(k));
+            start.push_back({static_cast<size_t>(k), box_offset[mfi.index()]});
+            count.push_back({1, npts});
+        }
+    }
+    ncf.var("data").get_all(dptr, start, count, comm);
+
+    ncf.close();
+}
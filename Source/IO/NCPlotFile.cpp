@@ -24,16 +24,9 @@ ERF::writeNCPlotFile (int lev, int which_subdomain, const std::string& dir,
                       const Vector<std::string> &plot_var_names,
                       const Vector<int>& /*level_steps*/, const Real time) const
 {
-     // get the processor number
-     int iproc = amrex::ParallelContext::MyProcAll();
-     int nproc = amrex::ParallelDescriptor::NProcs();
-
      // total number of cells in this "domain" at this level
      std::vector<int> n_cells;
 
-     // number of points in each block at this level
-     std::vector<int> offset;
-
      // set the full IO path for NetCDF output
      std::string FullPath = dir;
      if (lev == 0) {
@@ -51,15 +44,6 @@ ERF::writeNCPlotFile (int lev, int which_subdomain, const std::string& dir,
                                             amrex::ParallelContext::CommunicatorSub(), MPI_INFO_NULL);
 
      int nblocks = grids[lev].size();
-     auto dm = plotMF[lev]->DistributionMap();
-     offset.reserve(nproc);
-     for(auto n = 0; n < nproc; n++) {
-         offset[n] = 0;
-     }
-     for(auto ib=0; ib<nblocks; ib++) {
-        auto npts_per_block = grids[lev][ib].length(0)*grids[lev][ib].length(1)*grids[lev][ib].length(2);
-        offset[dm[ib]] += npts_per_block;
-     }
 
      // We only do single-level writes when using NetCDF format
      int flev = lev;
@@ -187,63 +171,77 @@ ERF::writeNCPlotFile (int lev, int which_subdomain, const std::string& dir,
       ncf.put_attr("DefaultGeometry", std::vector<int>{amrex::DefaultGeometry().Coord()});
     }
 
-    std::vector<Real> x_grid;
-    std::vector<Real> y_grid;
-    std::vector<Real> z_grid;
-    long unsigned goffset = 0;
-    long unsigned glen    = 0;
-    for (int i = 0; i < grids[lev].size(); ++i) {
-        auto box = grids[lev][i];
+    // Offset of each block in the file, in the order of the BoxArray
+    std::vector<long unsigned> box_offset(nblocks, 0);
+    {
+        long unsigned goffset = 0;
+        for (int i = 0; i < nblocks; ++i) {
+            box_offset[i] = goffset;
+            if (subdomain.contains(grids[lev][i])) {
+                goffset += grids[lev][i].numPts();
+            }
+        }
+    }
+
+    // Every rank writes the coordinates and data of its own blocks, in the
+    // order of the data in a fab (x fastest)
+    const int ncomp = plotMF[lev]->nComp();
+
+    std::vector<std::vector<Real>> x_grid, y_grid, z_grid;
+    std::vector<std::vector<size_t>> start, count;
+    std::vector<const Real*> xptr, yptr, zptr;
+    std::vector<std::vector<const Real*>> dptr(ncomp);
+
+    for (MFIter fai(*plotMF[lev]); fai.isValid(); ++fai) {
+        auto box = fai.validbox();
         if (subdomain.contains(box)) {
-            RealBox gridloc = RealBox(grids[lev][i], geom[lev].CellSize(), geom[lev].ProbLo());
-
-            x_grid.clear(); y_grid.clear(); z_grid.clear();
-            for (auto k1 = 0; k1 < grids[lev][i].length(0); ++k1) {
-              for (auto k2 = 0; k2 < grids[lev][i].length(1); ++k2) {
-                 for (auto k3 = 0; k3 < grids[lev][i].length(2); ++k3) {
-                    x_grid.push_back(gridloc.lo(0)+geom[lev].CellSize(0)*static_cast<Real>(k1));
-                    y_grid.push_back(gridloc.lo(1)+geom[lev].CellSize(1)*static_cast<Real>(k2));
-                    z_grid.push_back(gridloc.lo(2)+geom[lev].CellSize(2)*static_cast<Real>(k3));
+            RealBox gridloc = RealBox(box, geom[lev].CellSize(), geom[lev].ProbLo());
+
+            x_grid.emplace_back(); y_grid.emplace_back(); z_grid.emplace_back();
+            for (auto k3 = 0; k3 < box.length(2); ++k3) {
+              for (auto k2 = 0; k2 < box.length(1); ++k2) {
+                 for (auto k1 = 0; k1 < box.length(0); ++k1) {
+                    x_grid.back().push_back(gridloc.lo(0)+geom[lev].CellSize(0)*static_cast<Real>(k1));
+                    y_grid.back().push_back(gridloc.lo(1)+geom[lev].CellSize(1)*static_cast<Real>(k2));
+                    z_grid.back().push_back(gridloc.lo(2)+geom[lev].CellSize(2)*static_cast<Real>(k3));
                  }
               }
             }
 
-            goffset += glen;
-            glen = grids[lev][i].length(0)*grids[lev][i].length(1)*grids[lev][i].length(2);
-
-            auto nc_x_grid = ncf.var("x_grid");
-            auto nc_y_grid = ncf.var("y_grid");
-            auto nc_z_grid = ncf.var("z_grid");
-
-            nc_x_grid.par_access(NC_INDEPENDENT);
-            nc_y_grid.par_access(NC_INDEPENDENT);
-            nc_z_grid.par_access(NC_INDEPENDENT);
-
-            nc_x_grid.put(x_grid.data(), {goffset}, {glen});
-            nc_y_grid.put(y_grid.data(), {goffset}, {glen});
-            nc_z_grid.put(z_grid.data(), {goffset}, {glen});
-       }
-   }
-
-   size_t nfai = 0;
-   long unsigned numpts = 0;
-   const int ncomp = plotMF[lev]->nComp();
-
-   for (MFIter fai(*plotMF[lev]); fai.isValid(); ++fai) {
-       auto box = fai.validbox();
-       if (subdomain.contains(box)) {
-           numpts = box.numPts();
-           long unsigned diff = nfai*numpts;
-           for(auto ip = 1; ip <= iproc; ++ip) diff += offset[ip-1];
-
-           for (int k(0); k < ncomp; ++k) {
-              const auto *data = plotMF[lev]->get(fai).dataPtr(k);
-              auto nc_plot_var = ncf.var(plot_var_names[k]);
-              nc_plot_var.par_access(NC_INDEPENDENT);
-              nc_plot_var.put(data, {diff}, {numpts});
-           }
-           nfai++;
-       }
-   }
+            start.push_back({box_offset[fai.index()]});
+            count.push_back({static_cast<size_t>(box.numPts())});
+            for (int k(0); k < ncomp; ++k) {
+                dptr[k].push_back(plotMF[lev]->get(fai).dataPtr(k));
+            }
+        }
+    }
+    for (size_t n = 0; n < x_grid.size(); ++n) {
+        xptr.push_back(x_grid[n].data());
+        yptr.push_back(y_grid[n].data());
+        zptr.push_back(z_grid[n].data());
+    }
+
+    const MPI_Comm comm = amrex::ParallelContext::CommunicatorSub();
+
+    auto put_blocks = [&] (const ncutils::NCVar& var, const std::vector<const Real*>& ptr)
+    {
+        if (nc_parallel_io) {
+            var.put_all(ptr, start, count, comm);
+        } else {
+            var.par_access(NC_INDEPENDENT);
+            for (size_t n = 0; n < ptr.size(); ++n) {
+                var.put(ptr[n], start[n], count[n]);
+            }
+        }
+    };
+
+    put_blocks(ncf.var("x_grid"), xptr);
+    put_blocks(ncf.var("y_grid"), yptr);
+    put_blocks(ncf.var("z_grid"), zptr);
+
+    for (int k(0); k < ncomp; ++k) {
+        put_blocks(ncf.var(plot_var_names[k]), dptr[k]);
+    }
+
    ncf.close();
 }
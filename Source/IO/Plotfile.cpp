@@ -2,6 +2,7 @@
 #include <ERF.H>
 #include "AMReX_Interp_3D_C.H"
 #include "AMReX_PlotFileUtil.H"
+#include "ERF_CompressedPlotfile.H"
 #include "TerrainMetrics.H"
 #include "ERF_Constants.H"
 
@@ -1283,14 +1284,20 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
 
     if (finest_level == 0)
     {
-        if (plotfile_type == "amrex") {
-            Print() << "Writing native plotfile " << plotfilename << "\n";
+        if (plotfile_type == "amrex" || plotfile_type == "compressed") {
+            Print() << "Writing " << ((plotfile_type == "amrex") ? "native" : "compressed")
+                    << " plotfile " << plotfilename << "\n";
             if (solverChoice.use_terrain) {
                 WriteMultiLevelPlotfileWithTerrain(plotfilename, finest_level+1,
                                                    GetVecOfConstPtrs(mf),
                                                    GetVecOfConstPtrs(mf_nd),
                                                    varnames,
                                                    t_new[0], istep);
+            } else if (plotfile_type == "compressed") {
+                WriteMultiLevelPlotfileCompressed(plotfilename, finest_level+1,
+                                                  GetVecOfConstPtrs(mf),
+                                                  varnames,
+                                                  Geom(), t_new[0], istep, refRatio());
             } else {
                 WriteMultiLevelPlotfile(plotfilename, finest_level+1,
                                         GetVecOfConstPtrs(mf),
@@ -1323,7 +1330,7 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
 
     } else { // multilevel
 
-        if (plotfile_type == "amrex") {
+        if (plotfile_type == "amrex" || plotfile_type == "compressed") {
 
             if (ref_ratio[0][2] == 1) {
 
@@ -1381,6 +1388,10 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
                                                       GetVecOfConstPtrs(mf_nd),
                                                       varnames,
                                                       t_new[0], istep);
+               } else if (plotfile_type == "compressed") {
+                   WriteMultiLevelPlotfileCompressed(plotfilename, finest_level+1,
+                                                     GetVecOfConstPtrs(mf2), varnames,
+                                                     g2, t_new[0], istep, rr);
                } else {
                    WriteMultiLevelPlotfile(plotfilename, finest_level+1,
                                            GetVecOfConstPtrs(mf2), varnames,
@@ -1394,6 +1405,10 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
                                                        GetVecOfConstPtrs(mf_nd),
                                                        varnames,
                                                        t_new[0], istep);
+                } else if (plotfile_type == "compressed") {
+                    WriteMultiLevelPlotfileCompressed(plotfilename, finest_level+1,
+                                                      GetVecOfConstPtrs(mf), varnames,
+                                                      geom, t_new[0], istep, ref_ratio);
                 } else {
                     WriteMultiLevelPlotfile(plotfilename, finest_level+1,
                                             GetVecOfConstPtrs(mf), varnames,
@@ -1478,7 +1493,14 @@ ERF::WriteMultiLevelPlotfileWithTerrain (const std::string& plotfilename, int nl
     std::string mf_nodal_prefix = "Nu_nd";
     for (int level = 0; level <= finest_level; ++level)
     {
-        if (AsyncOut::UseAsyncOut()) {
+        if (plotfile_type == "compressed") {
+            WriteCompressedMultiFab(*mf[level],
+                                    MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix),
+                                    PlotQuanta(varnames), verbose);
+            WriteCompressedMultiFab(*mf_nd[level],
+                                    MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mf_nodal_prefix),
+                                    Vector<Real>(mf_nd[level]->nComp(), 0.0), verbose);
+        } else if (AsyncOut::UseAsyncOut()) {
             VisMF::AsyncWrite(*mf[level],
                               MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix),
                               true);
@@ -1504,6 +1526,70 @@ ERF::WriteMultiLevelPlotfileWithTerrain (const std::string& plotfilename, int nl
     }
 }
 
+/**
+ * Writes a plotfile with the Header of a native plotfile but with the MultiFabs
+ * of the levels compressed, each rank writing the FABs it owns.  The variables
+ * in erf.plot_quantize_vars are kept to the precision in erf.plot_quantize_quanta
+ * and the others are stored lossless.
+ */
+void
+ERF::WriteMultiLevelPlotfileCompressed (const std::string& plotfilename, int nlevels,
+                                        const Vector<const MultiFab*>& a_mf,
+                                        const Vector<std::string>& varnames,
+                                        const Vector<Geometry>& a_geom,
+                                        Real time,
+                                        const Vector<int>& level_steps,
+                                        const Vector<IntVect>& rr) const
+{
+    BL_PROFILE("WriteMultiLevelPlotfileCompressed()");
+
+    AMREX_ALWAYS_ASSERT(nlevels <= a_mf.size());
+    AMREX_ALWAYS_ASSERT(a_mf[0]->nComp() == varnames.size());
+
+    const std::string levelPrefix = "Level_";
+    const std::string mfPrefix    = "Cell";
+
+    bool callBarrier(true);
+    PreBuildDirectorHierarchy(plotfilename, levelPrefix, nlevels, callBarrier);
+
+    if (ParallelDescriptor::IOProcessor()) {
+        Vector<BoxArray> boxArrays(nlevels);
+        for (int level = 0; level < nlevels; ++level) {
+            boxArrays[level] = a_mf[level]->boxArray();
+        }
+
+        std::string HeaderFileName(plotfilename + "/Header");
+        std::ofstream HeaderFile(HeaderFileName.c_str(), std::ofstream::out   |
+                                                         std::ofstream::trunc |
+                                                         std::ofstream::binary);
+        if( ! HeaderFile.good()) FileOpenFailed(HeaderFileName);
+        WriteGenericPlotfileHeader(HeaderFile, nlevels, boxArrays, varnames,
+                                   a_geom, time, level_steps, rr,
+                                   "HyperCLaw-V1.1", levelPrefix, mfPrefix);
+    }
+
+    const Vector<Real> quanta = PlotQuanta(varnames);
+    for (int level = 0; level < nlevels; ++level) {
+        WriteCompressedMultiFab(*a_mf[level],
+                                MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix),
+                                quanta, verbose);
+    }
+}
+
+Vector<Real>
+ERF::PlotQuanta (const Vector<std::string>& varnames) const
+{
+    Vector<Real> quanta(varnames.size(), 0.0);
+    for (int i = 0; i < plot_quantize_vars.size(); ++i) {
+        for (int n = 0; n < varnames.size(); ++n) {
+            if (varnames[n] == plot_quantize_vars[i]) {
+                quanta[n] = plot_quantize_quanta[i];
+            }
+        }
+    }
+    return quanta;
+}
+
 void
 ERF::WriteGenericPlotfileHeaderWithTerrain (std::ostream &HeaderFile,
                                             int nlevels,
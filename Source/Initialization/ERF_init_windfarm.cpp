@@ -28,7 +28,10 @@ ERF::init_windfarm (int lev)
                              true, false);
     }
 
-    windfarm->fill_Nturb_multifab(geom[lev], Nturb[lev]);
+    windfarm->fill_Nturb_multifab(lev, geom[lev], Nturb[lev]);
+
+    windfarm->set_turb_reductions(solverChoice.windfarm_disk_average,
+                                  !solverChoice.windfarm_power_log.empty());
 
     windfarm->write_turbine_locations_vtk();
 
@@ -38,7 +41,8 @@ ERF::init_windfarm (int lev)
 }
 
 void
-ERF::advance_windfarm (const Geometry& a_geom,
+ERF::advance_windfarm (int lev,
+                       const Geometry& a_geom,
                        const Real& dt_advance,
                        MultiFab& cons_in,
                        MultiFab& U_old,
@@ -47,6 +51,6 @@ ERF::advance_windfarm (const Geometry& a_geom,
                        MultiFab& mf_vars_windfarm,
                        const MultiFab& mf_Nturb)
 {
-        windfarm->advance(a_geom, dt_advance, cons_in, mf_vars_windfarm,
+        windfarm->advance(lev, a_geom, dt_advance, cons_in, mf_vars_windfarm,
                           U_old, V_old, W_old, mf_Nturb);
 }
@@ -43,6 +43,8 @@ void Kessler::Init (const MultiFab& cons_in,
         mic_fab_vars[ivar]->setVal(0.);
     }
 
+    m_fz.define(convert(cons_in.boxArray(), IntVect(0,0,1)), cons_in.DistributionMap(), 1, 0); // No ghost cells
+
     // Set class data members
     for ( MFIter mfi(cons_in, TileNoZ()); mfi.isValid(); ++mfi) {
         const auto& box3d = mfi.tilebox();
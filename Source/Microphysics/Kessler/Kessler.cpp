@@ -2,6 +2,7 @@
 #include <TileNoZ.H>
 #include "Kessler.H"
 #include "DataStruct.H"
+#include "Sedimentation.H"
 
 using namespace amrex;
 
@@ -17,56 +18,101 @@ void Kessler::AdvanceKessler (const SolverChoice &solverChoice)
         int k_lo = domain.smallEnd(2);
         int k_hi = domain.bigEnd(2);
 
-        MultiFab fz;
-        auto ba    = tabs->boxArray();
-        auto dm    = tabs->DistributionMap();
-        fz.define(convert(ba, IntVect(0,0,1)), dm, 1, 0); // No ghost cells
+        MultiFab& fz = m_fz;
 
         Real dtn = dt;
 
-        for ( MFIter mfi(fz, TilingIfNotGPU()); mfi.isValid(); ++mfi ){
-            auto rho_array = mic_fab_vars[MicVar_Kess::rho]->array(mfi);
-            auto qp_array  = mic_fab_vars[MicVar_Kess::qp]->array(mfi);
-            auto rain_accum_array = mic_fab_vars[MicVar_Kess::rain_accum]->array(mfi);
-
-            auto fz_array  = fz.array(mfi);
-            const Box& tbz = mfi.tilebox();
-
-            ParallelFor(tbz, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-            {
-                Real rho_avg, qp_avg;
-
-                if (k==k_lo) {
-                    rho_avg = rho_array(i,j,k);
-                    qp_avg  = qp_array(i,j,k);
-                } else if (k==k_hi+1) {
-                    rho_avg = rho_array(i,j,k-1);
-                    qp_avg  = qp_array(i,j,k-1);
-                } else {
-                    rho_avg = 0.5*(rho_array(i,j,k-1) + rho_array(i,j,k)); // Convert to g/cm^3
-                    qp_avg = 0.5*(qp_array(i,j,k-1)  + qp_array(i,j,k));
-                }
+        if (solverChoice.sediment_subcycle) {
+            // Sediment the rain first, subcycled in each column; the update below then sees no flux
+            fz.setVal(0.0);
+
+            // Sediment whole columns, gathered first if the grids are split in z
+            if (!m_sed_cols || !m_sed_cols->valid_for(tabs->boxArray())) {
+                m_sed_cols = std::make_unique<SedimentationColumns>(tabs->boxArray(), domain);
+            }
+            SedimentationColumns& cols = *m_sed_cols;
+            MultiFab* qp_c         = cols.gather(mic_fab_vars[MicVar_Kess::qp].get());
+            MultiFab* rain_accum_c = cols.gather(mic_fab_vars[MicVar_Kess::rain_accum].get());
+            const MultiFab* rho_c  = cols.gather_const(mic_fab_vars[MicVar_Kess::rho].get());
+            const MultiFab* dJ_c   = cols.gather_const(m_detJ_cc);
+
+            for ( MFIter mfi(*qp_c, TileNoZ()); mfi.isValid(); ++mfi ){
+                auto qp_array  = qp_c->array(mfi);
+                auto rain_accum_array = rain_accum_c->array(mfi);
+
+                const auto rho_array = rho_c->const_array(mfi);
+                const auto dJ_array  = (dJ_c) ? dJ_c->const_array(mfi) : Array4<const Real>{};
+
+                const auto& box3d = mfi.tilebox();
+
+                // Upwind flux out of the bottom of cell k, and the terminal velocity there
+                auto flux = [=] AMREX_GPU_DEVICE (int i, int j, int k, Real& V) noexcept -> Real
+                {
+                    Real rho_cc = rho_array(i,j,k);
+                    Real qp_cc  = std::max(0.0, qp_array(i,j,k));
+                    V = 36.34*std::pow(rho_cc*0.001*qp_cc, 0.1346)*std::pow(rho_cc/1.16, -0.5); // in m/s
+                    return rho_cc*V*qp_cc;
+                };
+
+                auto update = [=] AMREX_GPU_DEVICE (int i, int j, int k, Real dq) noexcept
+                {
+                    qp_array(i,j,k) = std::max(0.0, qp_array(i,j,k) + dq);
+                };
+
+                auto surface = [=] AMREX_GPU_DEVICE (int i, int j, Real dm) noexcept
+                {
+                    rain_accum_array(i,j,k_lo) += dm/1000.0*1000.0; // Divide by rho_water and convert to mm
+                };
+
+                sediment_columns(box3d, k_lo, k_hi, dtn, 1.0/dz, solverChoice.sediment_cfl,
+                                 rho_array, dJ_array, flux, update, surface);
+            }
+            cols.scatter();
+        } else {
+            for ( MFIter mfi(fz, TilingIfNotGPU()); mfi.isValid(); ++mfi ){
+                auto rho_array = mic_fab_vars[MicVar_Kess::rho]->array(mfi);
+                auto qp_array  = mic_fab_vars[MicVar_Kess::qp]->array(mfi);
+                auto rain_accum_array = mic_fab_vars[MicVar_Kess::rain_accum]->array(mfi);
+
+                auto fz_array  = fz.array(mfi);
+                const Box& tbz = mfi.tilebox();
+
+                ParallelFor(tbz, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+                {
+                    Real rho_avg, qp_avg;
+
+                    if (k==k_lo) {
+                        rho_avg = rho_array(i,j,k);
+                        qp_avg  = qp_array(i,j,k);
+                    } else if (k==k_hi+1) {
+                        rho_avg = rho_array(i,j,k-1);
+                        qp_avg  = qp_array(i,j,k-1);
+                    } else {
+                        rho_avg = 0.5*(rho_array(i,j,k-1) + rho_array(i,j,k)); // Convert to g/cm^3
+                        qp_avg = 0.5*(qp_array(i,j,k-1)  + qp_array(i,j,k));
+                    }
 
-                qp_avg = std::max(0.0, qp_avg);
+                    qp_avg = std::max(0.0, qp_avg);
 
-                Real V_terminal = 36.34*std::pow(rho_avg*0.001*qp_avg, 0.1346)*std::pow(rho_avg/1.16, -0.5); // in m/s
+                    Real V_terminal = 36.34*std::pow(rho_avg*0.001*qp_avg, 0.1346)*std::pow(rho_avg/1.16, -0.5); // in m/s
 
-                // NOTE: Fz is the sedimentation flux from the advective operator.
-                //       In the terrain-following coordinate system, the z-deriv in
-                //       the divergence uses the normal velocity (Omega). However,
-                //       there are no u/v components to the sedimentation velocity.
-                //       Therefore, we simply end up with a division by detJ when
-                //       evaluating the source term: dJinv * (flux_hi - flux_lo) * dzinv.
-                fz_array(i,j,k) = rho_avg*V_terminal*qp_avg;
+                    // NOTE: Fz is the sedimentation flux from the advective operator.
+                    //       In the terrain-following coordinate system, the z-deriv in
+                    //       the divergence uses the normal velocity (Omega). However,
+                    //       there are no u/v components to the sedimentation velocity.
+                    //       Therefore, we simply end up with a division by detJ when
+                    //       evaluating the source term: dJinv * (flux_hi - flux_lo) * dzinv.
+                    fz_array(i,j,k) = rho_avg*V_terminal*qp_avg;
 
-                if(k==k_lo){
-                    rain_accum_array(i,j,k) = rain_accum_array(i,j,k) + rho_avg*qp_avg*V_terminal*dtn/1000.0*1000.0; // Divide by rho_water and convert to mm
-                }
+                    if(k==k_lo){
+                        rain_accum_array(i,j,k) = rain_accum_array(i,j,k) + rho_avg*qp_avg*V_terminal*dtn/1000.0*1000.0; // Divide by rho_water and convert to mm
+                    }
 
-                /*if(k==0){
-                  fz_array(i,j,k) = 0;
-                  }*/
-            });
+                    /*if(k==0){
+                      fz_array(i,j,k) = 0;
+                      }*/
+                });
+            }
         }
 
         for ( MFIter mfi(*tabs,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
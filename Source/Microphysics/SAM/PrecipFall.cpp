@@ -1,6 +1,7 @@
 #include "ERF_Constants.H"
 #include "SAM.H"
 #include "TileNoZ.H"
+#include "Sedimentation.H"
 
 using namespace amrex;
 
@@ -45,18 +46,111 @@ SAM::PrecipFall (const SolverChoice& sc)
     auto snow_accum = mic_fab_vars[MicVar::snow_accum];
     auto graup_accum = mic_fab_vars[MicVar::graup_accum];
 
-    auto ba    = tabs->boxArray();
-    auto dm    = tabs->DistributionMap();
-    auto ngrow = tabs->nGrowVect();
-
-    MultiFab fz;
-    fz.define(convert(ba, IntVect(0,0,1)), dm, 1, ngrow);
-
     int SAM_moisture_type = 1;
     if (sc.moisture_type == MoistureType::SAM_NoIce) {
         SAM_moisture_type = 2;
     }
 
+    if (sc.sediment_subcycle) {
+        // Sediment whole columns, gathered first if the grids are split in z
+        if (!m_sed_cols || !m_sed_cols->valid_for(qp->boxArray())) {
+            m_sed_cols = std::make_unique<SedimentationColumns>(qp->boxArray(), domain);
+        }
+        SedimentationColumns& cols = *m_sed_cols;
+        MultiFab* qpr_c         = cols.gather(qpr.get());
+        MultiFab* qps_c         = cols.gather(qps.get());
+        MultiFab* qpg_c         = cols.gather(qpg.get());
+        MultiFab* qp_c          = cols.gather(qp.get());
+        MultiFab* rain_accum_c  = cols.gather(rain_accum.get());
+        MultiFab* snow_accum_c  = cols.gather(snow_accum.get());
+        MultiFab* graup_accum_c = cols.gather(graup_accum.get());
+        const MultiFab* tabs_c  = cols.gather_const(tabs.get());
+        const MultiFab* rho_c   = cols.gather_const(rho.get());
+        const MultiFab* dJ_c    = cols.gather_const(m_detJ_cc);
+
+        for (MFIter mfi(*qp_c, TileNoZ()); mfi.isValid(); ++mfi) {
+            auto qpr_array    = qpr_c->array(mfi);
+            auto qps_array    = qps_c->array(mfi);
+            auto qpg_array    = qpg_c->array(mfi);
+            auto qp_array     = qp_c->array(mfi);
+            auto tabs_array   = tabs_c->const_array(mfi);
+            auto rain_accum_array  = rain_accum_c->array(mfi);
+            auto snow_accum_array  = snow_accum_c->array(mfi);
+            auto graup_accum_array = graup_accum_c->array(mfi);
+
+            const auto rho_array = rho_c->const_array(mfi);
+            const auto dJ_array  = (dJ_c) ? dJ_c->const_array(mfi) : Array4<const Real>{};
+
+            const auto& box3d = mfi.tilebox();
+
+            // Upwind flux out of the bottom of cell k, and the mean fall speed there
+            auto flux = [=] AMREX_GPU_DEVICE (int i, int j, int k, Real& V) noexcept -> Real
+            {
+                Real qp_cc = qp_array(i,j,k);
+                V = 0.0;
+                if (qp_cc <= qp_threshold) return 0.0;
+
+                Real rho_cc = rho_array(i,j,k);
+                Real omp, omg;
+                if (SAM_moisture_type == 2) {
+                    omp = 1.0;
+                    omg = 0.0;
+                } else {
+                    omp = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tprmin)*a_pr));
+                    omg = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tgrmin)*a_gr));
+                }
+                Real qrr = omp*qp_cc;
+                Real qss = (1.0-omp)*(1.0-omg)*qp_cc;
+                Real qgg = (1.0-omp)*(omg)*qp_cc;
+                Real Pprecip = omp*vrain*std::pow(rho_cc*qrr,1.0+crain)
+                             + (1.0-omp)*( (1.0-omg)*vsnow*std::pow(rho_cc*qss,1.0+csnow)
+                                         +      omg *vgrau*std::pow(rho_cc*qgg,1.0+cgrau) );
+                Pprecip *= std::sqrt(rho_0/rho_cc);
+                V = Pprecip / (rho_cc*qp_cc);
+                return Pprecip;
+            };
+
+            auto update = [=] AMREX_GPU_DEVICE (int i, int j, int k, Real dqp) noexcept
+            {
+                Real omp, omg;
+                if (SAM_moisture_type == 2) {
+                    omp = 1.0;
+                    omg = 0.0;
+                } else {
+                    omp = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tprmin)*a_pr));
+                    omg = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tgrmin)*a_gr));
+                }
+                qpr_array(i,j,k) = std::max(0.0, qpr_array(i,j,k) + dqp*omp);
+                qps_array(i,j,k) = std::max(0.0, qps_array(i,j,k) + dqp*(1.0-omp)*(1.0-omg));
+                qpg_array(i,j,k) = std::max(0.0, qpg_array(i,j,k) + dqp*(1.0-omp)*omg);
+                 qp_array(i,j,k) = qpr_array(i,j,k) + qps_array(i,j,k) + qpg_array(i,j,k);
+            };
+
+            // Divide by the density of each hydrometeor and convert to mm
+            auto surface = [=] AMREX_GPU_DEVICE (int i, int j, Real dm) noexcept
+            {
+                Real omp, omg;
+                if (SAM_moisture_type == 2) {
+                    omp = 1.0;
+                    omg = 0.0;
+                } else {
+                    omp = std::max(0.0,std::min(1.0,(tabs_array(i,j,k_lo)-tprmin)*a_pr));
+                    omg = std::max(0.0,std::min(1.0,(tabs_array(i,j,k_lo)-tgrmin)*a_gr));
+                }
+                rain_accum_array (i,j,k_lo) += omp*dm/rhor*1000.0;
+                snow_accum_array (i,j,k_lo) += (1.0-omp)*(1.0-omg)*dm/rhos*1000.0;
+                graup_accum_array(i,j,k_lo) += (1.0-omp)*omg*dm/rhog*1000.0;
+            };
+
+            sediment_columns(box3d, k_lo, k_hi, dtn, 1.0/dz, sc.sediment_cfl,
+                             rho_array, dJ_array, flux, update, surface);
+        } // mfi
+        cols.scatter();
+        return;
+    }
+
+    MultiFab& fz = m_fz;
+
     //  Add sedimentation of precipitation field to the vert. vel.
     for (MFIter mfi(fz, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
         auto qp_array   = qp->array(mfi);
@@ -26,6 +26,7 @@ using namespace amrex;
  * @param[in]  geom   Container for geometric information
  * @param[in]  solverChoice  Container for solver parameters
  * @param[in]  r0     Reference (hydrostatically stratified) density
+ * @param[in]  region part of each tile on which to compute the buoyancy
  */
 
 void make_buoyancy (Vector<MultiFab>& S_data,
@@ -34,10 +35,14 @@ void make_buoyancy (Vector<MultiFab>& S_data,
                     const amrex::Geometry geom,
                     const SolverChoice& solverChoice,
                     const MultiFab* r0,
-                    const int& qstate_size)
+                    const int& qstate_size,
+                    TileRegion region)
 {
     BL_PROFILE("make_buoyancy()");
 
+    // Width of the shell of faces whose stencils may reach into the ghost cells
+    const int region_ng = S_data[IntVars::cons].nGrow();
+
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -solverChoice.gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
@@ -50,8 +55,8 @@ void make_buoyancy (Vector<MultiFab>& S_data,
     if (solverChoice.moisture_type == MoistureType::None) {
         if (solverChoice.buoyancy_type == 1) {
             for ( MFIter mfi(buoyancy,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            for (Box tbz : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
             {
-                Box tbz = mfi.tilebox();
 
                 // We don't compute a source term for z-momentum on the bottom or top domain boundary
                 if (tbz.smallEnd(2) == klo) tbz.growLo(2,-1);
@@ -96,8 +101,8 @@ void make_buoyancy (Vector<MultiFab>& S_data,
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
             for ( MFIter mfi(buoyancy,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            for (Box tbz : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
             {
-                Box tbz = mfi.tilebox();
 
                 // We don't compute a source term for z-momentum on the bottom or top boundary
                 if (tbz.smallEnd(2) == klo) tbz.growLo(2,-1);
@@ -142,8 +147,8 @@ void make_buoyancy (Vector<MultiFab>& S_data,
         if (solverChoice.buoyancy_type == 1) {
 
             for ( MFIter mfi(buoyancy,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            for (Box tbz : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
             {
-                Box tbz = mfi.tilebox();
 
                 // We don't compute a source term for z-momentum on the bottom or top domain boundary
                 if (tbz.smallEnd(2) == klo) tbz.growLo(2,-1);
@@ -216,8 +221,8 @@ void make_buoyancy (Vector<MultiFab>& S_data,
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
                 for ( MFIter mfi(buoyancy,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+                for (Box tbz : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
                 {
-                    Box tbz = mfi.tilebox();
 
                     // We don't compute a source term for z-momentum on the bottom or top domain boundary
                     if (tbz.smallEnd(2) == klo) tbz.growLo(2,-1);
@@ -287,8 +292,8 @@ void make_buoyancy (Vector<MultiFab>& S_data,
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
                 for ( MFIter mfi(buoyancy,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+                for (Box tbz : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
                 {
-                    Box tbz = mfi.tilebox();
 
                     // We don't compute a source term for z-momentum on the bottom or top domain boundary
                     if (tbz.smallEnd(2) == klo) tbz.growLo(2,-1);
@@ -35,6 +35,7 @@ using namespace amrex;
  * @param[in] dptr_wbar_sub  subsidence source term
  * @param[in] d_rayleigh_ptrs_at_lev  Vector of {strength of Rayleigh damping, reference value for xvel/yvel/zvel/theta} used to define Rayleigh damping
  * @param[in] n_qstate number of moisture components
+ * @param[in] region part of each tile on which to compute the sources
  */
 
 void make_mom_sources (int /*level*/,
@@ -57,7 +58,8 @@ void make_mom_sources (int /*level*/,
                        const Real* dptr_wbar_sub,
                        const Vector<Real*> d_rayleigh_ptrs_at_lev,
                        const Vector<Real*> d_sponge_ptrs_at_lev,
-                       int n_qstate)
+                       int n_qstate,
+                       TileRegion region)
 {
     BL_PROFILE_REGION("erf_make_mom_sources()");
 
@@ -65,9 +67,15 @@ void make_mom_sources (int /*level*/,
     const GpuArray<Real, AMREX_SPACEDIM> dxInv = geom.InvCellSizeArray();
 
     // Initialize sources to zero since we re-compute them ever RK stage
-    xmom_src.setVal(0.0);
-    ymom_src.setVal(0.0);
-    zmom_src.setVal(0.0);
+    //    (the shell is the second pass over sources zeroed in the first)
+    if (region != TileRegion::Shell) {
+        xmom_src.setVal(0.0);
+        ymom_src.setVal(0.0);
+        zmom_src.setVal(0.0);
+    }
+
+    // Width of the shell of cells whose stencils may reach into the ghost cells
+    const int region_ng = S_data[IntVars::cons].nGrow();
 
     // *****************************************************************************
     // Define source term for all three components of momenta from
@@ -185,16 +193,17 @@ void make_mom_sources (int /*level*/,
     // *****************************************************************************
     // Create the BUOYANCY forcing term in the z-direction
     // *****************************************************************************
-    make_buoyancy(S_data, S_prim, zmom_src, geom, solverChoice, r0, n_qstate);
+    make_buoyancy(S_data, S_prim, zmom_src, geom, solverChoice, r0, n_qstate, region);
 
     // *****************************************************************************
     // Add all the other forcings
     // *****************************************************************************
     for ( MFIter mfi(S_data[IntVars::cons]); mfi.isValid(); ++mfi)
+    for (const Box& bx : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
     {
-        Box tbx = mfi.nodaltilebox(0);
-        Box tby = mfi.nodaltilebox(1);
-        Box tbz = mfi.nodaltilebox(2);
+        Box tbx = RegionNodalBox(bx, mfi.tilebox(), mfi.nodaltilebox(0));
+        Box tby = RegionNodalBox(bx, mfi.tilebox(), mfi.nodaltilebox(1));
+        Box tbz = RegionNodalBox(bx, mfi.tilebox(), mfi.nodaltilebox(2));
         if (tbz.bigEnd(2) == domain.bigEnd(2)+1) tbz.growHi(2,-1);
 
         const Array4<const Real>& cell_data = S_data[IntVars::cons].array(mfi);
@@ -27,6 +27,7 @@ using namespace amrex;
  * @param[in] dptr_rhoqt_src  custom moisture source term
  * @param[in] dptr_wbar_sub  subsidence source term
  * @param[in] d_rayleigh_ptrs_at_lev  Vector of {strength of Rayleigh damping, reference value of theta} used to define Rayleigh damping
+ * @param[in] region part of each tile on which to compute the sources
  */
 
 void make_sources (int level,
@@ -45,14 +46,21 @@ void make_sources (int level,
                    const Real* dptr_rhoqt_src,
                    const Real* dptr_wbar_sub,
                    const Vector<Real*> d_rayleigh_ptrs_at_lev,
-                   TurbulentPerturbation& turbPert)
+                   TurbulentPerturbation& turbPert,
+                   TileRegion region)
 {
     BL_PROFILE_REGION("erf_make_sources()");
 
     // *****************************************************************************
     // Initialize source to zero since we re-compute it every RK stage
+    //    (the shell is the second pass over a source zeroed in the first)
     // *****************************************************************************
-    source.setVal(0.0);
+    if (region != TileRegion::Shell) {
+        source.setVal(0.0);
+    }
+
+    // Width of the shell of cells whose stencils may reach into the ghost cells
+    const int region_ng = S_data[IntVars::cons].nGrow();
 
     const bool l_use_ndiff      = solverChoice.use_NumDiff;
 
@@ -171,8 +179,8 @@ void make_sources (int level,
 #endif
     {
     for ( MFIter mfi(S_data[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
+    for (const Box& bx : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
     {
-        Box bx  = mfi.tilebox();
 
         const Array4<const Real> & cell_data  = S_data[IntVars::cons].array(mfi);
         const Array4<const Real> & cell_prim  = S_prim.array(mfi);
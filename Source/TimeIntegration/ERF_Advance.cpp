@@ -96,8 +96,11 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
 
 #if defined(ERF_USE_WINDFARM)
     if (solverChoice.windfarm_type != WindFarmType::None) {
-        advance_windfarm(Geom(lev), dt_lev, S_old,
+        advance_windfarm(lev, Geom(lev), dt_lev, S_old,
                          U_old, V_old, W_old, vars_windfarm[lev], Nturb[lev]);
+        if (lev == 0 && !solverChoice.windfarm_power_log.empty()) {
+            windfarm->write_turb_power(time, solverChoice.windfarm_power_log);
+        }
     }
 
 #endif
@@ -208,3 +208,55 @@ ERF::estTimeStep (int level, long& dt_fast_ratio) const
          }
      }
 }
+
+/**
+ * Function that computes the largest fast (acoustic) time step allowed by the
+ * horizontal sound-speed CFL condition, using the data at the current RK stage
+ * rather than the data at the start of the time step.  This is used to choose
+ * the number of fast steps in each RK stage when erf.adaptive_substeps is set.
+ *
+ * @param[in] level  level of refinement (coarsest level is 0)
+ * @param[in] S_data conserved variables and momenta at the current RK stage
+ */
+Real
+ERF::estFastTimeStep (int level, const Vector<MultiFab>& S_data) const
+{
+    BL_PROFILE("ERF::estFastTimeStep()");
+
+    auto const dxinv = geom[level].InvCellSizeArray();
+
+    MultiFab const& cons = S_data[IntVars::cons];
+    MultiFab const& xmom = S_data[IntVars::xmom];
+    MultiFab const& ymom = S_data[IntVars::ymom];
+
+    Real estdt_fast_inv = ReduceMax(cons, xmom, ymom, 0,
+       [=] AMREX_GPU_HOST_DEVICE (Box const& b,
+                                  Array4<Real const> const& s,
+                                  Array4<Real const> const& rho_u,
+                                  Array4<Real const> const& rho_v) -> Real
+       {
+           Real new_fast_dt = -1.e100;
+           amrex::Loop(b, [=,&new_fast_dt] (int i, int j, int k) noexcept
+           {
+               const Real rho      = s(i, j, k, Rho_comp);
+               const Real rhotheta = s(i, j, k, RhoTheta_comp);
+
+               // NOTE: as in estTimeStep we only use the partial pressure of the dry air
+               //       to compute the soundspeed
+               Real pressure = getPgivenRTh(rhotheta);
+               Real c = std::sqrt(Gamma * pressure / rho);
+
+               Real u = 0.5 * (rho_u(i,j,k) + rho_u(i+1,j,k)) / rho;
+               Real v = 0.5 * (rho_v(i,j,k) + rho_v(i,j+1,k)) / rho;
+
+               // The vertical acoustic terms are implicit so only the horizontal directions contribute
+               new_fast_dt = amrex::max(((amrex::Math::abs(u)+c)*dxinv[0]),
+                                        ((amrex::Math::abs(v)+c)*dxinv[1]), new_fast_dt);
+           });
+           return new_fast_dt;
+       });
+
+    ParallelDescriptor::ReduceRealMax(estdt_fast_inv);
+
+    return cfl / estdt_fast_inv;
+}
@@ -99,15 +99,26 @@ void ERF::advance_dycore(int level,
     const bool exp_most = (solverChoice.use_explicit_most);
     amrex::ignore_unused(use_most);
 
+    // Overlap the level-0 ghost cell exchange after each RK stage with the interior of the next
+    //    slow RHS? The interior/shell split needs each part of a tile to own its faces, so
+    //    terrain, open bcs, relaxation zones and flux registers keep the blocking exchange
+    bool l_async_fill = ( solverChoice.async_fill_boundary && (level == 0) && !l_use_terrain &&
+                          !solverChoice.incompressible[level] && !use_real_bcs &&
+                          !(solverChoice.coupling_type == CouplingType::TwoWay && finest_level > 0) );
+    for (int dir = 0; dir < 2; dir++) {
+        if (domain_bcs_type[BCVars::cons_bc].lo(dir) == ERFBCType::open ||
+            domain_bcs_type[BCVars::cons_bc].hi(dir) == ERFBCType::open) {
+            l_async_fill = false;
+        }
+    }
+
     const BoxArray& ba            = state_old[IntVars::cons].boxArray();
-    const BoxArray& ba_z          = zvel_old.boxArray();
     const DistributionMapping& dm = state_old[IntVars::cons].DistributionMap();
 
     int num_prim = state_old[IntVars::cons].nComp() - 1;
 
     MultiFab    S_prim  (ba  , dm, num_prim,          state_old[IntVars::cons].nGrowVect());
     MultiFab  pi_stage  (ba  , dm,        1,          state_old[IntVars::cons].nGrowVect());
-    MultiFab fast_coeffs(ba_z, dm,        5,          0);
     MultiFab* eddyDiffs = eddyDiffs_lev[level].get();
     MultiFab* SmnSmn    = SmnSmn_lev[level].get();
 
@@ -303,7 +314,35 @@ void ERF::advance_dycore(int level,
     mri_integrator.set_slow_fast_timestep_ratio(fixed_mri_dt_ratio > 0 ? fixed_mri_dt_ratio : dt_mri_ratio[level]);
     mri_integrator.set_no_substep(no_substep_fun);
 
+    // Choose the number of substeps in each RK stage from the acoustic CFL condition
+    //    evaluated with the stage data
+    if (adaptive_substeps) {
+        mri_integrator.set_fast_timestep([&] (const Vector<MultiFab>& S_data) -> Real {
+            return estFastTimeStep(level, S_data);
+        });
+    }
+
     mri_integrator.advance(state_old, state_new, old_time, dt_advance);
 
-    if (verbose) Print() << "Done with advance_dycore at level " << level << std::endl;
+    // The exchange started after the last RK stage
+    if (IntermediatePatchPending()) {
+        FinishIntermediatePatch();
+    }
+
+    if (verbose) {
+        Print() << "Fast RHS workspace allocations at level " << level << " : "
+                << mri_integrator.get_fast_workspace().num_allocations << std::endl;
+        if (solverChoice.reuse_fast_coeffs) {
+            Print() << "Fast coefficients at level " << level << " computed "
+                    << mri_integrator.get_fast_workspace().num_coeffs_computed << " times, reused "
+                    << mri_integrator.get_fast_workspace().num_coeffs_skipped  << " times" << std::endl;
+        }
+        if (adaptive_substeps && !solverChoice.no_substepping && !solverChoice.incompressible[level]) {
+            const Vector<int>& stage_nsubsteps = mri_integrator.get_stage_nsubsteps();
+            Print() << "Adaptive substeps at level " << level << " in RK stages 1/2/3: "
+                    << stage_nsubsteps[0] << " " << stage_nsubsteps[1] << " " << stage_nsubsteps[2]
+                    << " (fixed ratio would be " << dt_mri_ratio[level] << ")" << std::endl;
+        }
+        Print() << "Done with advance_dycore at level " << level << std::endl;
+    }
 }
@@ -1,5 +1,6 @@
 
 #include <TI_fast_headers.H>
+#include <BatchedTridiagonalSolver.H>
 
 using namespace amrex;
 
@@ -16,6 +17,7 @@ using namespace amrex;
  * @param[in]    S_stg_prim primitive variables at previous RK stage
  * @param[in]    pi_stage   Exner function      at previous RK stage
  * @param[in]    fast_coeffs coefficients for the tridiagonal solve used in the fast integrator
+ * @param[inout] ws persistent scratch buffers owned by the integrator
  * @param[out]   S_data current solution
  * @param[in]    S_scratch scratch space
  * @param[in]    geom container for geometric information
@@ -49,6 +51,7 @@ void erf_fast_rhs_MT (int step, int nrk,
                       const MultiFab& S_stg_prim,                    // Primitive version of S_stg_data[IntVars::cons]
                       const MultiFab& pi_stage,                      // Exner function evaluated at last RK stg
                       const MultiFab& fast_coeffs,                   // Coeffs for tridiagonal solve
+                      FastRhsWorkspace& ws,                          // Scratch buffers owned by the integrator
                       Vector<MultiFab>& S_data,                      // S_sum = state at end of this substep
                       Vector<MultiFab>& S_scratch,                   // S_sum_old at most recent fast timestep for (rho theta)
                       const Geometry geom,
@@ -99,7 +102,7 @@ void erf_fast_rhs_MT (int step, int nrk,
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
-    MultiFab extrap(S_data[IntVars::cons].boxArray(),S_data[IntVars::cons].DistributionMap(),1,1);
+    MultiFab& extrap = ws.extrap;
 
     // *************************************************************************
     // Define updates in the current RK stg
@@ -108,11 +111,6 @@ void erf_fast_rhs_MT (int step, int nrk,
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
     {
-    FArrayBox temp_rhs_fab;
-
-    FArrayBox RHS_fab;
-    FArrayBox soln_fab;
-
     std::array<FArrayBox,AMREX_SPACEDIM> flux;
 
     //  NOTE: we leave tiling off here for efficiency -- to make this loop work with tiling
@@ -215,13 +213,9 @@ void erf_fast_rhs_MT (int step, int nrk,
         } // if step
         } // end profile
 
-        RHS_fab.resize     (tbz,1, The_Async_Arena());
-        soln_fab.resize    (tbz,1, The_Async_Arena());
-        temp_rhs_fab.resize(tbz,2, The_Async_Arena());
-
-        auto const& RHS_a        =      RHS_fab.array();
-        auto const& soln_a       =     soln_fab.array();
-        auto const& temp_rhs_arr = temp_rhs_fab.array();
+        auto const& RHS_a        = ws.RHS.array(mfi);
+        auto const& soln_a       = ws.soln.array(mfi);
+        auto const& temp_rhs_arr = ws.temp_rhs.array(mfi);
 
         auto const&     coeffA_a =     coeff_A_mf.array(mfi);
         auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
@@ -458,73 +452,23 @@ void erf_fast_rhs_MT (int step, int nrk,
 
         {
         BL_PROFILE("fast_rhs_b2d_loop_t");
-
-#ifdef AMREX_USE_GPU
         ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
         {
             // Moving terrain
             Real rho_on_bdy = 0.5 * ( prev_cons(i,j,lo.z) + prev_cons(i,j,lo.z-1) );
-            RHS_a(i,j,lo.z) = rho_on_bdy * zp_t_arr(i,j,0);
-
-            soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
+            RHS_a(i,j,lo.z) = rho_on_bdy * zp_t_arr(i,j,lo.z);
 
             // w_khi = 0
             RHS_a(i,j,hi.z+1)     =  0.0;
-
-            for (int k = lo.z+1; k <= hi.z+1; k++) {
-                soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-            }
-
-            for (int k = hi.z; k >= lo.z; k--) {
-                soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-            }
-
-           // We assume that Omega == w at the top boundary and that changes in J there are irrelevant
-            cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
         });
-#else
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
 
-                 Real rho_on_bdy = 0.5 * ( prev_cons(i,j,lo.z) + prev_cons(i,j,lo.z-1) );
-                 RHS_a(i,j,lo.z) = rho_on_bdy * zp_t_arr(i,j,lo.z);
-
-                 soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
-             }
-        }
-
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                 RHS_a (i,j,hi.z+1) =  0.0;
-             }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                 }
-           }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-                 }
-             }
-        }
+        batched_tridiagonal_solve(tbz, coeffA_a, inv_coeffB_a, coeffC_a, RHS_a, soln_a);
 
         // We assume that Omega == w at the top boundary and that changes in J there are irrelevant
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-#endif
+        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
+        {
+            cur_zmom(i,j,hi.z+1) = stg_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
+        });
         } // end profile
 
         {
@@ -1,5 +1,6 @@
 
 #include <TI_fast_headers.H>
+#include <BatchedTridiagonalSolver.H>
 
 using namespace amrex;
 
@@ -16,6 +17,7 @@ using namespace amrex;
  * @param[in]    S_stage_prim primitive variables at previous RK stage
  * @param[in]    pi_stage   Exner function      at previous RK stage
  * @param[in]    fast_coeffs coefficients for the tridiagonal solve used in the fast integrator
+ * @param[inout] ws persistent scratch buffers owned by the integrator
  * @param[out]   S_data current solution
  * @param[in]    S_scratch scratch space
  * @param[in]    geom container for geometric information
@@ -39,6 +41,7 @@ void erf_fast_rhs_N (int step, int nrk,
                      const MultiFab& S_stage_prim,                   // Primitive version of S_stage_data[IntVars::cons]
                      const MultiFab& pi_stage,                       // Exner function evaluated at last stage
                      const MultiFab& fast_coeffs,                    // Coeffs for tridiagonal solve
+                     FastRhsWorkspace& ws,                           // Scratch buffers owned by the integrator
                      Vector<MultiFab>& S_data,                       // S_sum = most recent full solution
                      Vector<MultiFab>& S_scratch,                    // S_sum_old at most recent fast timestep for (rho theta)
                      const Geometry geom,
@@ -68,12 +71,11 @@ void erf_fast_rhs_N (int step, int nrk,
     Real dyi = dxInv[1];
     Real dzi = dxInv[2];
 
-    const auto& ba = S_stage_data[IntVars::cons].boxArray();
-    const auto& dm = S_stage_data[IntVars::cons].DistributionMap();
-
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
+    // These are borrowed from the integrator's workspace so that we don't
+    //    allocate new MultiFabs on every substep
+    MultiFab& Delta_rho_w     = ws.Delta_rho_w;
+    MultiFab& Delta_rho       = ws.Delta_rho;
+    MultiFab& Delta_rho_theta = ws.Delta_rho_theta;
 
     MultiFab     coeff_A_mf(fast_coeffs, make_alias, 0, 1);
     MultiFab inv_coeff_B_mf(fast_coeffs, make_alias, 1, 1);
@@ -87,14 +89,14 @@ void erf_fast_rhs_N (int step, int nrk,
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
     // This will hold theta extrapolated forward in time
-    MultiFab extrap(S_data[IntVars::cons].boxArray(),S_data[IntVars::cons].DistributionMap(),1,1);
+    MultiFab& extrap = ws.extrap;
 
     // This will hold the update for (rho) and (rho theta)
-    MultiFab temp_rhs(S_stage_data[IntVars::zmom].boxArray(),S_stage_data[IntVars::zmom].DistributionMap(),2,0);
+    MultiFab& temp_rhs = ws.temp_rhs;
 
     // This will hold the new x- and y-momenta temporarily (so that we don't overwrite values we need when tiling)
-    MultiFab temp_cur_xmom(S_stage_data[IntVars::xmom].boxArray(),S_stage_data[IntVars::xmom].DistributionMap(),1,0);
-    MultiFab temp_cur_ymom(S_stage_data[IntVars::ymom].boxArray(),S_stage_data[IntVars::ymom].DistributionMap(),1,0);
+    MultiFab& temp_cur_xmom = ws.temp_cur_xmom;
+    MultiFab& temp_cur_ymom = ws.temp_cur_ymom;
 
     // *************************************************************************
     // First set up some arrays we'll need
@@ -295,14 +297,8 @@ void erf_fast_rhs_N (int step, int nrk,
         const Array4<const Real>& mf_u = mapfac_u->const_array(mfi);
         const Array4<const Real>& mf_v = mapfac_v->const_array(mfi);
 
-        FArrayBox RHS_fab;
-        RHS_fab.resize(tbz,1, The_Async_Arena());
-
-        FArrayBox soln_fab;
-        soln_fab.resize(tbz,1, The_Async_Arena());
-
-        auto const& RHS_a  = RHS_fab.array();
-        auto const& soln_a = soln_fab.array();
+        auto const& RHS_a  = ws.RHS.array(mfi);
+        auto const& soln_a = ws.soln.array(mfi);
 
         auto const& temp_rhs_arr = temp_rhs.array(mfi);
 
@@ -417,7 +413,6 @@ void erf_fast_rhs_N (int step, int nrk,
 
         {
         BL_PROFILE("fast_rhs_b2d_loop");
-#ifdef AMREX_USE_GPU
         auto const lo = lbound(bx);
         auto const hi = ubound(bx);
         ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
@@ -428,61 +423,13 @@ void erf_fast_rhs_N (int step, int nrk,
           // w_khi = 0
           // Note that if we ever change this, we will need to include it in avg_zmom at the top
           RHS_a   (i,j,hi.z+1) =  0.0;
+        });
 
-          // w = 0 at k = lo.z
-          soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
-          cur_zmom(i,j,lo.z) = stage_zmom(i,j,lo.z) + soln_a(i,j,lo.z);
-
-          for (int k = 1; k <= hi.z+1; k++) {
-              soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-          }
-          cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-          for (int k = hi.z; k >= lo.z; k--) {
-              soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) *soln_a(i,j,k+1);
-              cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
-          }
-        }); // b2d
-#else
-        auto const lo = lbound(bx);
-        auto const hi = ubound(bx);
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a   (i,j,lo.z) =  0.0;
-                soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
-            }
-        }
-        // Note that if we ever change this, we will need to include it in avg_zmom at the top
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a   (i,j,hi.z+1) =  0.0;
-            }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                }
-            }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) * soln_a(i,j,k+1);
-                    cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
-                }
-            }
-        }
-#endif
+        batched_tridiagonal_solve(tbz, coeffA_a, inv_coeffB_a, coeffC_a, RHS_a, soln_a,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            cur_zmom(i,j,k) = stage_zmom(i,j,k) + soln_a(i,j,k);
+        });
         } // end profile
 
         // **************************************************************************
@@ -1,5 +1,6 @@
 
 #include <TI_fast_headers.H>
+#include <BatchedTridiagonalSolver.H>
 
 using namespace amrex;
 
@@ -16,6 +17,7 @@ using namespace amrex;
  * @param[in]    S_stage_prim primitive variables at previous RK stage
  * @param[in]    pi_stage     Exner function      at previous RK stage
  * @param[in]    fast_coeffs coefficients for the tridiagonal solve used in the fast integrator
+ * @param[inout] ws persistent scratch buffers owned by the integrator
  * @param[out]   S_data current solution
  * @param[in]    S_scratch scratch space
  * @param[in]    geom container for geometric information
@@ -42,6 +44,7 @@ void erf_fast_rhs_T (int step, int nrk,
                      const MultiFab& S_stage_prim,                   // Primitive version of S_stage_data[IntVars::cons]
                      const MultiFab& pi_stage,                       // Exner function evaluated at last stage
                      const MultiFab& fast_coeffs,                    // Coeffs for tridiagonal solve
+                     FastRhsWorkspace& ws,                           // Scratch buffers owned by the integrator
                      Vector<MultiFab>& S_data,                       // S_sum = most recent full solution
                      Vector<MultiFab>& S_scratch,                    // S_sum_old at most recent fast timestep for (rho theta)
                      const Geometry geom,
@@ -73,17 +76,17 @@ void erf_fast_rhs_T (int step, int nrk,
     Real dxi = dxInv[0];
     Real dyi = dxInv[1];
     Real dzi = dxInv[2];
-    const auto& ba = S_stage_data[IntVars::cons].boxArray();
-    const auto& dm = S_stage_data[IntVars::cons].DistributionMap();
 
-    MultiFab Delta_rho_u(    convert(ba,IntVect(1,0,0)), dm, 1, 1);
-    MultiFab Delta_rho_v(    convert(ba,IntVect(0,1,0)), dm, 1, 1);
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
+    // These are borrowed from the integrator's workspace so that we don't
+    //    allocate new MultiFabs on every substep
+    MultiFab& Delta_rho_u     = ws.Delta_rho_u;
+    MultiFab& Delta_rho_v     = ws.Delta_rho_v;
+    MultiFab& Delta_rho_w     = ws.Delta_rho_w;
+    MultiFab& Delta_rho       = ws.Delta_rho;
+    MultiFab& Delta_rho_theta = ws.Delta_rho_theta;
 
-    MultiFab New_rho_u(convert(ba,IntVect(1,0,0)), dm, 1, 1);
-    MultiFab New_rho_v(convert(ba,IntVect(0,1,0)), dm, 1, 1);
+    MultiFab& New_rho_u = ws.New_rho_u;
+    MultiFab& New_rho_v = ws.New_rho_v;
 
     MultiFab     coeff_A_mf(fast_coeffs, make_alias, 0, 1);
     MultiFab inv_coeff_B_mf(fast_coeffs, make_alias, 1, 1);
@@ -96,7 +99,7 @@ void erf_fast_rhs_T (int step, int nrk,
     const    Array<Real,AMREX_SPACEDIM> grav{0.0, 0.0, -gravity};
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
-    MultiFab extrap(S_data[IntVars::cons].boxArray(),S_data[IntVars::cons].DistributionMap(),1,1);
+    MultiFab& extrap = ws.extrap;
 
     // *************************************************************************
     // First set up some arrays we'll need
@@ -345,17 +348,9 @@ void erf_fast_rhs_T (int step, int nrk,
         // Initialize New_rho_u/v/w to Delta_rho_u/v/w so that
         // the ghost cells in New_rho_u/v/w will match old_drho_u/v/w
 
-        FArrayBox temp_rhs_fab;
-        FArrayBox RHS_fab;
-        FArrayBox soln_fab;
-
-        RHS_fab.resize     (tbz,1,The_Async_Arena());
-        soln_fab.resize    (tbz,1,The_Async_Arena());
-        temp_rhs_fab.resize(tbz,2,The_Async_Arena());
-
-        auto const& RHS_a        =      RHS_fab.array();
-        auto const& soln_a       =     soln_fab.array();
-        auto const& temp_rhs_arr = temp_rhs_fab.array();
+        auto const& RHS_a        = ws.RHS.array(mfi);
+        auto const& soln_a       = ws.soln.array(mfi);
+        auto const& temp_rhs_arr = ws.temp_rhs.array(mfi);
 
         auto const&     coeffA_a =     coeff_A_mf.array(mfi);
         auto const& inv_coeffB_a = inv_coeff_B_mf.array(mfi);
@@ -517,62 +512,19 @@ void erf_fast_rhs_T (int step, int nrk,
 
         {
         BL_PROFILE("fast_rhs_b2d_loop_t");
-#ifdef AMREX_USE_GPU
         ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
         {
             // w_klo = 0  w_khi = 0
             RHS_a(i,j,lo.z  ) =  0.0;
             RHS_a(i,j,hi.z+1) =  0.0;
+        });
 
-            // w = 0 at k = lo.z
-            soln_a(i,j,lo.z) = 0.;
+        batched_tridiagonal_solve(tbz, coeffA_a, inv_coeffB_a, coeffC_a, RHS_a, soln_a);
 
-            for (int k = lo.z+1; k <= hi.z+1; k++) {
-                soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-            }
+        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
+        {
             cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            for (int k = hi.z; k >= lo.z; k--) {
-                soln_a(i,j,k) -= ( coeffC_a(i,j,k) * inv_coeffB_a(i,j,k) ) *soln_a(i,j,k+1);
-            }
         });
-#else
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                RHS_a(i,j,lo.z) =  0.0;
-               soln_a(i,j,lo.z) = RHS_a(i,j,lo.z) * inv_coeffB_a(i,j,lo.z);
-           }
-        }
-
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                 RHS_a (i,j,hi.z+1) =  0.0;
-             }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) = (RHS_a(i,j,k)-coeffA_a(i,j,k)*soln_a(i,j,k-1)) * inv_coeffB_a(i,j,k);
-                 }
-           }
-        }
-        for (int k = hi.z; k >= lo.z; --k) {
-             for (int j = lo.y; j <= hi.y; ++j) {
-                 AMREX_PRAGMA_SIMD
-                 for (int i = lo.x; i <= hi.x; ++i) {
-                     soln_a(i,j,k) -= (coeffC_a(i,j,k) * inv_coeffB_a(i,j,k)) * soln_a(i,j,k+1);
-                 }
-             }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-             AMREX_PRAGMA_SIMD
-             for (int i = lo.x; i <= hi.x; ++i) {
-                cur_zmom(i,j,hi.z+1) = stage_zmom(i,j,hi.z+1) + soln_a(i,j,hi.z+1);
-            }
-        }
-#endif
         } // end profile
 
         {
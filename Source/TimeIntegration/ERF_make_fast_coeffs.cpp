@@ -1,6 +1,7 @@
 #include <AMReX.H>
 
 #include <TI_fast_headers.H>
+#include <BatchedTridiagonalSolver.H>
 #include <prob_common.H>
 
 using namespace amrex;
@@ -82,14 +83,11 @@ void make_fast_coeffs (int /*level*/,
         const Array4<const Real>& pi0_ca      = pi0->const_array(mfi);
         const Array4<const Real>& pi_stage_ca = pi_stage.const_array(mfi);
 
-        FArrayBox gam_fab; gam_fab.resize(surroundingNodes(bx,2),1,The_Async_Arena());
-
         auto const& coeffA_a  = coeff_A_mf.array(mfi);
         auto const& coeffB_a  = coeff_B_mf.array(mfi);
         auto const& coeffC_a  = coeff_C_mf.array(mfi);
         auto const& coeffP_a  = coeff_P_mf.array(mfi);
         auto const& coeffQ_a  = coeff_Q_mf.array(mfi);
-        auto const&    gam_a  = gam_fab.array();
 
         // *********************************************************************
         // *********************************************************************
@@ -207,8 +205,8 @@ void make_fast_coeffs (int /*level*/,
 
         {
         BL_PROFILE("make_coeffs_b2d_loop");
-#ifdef AMREX_USE_GPU
-        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int) {
+        ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int)
+        {
           // w_0 = 0
           coeffA_a(i,j,lo.z) =  0.0;
           coeffB_a(i,j,lo.z) =  1.0;
@@ -222,49 +220,10 @@ void make_fast_coeffs (int /*level*/,
           }
           coeffB_a(i,j,hi.z+1) =  1.0;
           coeffC_a(i,j,hi.z+1) =  0.0;
-
-          // w = 0 at k = 0
-          Real bet = coeffB_a(i,j,lo.z);
-
-          for (int k = lo.z+1; k <= hi.z+1; k++) {
-              gam_a(i,j,k) = coeffC_a(i,j,k-1) / bet;
-              bet = coeffB_a(i,j,k) - coeffA_a(i,j,k)*gam_a(i,j,k);
-              coeffB_a(i,j,k) = bet;
-          }
         });
-#else
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-                coeffA_a(i,j,lo.z) =  0.0;
-                coeffB_a(i,j,lo.z) =  1.0;
-                coeffC_a(i,j,lo.z) =  0.0;
-            }
-        }
-        for (int j = lo.y; j <= hi.y; ++j) {
-            AMREX_PRAGMA_SIMD
-            for (int i = lo.x; i <= hi.x; ++i) {
-
-                coeffA_a(i,j,hi.z+1) =  0.0;
-                  if(phys_bc_type[5] == ERF_BC::outflow or phys_bc_type[5] == ERF_BC::ho_outflow)
-                {
-                    coeffA_a(i,j,hi.z+1) =  -1.0;
-                }
-                coeffB_a(i,j,hi.z+1) =  1.0;
-                coeffC_a(i,j,hi.z+1) =  0.0;
-            }
-        }
-        for (int k = lo.z+1; k <= hi.z+1; ++k) {
-            for (int j = lo.y; j <= hi.y; ++j) {
-                AMREX_PRAGMA_SIMD
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    gam_a(i,j,k) = coeffC_a(i,j,k-1) / coeffB_a(i,j,k-1);
-                    Real bet = coeffB_a(i,j,k) - coeffA_a(i,j,k)*gam_a(i,j,k);
-                    coeffB_a(i,j,k) = bet;
-                }
-            }
-        }
-#endif
+
+        // w = 0 at k = 0
+        batched_tridiagonal_factorize(tbz, coeffA_a, coeffB_a, coeffC_a);
         } // end profile
 
         // In the end we save the inverse of the diagonal (B) coefficient
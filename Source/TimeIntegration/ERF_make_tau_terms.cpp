@@ -28,10 +28,14 @@ void erf_make_tau_terms (int level, int nrk,
                          std::unique_ptr<MultiFab>& detJ,
                          std::unique_ptr<MultiFab>& mapfac_m,
                          std::unique_ptr<MultiFab>& mapfac_u,
-                         std::unique_ptr<MultiFab>& mapfac_v)
+                         std::unique_ptr<MultiFab>& mapfac_v,
+                         TileRegion region)
 {
     BL_PROFILE_REGION("erf_make_tau_terms()");
 
+    // The stresses are read one cell outside the region of the slow RHS
+    const int region_ng = S_data[IntVars::cons].nGrow() - 1;
+
     const BCRec* bc_ptr_h = domain_bcs_type_h.data();
 
     DiffChoice dc = solverChoice.diffChoice;
@@ -88,8 +92,8 @@ void erf_make_tau_terms (int level, int nrk,
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
         for ( MFIter mfi(S_data[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
+        for (const Box& bx : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
         {
-            const Box& bx = mfi.tilebox();
             const Box& valid_bx = mfi.validbox();
 
             // Velocities
@@ -130,10 +134,10 @@ void erf_make_tau_terms (int level, int nrk,
             //-------------------------------------------------------------------------------
 
             // Strain/Stress tile boxes
-            Box bxcc  = mfi.tilebox();
-            Box tbxxy = mfi.tilebox(IntVect(1,1,0));
-            Box tbxxz = mfi.tilebox(IntVect(1,0,1));
-            Box tbxyz = mfi.tilebox(IntVect(0,1,1));
+            Box bxcc  = bx;
+            Box tbxxy = RegionNodalBox(bx, mfi.tilebox(), mfi.tilebox(IntVect(1,1,0)));
+            Box tbxxz = RegionNodalBox(bx, mfi.tilebox(), mfi.tilebox(IntVect(1,0,1)));
+            Box tbxyz = RegionNodalBox(bx, mfi.tilebox(), mfi.tilebox(IntVect(0,1,1)));
 
             // We need a halo cell for terrain
              bxcc.grow(IntVect(1,1,0));
@@ -245,11 +249,11 @@ void erf_make_tau_terms (int level, int nrk,
                 // to retain the values set by MOST.
                 if (use_most && exp_most) {
                     // Don't overwrite modeled total stress value at boundary
-                    tbxxz.setSmall(2,1);
-                    tbxyz.setSmall(2,1);
+                    tbxxz.setSmall(2,std::max(1,tbxxz.smallEnd(2)));
+                    tbxyz.setSmall(2,std::max(1,tbxyz.smallEnd(2)));
                     if (rot_most) {
-                        bxcc.setSmall(2,1);
-                        tbxxy.setSmall(2,1);
+                        bxcc.setSmall(2,std::max(1,bxcc.smallEnd(2)));
+                        tbxxy.setSmall(2,std::max(1,tbxxy.smallEnd(2)));
                     }
                 }
 
@@ -357,8 +361,8 @@ void erf_make_tau_terms (int level, int nrk,
                 // to retain the values set by MOST.
                 if (use_most && exp_most) {
                     // Don't overwrite modeled total stress value at boundary
-                    tbxxz.setSmall(2,1);
-                    tbxyz.setSmall(2,1);
+                    tbxxz.setSmall(2,std::max(1,tbxxz.smallEnd(2)));
+                    tbxyz.setSmall(2,std::max(1,tbxyz.smallEnd(2)));
                 }
 
                 // *****************************************************************************
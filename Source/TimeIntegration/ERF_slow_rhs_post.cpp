@@ -146,10 +146,14 @@ void erf_slow_rhs_post (int level, int finest_level,
     // *************************************************************************
     // Pre-computed quantities
     // *************************************************************************
-    int nvars                     = S_data[IntVars::cons].nComp();
+    int nvars                     = S_new[IntVars::cons].nComp();
     const BoxArray& ba            = S_data[IntVars::cons].boxArray();
     const DistributionMapping& dm = S_data[IntVars::cons].DistributionMap();
 
+    // If the integrator only holds (rho) and (rho theta) in S_data then the slow
+    //    variables are updated directly in S_new
+    const bool l_trimmed = (S_data[IntVars::cons].nComp() < nvars);
+
     std::unique_ptr<MultiFab> dflux_x;
     std::unique_ptr<MultiFab> dflux_y;
     std::unique_ptr<MultiFab> dflux_z;
@@ -258,6 +262,7 @@ void erf_slow_rhs_post (int level, int finest_level,
         const Array4<      Real> & new_zmom  = S_new[IntVars::zmom].array(mfi);
 
         const Array4<      Real> & cur_cons  = S_data[IntVars::cons].array(mfi);
+        const Array4<      Real> & slow_cons = (l_trimmed) ? new_cons : cur_cons;
         const Array4<const Real> & cur_prim  = S_prim.array(mfi);
         const Array4<      Real> & cur_xmom  = S_data[IntVars::xmom].array(mfi);
         const Array4<      Real> & cur_ymom  = S_data[IntVars::ymom].array(mfi);
@@ -293,11 +298,13 @@ void erf_slow_rhs_post (int level, int finest_level,
         // **************************************************************************
         // Note that here we do copy only the "slow" variables, not (rho) or (rho theta)
         // **************************************************************************
-        ParallelFor(tbx, ncomp_slow[IntVars::cons],
-        [=] AMREX_GPU_DEVICE (int i, int j, int k, int nn) {
-            const int n = scomp_slow[IntVars::cons] + nn;
-            cur_cons(i,j,k,n) = new_cons(i,j,k,n);
-        });
+        if (!l_trimmed) {
+            ParallelFor(tbx, ncomp_slow[IntVars::cons],
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int nn) {
+                const int n = scomp_slow[IntVars::cons] + nn;
+                cur_cons(i,j,k,n) = new_cons(i,j,k,n);
+            });
+        }
 
         // We have projected the velocities stored in S_data but we will use
         //    the velocities stored in S_scratch to update the scalars, so
@@ -395,7 +402,7 @@ void erf_slow_rhs_post (int level, int finest_level,
                 }
 
                 AdvectionSrcForScalars(dt, tbx, start_comp, num_comp, avg_xmom, avg_ymom, avg_zmom,
-                                       cur_cons, cur_prim, cell_rhs,
+                                       slow_cons, cur_prim, cell_rhs,
                                        l_use_mono_adv, max_s_ptr, min_s_ptr,
                                        detJ_arr, dxInv, mf_m,
                                        horiz_adv_type, vert_adv_type,
@@ -466,11 +473,11 @@ void erf_slow_rhs_post (int level, int finest_level,
                         const int n = start_comp + nn;
                         cell_rhs(i,j,k,n) += src_arr(i,j,k,n);
                         Real temp_val = detJ_arr(i,j,k) * old_cons(i,j,k,n) + dt * detJ_arr(i,j,k) * cell_rhs(i,j,k,n);
-                        cur_cons(i,j,k,n) = temp_val / detJ_new_arr(i,j,k);
+                        slow_cons(i,j,k,n) = temp_val / detJ_new_arr(i,j,k);
                         if (ivar == RhoKE_comp) {
-                            cur_cons(i,j,k,n) = amrex::max(cur_cons(i,j,k,n), eps);
+                            slow_cons(i,j,k,n) = amrex::max(slow_cons(i,j,k,n), eps);
                         } else if (ivar == RhoQKE_comp) {
-                            cur_cons(i,j,k,n) = amrex::max(cur_cons(i,j,k,n), 1e-12);
+                            slow_cons(i,j,k,n) = amrex::max(slow_cons(i,j,k,n), 1e-12);
                         }
                     });
 
@@ -480,13 +487,13 @@ void erf_slow_rhs_post (int level, int finest_level,
                     [=] AMREX_GPU_DEVICE (int i, int j, int k, int nn) noexcept {
                         const int n = start_comp + nn;
                         cell_rhs(i,j,k,n) += src_arr(i,j,k,n);
-                        cur_cons(i,j,k,n) = old_cons(i,j,k,n) + dt * cell_rhs(i,j,k,n);
+                        slow_cons(i,j,k,n) = old_cons(i,j,k,n) + dt * cell_rhs(i,j,k,n);
                         if (ivar == RhoKE_comp) {
-                            cur_cons(i,j,k,n) = amrex::max(cur_cons(i,j,k,n), eps);
+                            slow_cons(i,j,k,n) = amrex::max(slow_cons(i,j,k,n), eps);
                         } else if (ivar == RhoQKE_comp) {
-                            cur_cons(i,j,k,n) = amrex::max(cur_cons(i,j,k,n), 1e-12);
+                            slow_cons(i,j,k,n) = amrex::max(slow_cons(i,j,k,n), 1e-12);
                         } else if (ivar >= RhoQ1_comp) {
-                            cur_cons(i,j,k,n) = amrex::max(cur_cons(i,j,k,n), 0.0);
+                            slow_cons(i,j,k,n) = amrex::max(slow_cons(i,j,k,n), 0.0);
                         }
                     });
 
@@ -498,7 +505,8 @@ void erf_slow_rhs_post (int level, int finest_level,
 
         {
         BL_PROFILE("rhs_post_9");
-        // This updates all the conserved variables (not just the "slow" ones)
+        // This updates all the conserved variables held in S_data (not just the "slow" ones);
+        //    if S_data is trimmed this is just (rho) and (rho theta)
         int   num_comp_all = S_data[IntVars::cons].nComp();
         ParallelFor(tbx, num_comp_all,
         [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept {
@@ -62,6 +62,7 @@ using namespace amrex;
  * @param[in] mapfac_v map factor at y-faces
  * @param[inout] fr_as_crse YAFluxRegister at level l at level l   / l+1 interface
  * @param[inout] fr_as_fine YAFluxRegister at level l at level l-1 / l   interface
+ * @param[in] region part of each tile on which to compute the RHS
  */
 
 void erf_slow_rhs_pre (int level, int finest_level,
@@ -115,7 +116,8 @@ void erf_slow_rhs_pre (int level, int finest_level,
                        EBFArrayBoxFactory const& ebfact,
 #endif
                        YAFluxRegister* fr_as_crse,
-                       YAFluxRegister* fr_as_fine)
+                       YAFluxRegister* fr_as_fine,
+                       TileRegion region)
 {
     BL_PROFILE_REGION("erf_slow_rhs_pre()");
 
@@ -147,6 +149,9 @@ void erf_slow_rhs_pre (int level, int finest_level,
     const bool l_use_mono_adv   = solverChoice.use_mono_adv;
     const bool l_reflux = (solverChoice.coupling_type == CouplingType::TwoWay);
 
+    // The flux registers are filled per tile, not per part of a tile
+    AMREX_ALWAYS_ASSERT(region == TileRegion::All || !l_reflux || (level == 0 && finest_level == 0));
+
     const bool l_use_diff       = ( (dc.molec_diff_type != MolecDiffType::None) ||
                                     (tc.les_type        !=       LESType::None) ||
                                     (tc.pbl_type        !=       PBLType::None) );
@@ -201,7 +206,7 @@ void erf_slow_rhs_pre (int level, int finest_level,
                            S_data,xvel,yvel,zvel,Omega,
                            Tau11,Tau22,Tau33,Tau12,Tau13,Tau21,Tau23,Tau31,Tau32,
                            SmnSmn,eddyDiffs,geom,solverChoice,most,
-                           detJ,mapfac_m,mapfac_u,mapfac_v);
+                           detJ,mapfac_m,mapfac_u,mapfac_v,region);
 
         dflux_x = std::make_unique<MultiFab>(convert(ba,IntVect(1,0,0)), dm, nvars, 0);
         dflux_y = std::make_unique<MultiFab>(convert(ba,IntVect(0,1,0)), dm, nvars, 0);
@@ -234,6 +239,9 @@ void erf_slow_rhs_pre (int level, int finest_level,
     Real* max_s_ptr = max_scal_d.data();
     Real* min_s_ptr = min_scal_d.data();
 
+    // Width of the shell of cells whose stencils may reach into the ghost cells
+    const int region_ng = S_data[IntVars::cons].nGrow();
+
     // *****************************************************************************
     // Define updates and fluxes in the current RK stage
     // *****************************************************************************
@@ -245,15 +253,16 @@ void erf_slow_rhs_pre (int level, int finest_level,
     std::array<FArrayBox,AMREX_SPACEDIM> flux_tmp;
 
     for ( MFIter mfi(S_data[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
+    for (const Box& bx : RegionBoxes(mfi.tilebox(), mfi.validbox(), region, region_ng))
     {
-        Box bx  = mfi.tilebox();
-        Box tbx = mfi.nodaltilebox(0);
-        Box tby = mfi.nodaltilebox(1);
+        Box tbx = RegionNodalBox(bx, mfi.tilebox(), mfi.nodaltilebox(0));
+        Box tby = RegionNodalBox(bx, mfi.tilebox(), mfi.nodaltilebox(1));
         Box tbz = mfi.nodaltilebox(2);
 
         // We don't compute a source term for z-momentum on the bottom or top boundary
         tbz.growLo(2,-1);
         tbz.growHi(2,-1);
+        tbz = RegionNodalBox(bx, mfi.tilebox(), tbz);
 
         const Array4<const Real> & cell_data  = S_data[IntVars::cons].array(mfi);
         const Array4<const Real> & cell_prim  = S_prim.array(mfi);
@@ -335,7 +344,7 @@ void erf_slow_rhs_pre (int level, int finest_level,
         // *****************************************************************************
         FArrayBox pprime;
         if (!l_incompressible) {
-            Box gbx = mfi.tilebox(); gbx.grow(IntVect(1,1,1));
+            Box gbx = bx; gbx.grow(IntVect(1,1,1));
             if (gbx.smallEnd(2) < 0) gbx.setSmall(2,0);
             pprime.resize(gbx,1,The_Async_Arena());
             const Array4<Real>& pptemp_arr = pprime.array();
@@ -2,6 +2,8 @@
 #include <AMReX_MLMG.H>
 #include <AMReX_MLABecLaplacian.H>
 #include "Utils.H"
+#include "FFTPoisson.H"
+#include "BatchedPlaneAverage.H"
 
 #ifdef ERF_USE_POISSON_SOLVE
 
@@ -43,6 +45,70 @@ bool ERF::projection_has_dirichlet (Array<LinOpBCType,AMREX_SPACEDIM> bcs) const
     return false;
 }
 
+namespace {
+/**
+ * The FFT solver needs the face coefficients (dt rho_0 / rho) to depend on z only,
+ * i.e. rho and rho_0 to be horizontally uniform.  If they are (to roundoff), fill
+ * the coefficient on the x- and y-faces (bh, one value per cell in z) and on the
+ * z-faces (bz, one-sided at the domain boundaries) and return true.
+ */
+bool
+separable_projection_coeffs (const Geometry& geom, Real l_dt,
+                             const MultiFab& density, const MultiFab& r_hse,
+                             Vector<Real>& bh, Vector<Real>& bz)
+{
+    BatchedPlaneAverage pavg(geom, 2);
+    int f_rho  = pavg.add(&density);
+    int f_rho0 = pavg.add(&r_hse);
+    pavg();
+
+    Vector<Real> rho_avg, rho0_avg;
+    pavg.line_average(f_rho , 0, rho_avg);
+    pavg.line_average(f_rho0, 0, rho0_avg);
+
+    const int nz  = static_cast<int>(rho_avg.size());
+    const int klo = geom.Domain().smallEnd(2);
+
+    Gpu::DeviceVector<Real> d_rho(nz), d_rho0(nz);
+    Gpu::copy(Gpu::hostToDevice, rho_avg.begin() , rho_avg.end() , d_rho.begin());
+    Gpu::copy(Gpu::hostToDevice, rho0_avg.begin(), rho0_avg.end(), d_rho0.begin());
+    const Real* p_rho  = d_rho.data();
+    const Real* p_rho0 = d_rho0.data();
+
+    // Largest relative departure from the plane averages
+    ReduceOps<ReduceOpMax> reduce_op;
+    ReduceData<Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    for (MFIter mfi(density,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<Real const> const& rho_arr   = density.const_array(mfi);
+        Array4<Real const> const& rho_0_arr = r_hse.const_array(mfi);
+        reduce_op.eval(bx, reduce_data, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+        {
+            int kk = k - klo;
+            return { amrex::max(std::abs(rho_arr  (i,j,k) - p_rho [kk]) / p_rho [kk],
+                                std::abs(rho_0_arr(i,j,k) - p_rho0[kk]) / p_rho0[kk]) };
+        });
+    }
+    Real max_dev = amrex::get<0>(reduce_data.value(reduce_op));
+    ParallelDescriptor::ReduceRealMax(max_dev);
+
+    if (max_dev > 1.e-12) return false;
+
+    bh.resize(nz);
+    bz.resize(nz+1);
+    for (int k = 0; k < nz; ++k) {
+        bh[k] = l_dt * rho0_avg[k] / rho_avg[k];
+    }
+    bz[0]  = bh[0];
+    bz[nz] = bh[nz-1];
+    for (int k = 1; k < nz; ++k) {
+        bz[k] = l_dt * (rho0_avg[k] + rho0_avg[k-1]) / (rho_avg[k] + rho_avg[k-1]);
+    }
+    return true;
+}
+} // namespace
 
 /**
  * Project the single-level velocity field to enforce incompressibility
@@ -54,78 +120,18 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
     AMREX_ALWAYS_ASSERT(!solverChoice.use_terrain);
 
     // Make sure the solver only sees the levels over which we are solving
-    LPInfo info;
     Vector<BoxArray>            ba_tmp;   ba_tmp.push_back(vmf[Vars::cons].boxArray());
     Vector<DistributionMapping> dm_tmp;   dm_tmp.push_back(vmf[Vars::cons].DistributionMap());
     Vector<Geometry>          geom_tmp; geom_tmp.push_back(geom[lev]);
 
-    MLABecLaplacian mlabec(geom_tmp, ba_tmp, dm_tmp, info);
-
-    //
-    // This will hold (1/rho) on faces
-    //
-    Array<MultiFab,AMREX_SPACEDIM> inv_rho;
-
-    //
-    // The operator is (alpha A - beta del dot B grad) phi = RHS
-    // Here we set alpha to 0 and beta to -1
-    // Then b is (dt/rho)
-    //
-    mlabec.setScalars(0.0, -1.0);
-    inv_rho[0].define(vmf[Vars::xvel].boxArray(),dm_tmp[0],1,0,MFInfo());
-    inv_rho[1].define(vmf[Vars::yvel].boxArray(),dm_tmp[0],1,0,MFInfo());
-    inv_rho[2].define(vmf[Vars::zvel].boxArray(),dm_tmp[0],1,0,MFInfo());
-
     MultiFab density(vmf[Vars::cons], make_alias, Rho_comp, 1);
     density.FillBoundary(geom_tmp[0].periodicity());
 
     MultiFab r_hse(base_state[lev], make_alias, 0, 1); // r_0 is first  component
 
-#ifdef _OPENMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-    for (MFIter mfi(density,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        Array4<Real const> const& rho_arr     = density.const_array(mfi);
-        Array4<Real const> const& rho_0_arr   = r_hse.const_array(mfi);
-
-        Box const& bxx = mfi.nodaltilebox(0);
-        Array4<Real      > const& inv_rhox_arr = inv_rho[0].array(mfi);
-        ParallelFor(bxx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i-1,j,k));
-            inv_rhox_arr(i,j,k) = l_dt * rho_0_arr(i,j,k) / rho_edge;
-        });
-
-        Box const& bxy = mfi.nodaltilebox(1);
-        Array4<Real      > const& inv_rhoy_arr = inv_rho[1].array(mfi);
-        ParallelFor(bxy, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i,j-1,k));
-            inv_rhoy_arr(i,j,k) = l_dt * rho_0_arr(i,j,k) / rho_edge;
-        });
-
-        Box const& bxz = mfi.nodaltilebox(2);
-        Array4<Real      > const& inv_rhoz_arr = inv_rho[2].array(mfi);
-        ParallelFor(bxz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i,j,k-1));
-            Real rho_0_edge = Real(0.5) * (rho_0_arr(i,j,k) + rho_0_arr(i,j,k-1));
-            inv_rhoz_arr(i,j,k) = l_dt * rho_0_edge / rho_edge;
-        });
-    } // mfi
-
-    mlabec.setBCoeffs(0, GetArrOfConstPtrs(inv_rho));
-
     auto bclo = get_projection_bc(Orientation::low);
     auto bchi = get_projection_bc(Orientation::high);
     bool need_adjust_rhs = (projection_has_dirichlet(bclo) || projection_has_dirichlet(bchi)) ? false : true;
-    mlabec.setDomainBC(bclo, bchi);
-
-    if (lev > 0) {
-        mlabec.setCoarseFineBC(nullptr, ref_ratio[lev-1], LinOpBCType::Neumann);
-    }
-    mlabec.setLevelBC(0, nullptr);
 
     Vector<MultiFab> rhs;
     Vector<MultiFab> phi;
@@ -136,7 +142,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
     fluxes.resize(1);
 
     rhs[0].define(ba_tmp[0], dm_tmp[0], 1, 0);
-    phi[0].define(ba_tmp[0], dm_tmp[0], 1, 0);
+    phi[0].define(ba_tmp[0], dm_tmp[0], 1, 1);
     rhs[0].setVal(0.0);
     phi[0].setVal(0.0);
 
@@ -201,19 +207,198 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
     // Initialize phi to 0
     phi[0].setVal(0.0);
 
-    MLMG mlmg(mlabec);
-    int max_iter = 100;
-    mlmg.setMaxIter(max_iter);
+    // On a horizontally periodic level 0 with horizontally uniform coefficients
+    //    the operator is separable and we can solve directly with FFTs
+    Vector<Real> bh, bz;
+    bool use_fft = solverChoice.use_fft_poisson && (lev == 0) &&
+                   geom[lev].isPeriodic(0) && geom[lev].isPeriodic(1) && !geom[lev].isPeriodic(2);
+    if (use_fft && !fft_poisson_supported(geom[lev].Domain())) {
+        static bool warned = false;
+        if (!warned) {
+            Warning("erf.use_fft_poisson: nx and ny must factor into 2, 3 and 5; using MLMG for the projection");
+            warned = true;
+        }
+        use_fft = false;
+    }
+    if (use_fft) {
+        use_fft = separable_projection_coeffs(geom[lev], l_dt, density, r_hse, bh, bz);
+        if (!use_fft && mg_verbose > 0) {
+            Print() << "Density is not horizontally uniform; using MLMG for the projection" << std::endl;
+        }
+    }
+
+    // The history of the pressure increments is kept whichever solver is used,
+    //    so a later multigrid solve starts from an up-to-date guess
+    if (!m_projection[lev] || !m_projection[lev]->valid_for(ba_tmp[0], dm_tmp[0]) ||
+        !solverChoice.reuse_projection_solver)
+    {
+        m_projection[lev] = std::make_unique<ProjectionSolver>();
+        m_projection[lev]->ba = ba_tmp[0];
+        m_projection[lev]->dm = dm_tmp[0];
+    }
+    ProjectionSolver& proj = *m_projection[lev];
+
+    if (use_fft)
+    {
+        const bool dir_lo = (bclo[2] == LinOpBCType::Dirichlet);
+        const bool dir_hi = (bchi[2] == LinOpBCType::Dirichlet);
 
-    mlmg.setVerbose(mg_verbose);
-    mlmg.setBottomVerbose(0);
+        solve_poisson_fft(geom[lev], bh, bz, dir_lo, dir_hi, rhs[0], phi[0]);
+        phi[0].FillBoundary(geom[lev].periodicity());
+        if (mg_verbose > 0) {
+            Print() << "Projection at level " << lev << " solved with FFTs" << std::endl;
+        }
+
+        Gpu::DeviceVector<Real> d_bh(bh.size());
+        Gpu::DeviceVector<Real> d_bz(bz.size());
+        Gpu::copy(Gpu::hostToDevice, bh.begin(), bh.end(), d_bh.begin());
+        Gpu::copy(Gpu::hostToDevice, bz.begin(), bz.end(), d_bz.begin());
+        const Real* p_bh = d_bh.data();
+        const Real* p_bz = d_bz.data();
 
-    mlmg.solve(GetVecOfPtrs(phi),
-               GetVecOfConstPtrs(rhs),
-               solverChoice.poisson_reltol,
-               solverChoice.poisson_abstol);
+        const auto dxInv = geom[lev].InvCellSizeArray();
+        const int klo = geom[lev].Domain().smallEnd(2);
+        const int khi = geom[lev].Domain().bigEnd(2);
 
-    mlmg.getFluxes(GetVecOfArrOfPtrs(fluxes));
+        // The fluxes -(dt rho0/rho) grad(phi) with the same coefficients as the solve
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(phi[0],TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Array4<Real const> const& phi_arr = phi[0].const_array(mfi);
+
+            Box const& bxx = mfi.nodaltilebox(0);
+            Array4<Real> const& fx = fluxes[0][0].array(mfi);
+            ParallelFor(bxx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                fx(i,j,k) = -p_bh[k-klo] * (phi_arr(i,j,k) - phi_arr(i-1,j,k)) * dxInv[0];
+            });
+
+            Box const& bxy = mfi.nodaltilebox(1);
+            Array4<Real> const& fy = fluxes[0][1].array(mfi);
+            ParallelFor(bxy, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                fy(i,j,k) = -p_bh[k-klo] * (phi_arr(i,j,k) - phi_arr(i,j-1,k)) * dxInv[1];
+            });
+
+            Box const& bxz = mfi.nodaltilebox(2);
+            Array4<Real> const& fz = fluxes[0][2].array(mfi);
+            ParallelFor(bxz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                if (k == klo) {
+                    fz(i,j,k) = (dir_lo) ? -p_bz[0] * phi_arr(i,j,k) * 2.0 * dxInv[2] : 0.0;
+                } else if (k == khi+1) {
+                    fz(i,j,k) = (dir_hi) ? p_bz[k-klo] * phi_arr(i,j,k-1) * 2.0 * dxInv[2] : 0.0;
+                } else {
+                    fz(i,j,k) = -p_bz[k-klo] * (phi_arr(i,j,k) - phi_arr(i,j,k-1)) * dxInv[2];
+                }
+            });
+        } // mfi
+        Gpu::streamSynchronize();
+
+        // The coefficients hold dt, so phi is already the pressure increment
+        proj.save_solution(phi[0]);
+    }
+    else
+    {
+        // Build the operator hierarchy on the first multigrid solve and after regridding
+        if (!proj.mlmg)
+        {
+            BL_PROFILE("ERF::project_velocities::setup()");
+
+            LPInfo info;
+            proj.mlabec = std::make_unique<MLABecLaplacian>(geom_tmp, ba_tmp, dm_tmp, info);
+
+            //
+            // The operator is (alpha A - beta del dot B grad) phi = RHS
+            // Here we set alpha to 0 and beta to -1
+            // Then b is (rho0/rho) and the solution is dt times the change in pressure
+            //
+            proj.mlabec->setScalars(0.0, -1.0);
+            proj.mlabec->setDomainBC(bclo, bchi);
+            if (lev > 0) {
+                proj.mlabec->setCoarseFineBC(nullptr, ref_ratio[lev-1], LinOpBCType::Neumann);
+            }
+            proj.mlabec->setLevelBC(0, nullptr);
+
+            proj.inv_rho[0].define(vmf[Vars::xvel].boxArray(),dm_tmp[0],1,0,MFInfo());
+            proj.inv_rho[1].define(vmf[Vars::yvel].boxArray(),dm_tmp[0],1,0,MFInfo());
+            proj.inv_rho[2].define(vmf[Vars::zvel].boxArray(),dm_tmp[0],1,0,MFInfo());
+
+            proj.mlmg = std::make_unique<MLMG>(*proj.mlabec);
+            int max_iter = 100;
+            proj.mlmg->setMaxIter(max_iter);
+
+            proj.mlmg->setVerbose(mg_verbose);
+            proj.mlmg->setBottomVerbose(0);
+        }
+
+        // With constant density the coefficients never change
+        if (!proj.has_coeffs || !solverChoice.constant_density)
+        {
+            BL_PROFILE("ERF::project_velocities::coeffs()");
+            Array<MultiFab,AMREX_SPACEDIM>& inv_rho = proj.inv_rho;
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(density,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                Array4<Real const> const& rho_arr     = density.const_array(mfi);
+                Array4<Real const> const& rho_0_arr   = r_hse.const_array(mfi);
+
+                Box const& bxx = mfi.nodaltilebox(0);
+                Array4<Real      > const& inv_rhox_arr = inv_rho[0].array(mfi);
+                ParallelFor(bxx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i-1,j,k));
+                    inv_rhox_arr(i,j,k) = rho_0_arr(i,j,k) / rho_edge;
+                });
+
+                Box const& bxy = mfi.nodaltilebox(1);
+                Array4<Real      > const& inv_rhoy_arr = inv_rho[1].array(mfi);
+                ParallelFor(bxy, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i,j-1,k));
+                    inv_rhoy_arr(i,j,k) = rho_0_arr(i,j,k) / rho_edge;
+                });
+
+                Box const& bxz = mfi.nodaltilebox(2);
+                Array4<Real      > const& inv_rhoz_arr = inv_rho[2].array(mfi);
+                ParallelFor(bxz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i,j,k-1));
+                    Real rho_0_edge = Real(0.5) * (rho_0_arr(i,j,k) + rho_0_arr(i,j,k-1));
+                    inv_rhoz_arr(i,j,k) = rho_0_edge / rho_edge;
+                });
+            } // mfi
+
+            proj.mlabec->setBCoeffs(0, GetArrOfConstPtrs(inv_rho));
+            proj.has_coeffs = true;
+        }
+
+        // Start from the extrapolation of the last two pressure increments
+        proj.initial_guess(phi[0], l_dt);
+
+        {
+            BL_PROFILE("ERF::project_velocities::solve()");
+            proj.mlmg->solve(GetVecOfPtrs(phi),
+                             GetVecOfConstPtrs(rhs),
+                             solverChoice.poisson_reltol,
+                             solverChoice.poisson_abstol);
+        }
+        if (mg_verbose > 0) {
+            Print() << "Projection at level " << lev << " took " << proj.mlmg->getNumIters()
+                    << " MLMG iterations" << std::endl;
+        }
+
+        // Since b does not include dt, these are the fluxes -(dt rho0/rho) grad(change in pressure)
+        proj.mlmg->getFluxes(GetVecOfArrOfPtrs(fluxes));
+
+        phi[0].mult(1.0/l_dt, 0, 1, 1);
+        proj.save_solution(phi[0]);
+    }
 
     // Update pressure variable with phi -- note that phi is change in pressure, not the full pressure
     MultiFab::Saxpy(pmf, 1.0, phi[0],0,0,1,0);
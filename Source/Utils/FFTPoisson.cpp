@@ -0,0 +1,339 @@
+#include <FFTPoisson.H>
+#include <BatchedTridiagonalSolver.H>
+#include <ERF_Constants.H>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace amrex;
+
+namespace {
+
+/**
+ * Radices of the mixed-radix transform of length n, or an empty list if n has a
+ * prime factor other than 2, 3 and 5
+ */
+Vector<int>
+fft_radices (int n)
+{
+    Vector<int> radix;
+    for (int r : {2, 3, 5}) {
+        while (n > 1 && n % r == 0) {
+            radix.push_back(r);
+            n /= r;
+        }
+    }
+    if (n != 1) radix.clear();
+    return radix;
+}
+
+/**
+ * Twiddle factors and radices of the transforms of length N
+ */
+struct FFTPlan
+{
+    explicit FFTPlan (int a_N)
+        : N(a_N)
+    {
+        Vector<int> r = fft_radices(N);
+        AMREX_ALWAYS_ASSERT(N == 1 || !r.empty());
+        AMREX_ALWAYS_ASSERT(r.size() <= radix.size());
+        nfac = static_cast<int>(r.size());
+        for (int f = 0; f < nfac; ++f) radix[f] = r[f];
+
+        // cos(2 pi n/N) and sin(2 pi n/N) for n = 0..N-1
+        Vector<Real> h_twr(N), h_twi(N);
+        for (int n = 0; n < N; ++n) {
+            h_twr[n] = std::cos(2.0 * PI * n / N);
+            h_twi[n] = std::sin(2.0 * PI * n / N);
+        }
+        twr.resize(N);
+        twi.resize(N);
+        Gpu::copy(Gpu::hostToDevice, h_twr.begin(), h_twr.end(), twr.begin());
+        Gpu::copy(Gpu::hostToDevice, h_twi.begin(), h_twi.end(), twi.begin());
+    }
+
+    int N;
+    int nfac = 0;
+    GpuArray<int,32> radix{};
+    Gpu::DeviceVector<Real> twr, twi;
+};
+
+/**
+ * Unnormalized in-place DFT of every line of (re,im) along dir in bx,
+ *     x(m) <- sum_n x(n) exp(sign 2 pi i m n / N),
+ * with one thread per line.  This is the self-sorting (Stockham) mixed-radix
+ * algorithm: each pass does the radix-r butterflies from one of (re,im) and
+ * the scratch (wre,wim) into the other, and the result is copied back if it
+ * ends up in the scratch.
+ */
+void
+fft_lines (const Box& bx, int dir, int sign, const FFTPlan& plan,
+           const Array4<Real>& re , const Array4<Real>& im,
+           const Array4<Real>& wre, const Array4<Real>& wim)
+{
+    const int N = plan.N;
+    AMREX_ALWAYS_ASSERT(bx.length(dir) == N);
+    if (N == 1) return;
+
+    const int nfac = plan.nfac;
+    const GpuArray<int,32> radix = plan.radix;
+    const Real* twr = plan.twr.data();
+    const Real* twi = plan.twi.data();
+
+    const Long st = (dir == 0) ? Long(1) : ((dir == 1) ? re.jstride : re.kstride);
+    const Real sgn = static_cast<Real>(sign);
+
+    Box lbx = bx;
+    lbx.setBig(dir, bx.smallEnd(dir));
+
+    ParallelFor(lbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        Real* pr = re.ptr(i,j,k);
+        Real* pi = im.ptr(i,j,k);
+        Real* qr = wre.ptr(i,j,k);
+        Real* qi = wim.ptr(i,j,k);
+
+        // Pass f splits the transforms of length n (interleaved with stride s)
+        //    into r transforms of length n/r
+        int n = N;
+        int s = 1;
+        for (int f = 0; f < nfac; ++f) {
+            const int r = radix[f];
+            const int m = n / r;
+            const int rstep = N / r;
+            const int nstep = N / n;
+            for (int p = 0; p < m; ++p) {
+                for (int q = 0; q < s; ++q) {
+                    Real xr[5], xi[5];
+                    for (int t = 0; t < r; ++t) {
+                        const Long a = (q + Long(s)*(p + t*m)) * st;
+                        xr[t] = pr[a];
+                        xi[t] = pi[a];
+                    }
+                    for (int u = 0; u < r; ++u) {
+                        Real yr = 0.0;
+                        Real yi = 0.0;
+                        for (int t = 0; t < r; ++t) {
+                            const int w = ((t*u) % r) * rstep;
+                            const Real cr =       twr[w];
+                            const Real ci = sgn * twi[w];
+                            yr += xr[t]*cr - xi[t]*ci;
+                            yi += xr[t]*ci + xi[t]*cr;
+                        }
+                        const int w = p*u*nstep;
+                        const Real cr =       twr[w];
+                        const Real ci = sgn * twi[w];
+                        const Long b = (q + Long(s)*(r*p + u)) * st;
+                        qr[b] = yr*cr - yi*ci;
+                        qi[b] = yr*ci + yi*cr;
+                    }
+                }
+            }
+            Real* tr = pr; pr = qr; qr = tr;
+            Real* ti = pi; pi = qi; qi = ti;
+            n = m;
+            s *= r;
+        }
+
+        // After an odd number of passes the result is in the scratch
+        if (nfac % 2 == 1) {
+            for (int m = 0; m < N; ++m) {
+                qr[m*st] = pr[m*st];
+                qi[m*st] = pi[m*st];
+            }
+        }
+    });
+}
+
+/**
+ * Pencils spanning the domain in dir, with the other two directions cut into
+ * the most even grid of at most nprocs boxes, one box per rank
+ */
+void
+make_pencils (const Box& domain, int dir, int nprocs, BoxArray& ba, DistributionMapping& dm)
+{
+    const int d1 = (dir == 0) ? 1 : 0;
+    const int d2 = (dir == 2) ? 1 : 2;
+    const int n1 = domain.length(d1);
+    const int n2 = domain.length(d2);
+
+    int p1 = 1;
+    int p2 = 1;
+    for (int q1 = 1; q1 <= std::min(nprocs, n1); ++q1) {
+        const int q2 = std::min(nprocs / q1, n2);
+        if (q1*q2 > p1*p2 || (q1*q2 == p1*p2 && std::abs(q1-q2) < std::abs(p1-p2))) {
+            p1 = q1;
+            p2 = q2;
+        }
+    }
+
+    BoxList bl;
+    Vector<int> pmap;
+    for (int b2 = 0; b2 < p2; ++b2) {
+        for (int b1 = 0; b1 < p1; ++b1) {
+            Box b = domain;
+            b.setSmall(d1, domain.smallEnd(d1) + ( b1   *n1)/p1);
+            b.setBig  (d1, domain.smallEnd(d1) + ((b1+1)*n1)/p1 - 1);
+            b.setSmall(d2, domain.smallEnd(d2) + ( b2   *n2)/p2);
+            b.setBig  (d2, domain.smallEnd(d2) + ((b2+1)*n2)/p2 - 1);
+            bl.push_back(b);
+            pmap.push_back(static_cast<int>(pmap.size()));
+        }
+    }
+    ba = BoxArray(bl);
+    dm = DistributionMapping(pmap);
+}
+
+/**
+ * Transform every line along dir of the (re,im,scratch) MultiFab mf
+ */
+void
+fft_pencils (MultiFab& mf, int dir, int sign, const FFTPlan& plan)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        const Array4<Real>& arr = mf.array(mfi);
+        fft_lines(bx, dir, sign, plan,
+                  Array4<Real>(arr, 0), Array4<Real>(arr, 1),
+                  Array4<Real>(arr, 2), Array4<Real>(arr, 3));
+    }
+}
+
+} // namespace
+
+bool
+fft_poisson_supported (const Box& domain)
+{
+    return (domain.length(0) == 1 || !fft_radices(domain.length(0)).empty()) &&
+           (domain.length(1) == 1 || !fft_radices(domain.length(1)).empty());
+}
+
+void
+solve_poisson_fft (const Geometry& geom,
+                   const Vector<Real>& bh,
+                   const Vector<Real>& bz,
+                   bool dirichlet_lo, bool dirichlet_hi,
+                   const MultiFab& rhs,
+                   MultiFab& phi)
+{
+    BL_PROFILE("solve_poisson_fft()");
+
+    AMREX_ALWAYS_ASSERT(geom.isPeriodic(0) && geom.isPeriodic(1) && !geom.isPeriodic(2));
+
+    const Box& domain = geom.Domain();
+    const int nx = domain.length(0);
+    const int ny = domain.length(1);
+    const int nz = domain.length(2);
+    AMREX_ALWAYS_ASSERT(static_cast<int>(bh.size()) == nz && static_cast<int>(bz.size()) == nz+1);
+
+    AMREX_ALWAYS_ASSERT(fft_poisson_supported(domain));
+
+    // x-, y- and z-pencils, each cut over a 2D grid of ranks in the other two
+    //    directions, so that all ranks take part in every stage
+    const int nprocs = ParallelDescriptor::NProcs();
+    BoxArray ba_x, ba_y, ba_z;
+    DistributionMapping dm_x, dm_y, dm_z;
+    make_pencils(domain, 0, nprocs, ba_x, dm_x);
+    make_pencils(domain, 1, nprocs, ba_y, dm_y);
+    make_pencils(domain, 2, nprocs, ba_z, dm_z);
+
+    const FFTPlan plan_x(nx);
+    const FFTPlan plan_y(ny);
+
+    // Real and imaginary parts, and scratch for the transforms
+    MultiFab xpen(ba_x, dm_x, 4, 0);
+    MultiFab ypen(ba_y, dm_y, 4, 0);
+    MultiFab zpen(ba_z, dm_z, 2, 0);
+
+    xpen.setVal(0.0);
+    xpen.ParallelCopy(rhs, 0, 0, 1);
+    fft_pencils(xpen, 0, -1, plan_x);
+
+    ypen.ParallelCopy(xpen, 0, 0, 2);
+    fft_pencils(ypen, 1, -1, plan_y);
+
+    zpen.ParallelCopy(ypen, 0, 0, 2);
+
+    Gpu::DeviceVector<Real> d_bh(bh.size());
+    Gpu::DeviceVector<Real> d_bz(bz.size());
+    Gpu::copy(Gpu::hostToDevice, bh.begin(), bh.end(), d_bh.begin());
+    Gpu::copy(Gpu::hostToDevice, bz.begin(), bz.end(), d_bz.begin());
+    const Real* p_bh = d_bh.data();
+    const Real* p_bz = d_bz.data();
+
+    const auto dxInv = geom.InvCellSizeArray();
+    const Real dxinv2 = dxInv[0]*dxInv[0];
+    const Real dyinv2 = dxInv[1]*dxInv[1];
+    const Real dzinv2 = dxInv[2]*dxInv[2];
+
+    const int ilo = domain.smallEnd(0);
+    const int jlo = domain.smallEnd(1);
+    const int klo = domain.smallEnd(2);
+    const int khi = domain.bigEnd(2);
+
+    // With zero-gradient conditions on both sides the mean mode is singular
+    const bool pin = !dirichlet_lo && !dirichlet_hi;
+
+    for (MFIter mfi(zpen); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        const Array4<Real>& zpen_arr = zpen.array(mfi);
+        Array4<Real> re(zpen_arr, 0);
+        Array4<Real> im(zpen_arr, 1);
+
+        FArrayBox coeffA(bx, 1, The_Async_Arena());
+        FArrayBox coeffB(bx, 1, The_Async_Arena());
+        FArrayBox coeffC(bx, 1, The_Async_Arena());
+        const Array4<Real>& coeffA_a = coeffA.array();
+        const Array4<Real>& coeffB_a = coeffB.array();
+        const Array4<Real>& coeffC_a = coeffC.array();
+
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const int kk = k - klo;
+
+            // Eigenvalue of the horizontal second difference for this wavenumber
+            Real lam = (2.0*std::cos(2.0*PI*(i-ilo)/nx) - 2.0) * dxinv2
+                     + (2.0*std::cos(2.0*PI*(j-jlo)/ny) - 2.0) * dyinv2;
+
+            Real a = (k > klo) ? p_bz[kk  ] * dzinv2 : 0.0;
+            Real c = (k < khi) ? p_bz[kk+1] * dzinv2 : 0.0;
+            Real b = p_bh[kk] * lam - a - c;
+            if (k == klo && dirichlet_lo) b -= 2.0 * p_bz[0 ] * dzinv2;
+            if (k == khi && dirichlet_hi) b -= 2.0 * p_bz[nz] * dzinv2;
+
+            if (pin && i == ilo && j == jlo && k == klo) {
+                a = 0.0; b = 1.0; c = 0.0;
+                re(i,j,k) = 0.0;
+                im(i,j,k) = 0.0;
+            }
+
+            coeffA_a(i,j,k) = a;
+            coeffB_a(i,j,k) = b;
+            coeffC_a(i,j,k) = c;
+        });
+
+        batched_tridiagonal_factorize(bx, coeffA_a, coeffB_a, coeffC_a);
+
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            coeffB_a(i,j,k) = 1.0 / coeffB_a(i,j,k);
+        });
+
+        // The right-hand side at k is read before the solution at k is written, so solve in place
+        batched_tridiagonal_solve(bx, coeffA_a, coeffB_a, coeffC_a, re, re);
+        batched_tridiagonal_solve(bx, coeffA_a, coeffB_a, coeffC_a, im, im);
+    }
+
+    ypen.ParallelCopy(zpen, 0, 0, 2);
+    fft_pencils(ypen, 1, 1, plan_y);
+
+    xpen.ParallelCopy(ypen, 0, 0, 2);
+    fft_pencils(xpen, 0, 1, plan_x);
+    xpen.mult(1.0 / (Real(nx) * Real(ny)), 0, 1);
+
+    phi.ParallelCopy(xpen, 0, 0, 1);
+
+    // The twiddle factors and coefficients must outlive the kernels that read them
+    Gpu::streamSynchronize();
+}
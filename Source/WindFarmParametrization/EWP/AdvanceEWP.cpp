@@ -6,7 +6,8 @@
 using namespace amrex;
 
 void
-EWP::advance (const Geometry& geom,
+EWP::advance (int /*lev*/,
+              const Geometry& geom,
               const Real& dt_advance,
               MultiFab& cons_in,
               MultiFab& mf_vars_ewp,
@@ -105,14 +106,17 @@ EWP::source_terms_cellcentered (const Geometry& geom,
 
         ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
 
+            // The sources vanish in columns without turbines
+            if (Nturb_array(i,j,k) == 0.0) return;
+
             int kk = amrex::min(amrex::max(k, domlo_z), domhi_z);
             Real z = ProbLoArr[2] + (kk+0.5) * dx[2];
 
             // Compute Fitch source terms
 
-            Real Vabs = std::pow(u_vel(i,j,k)*u_vel(i,j,k) +
-                                 v_vel(i,j,k)*v_vel(i,j,k) +
-                                 w_vel(i,j,kk)*w_vel(i,j,kk), 0.5);
+            Real Vabs = std::sqrt(u_vel(i,j,k)*u_vel(i,j,k) +
+                                  v_vel(i,j,k)*v_vel(i,j,k) +
+                                  w_vel(i,j,kk)*w_vel(i,j,kk));
 
             Real C_T = interpolate_1d(wind_speed_d, thrust_coeff_d, Vabs, n_spec_table);
 
@@ -123,12 +127,16 @@ EWP::source_terms_cellcentered (const Geometry& geom,
             Real sigma_e = Vabs/(3.0*K_turb*L_wake)*
                            (std::pow(2.0*K_turb*L_wake/Vabs + std::pow(sigma_0,2),3.0/2.0) - std::pow(sigma_0,3));
 
-            Real phi     = std::atan2(v_vel(i,j,k),u_vel(i,j,k)); // Wind direction w.r.t the x-dreiction
-            Real fac = -std::pow(PI/8.0,0.5)*C_T*std::pow(d_rotor_rad,2)*
-                        std::pow(Vabs,2)/(dx[0]*dx[1]*sigma_e)*
-                        std::exp(-0.5*std::pow((z - d_hub_height)/sigma_e,2));
-            ewp_array(i,j,k,0) = fac*std::cos(phi)*Nturb_array(i,j,k);
-            ewp_array(i,j,k,1) = fac*std::sin(phi)*Nturb_array(i,j,k);
+            // Wind direction w.r.t the x-direction; cos(phi) = u/|U|, sin(phi) = v/|U|
+            Real Uh = std::sqrt(u_vel(i,j,k)*u_vel(i,j,k) + v_vel(i,j,k)*v_vel(i,j,k));
+            Real cos_phi = (Uh > 0.0) ? u_vel(i,j,k)/Uh : 1.0;
+            Real sin_phi = (Uh > 0.0) ? v_vel(i,j,k)/Uh : 0.0;
+            Real z_fac   = (z - d_hub_height)/sigma_e;
+            Real fac = -std::sqrt(PI/8.0)*C_T*d_rotor_rad*d_rotor_rad*
+                        Vabs*Vabs/(dx[0]*dx[1]*sigma_e)*
+                        std::exp(-0.5*z_fac*z_fac);
+            ewp_array(i,j,k,0) = fac*cos_phi*Nturb_array(i,j,k);
+            ewp_array(i,j,k,1) = fac*sin_phi*Nturb_array(i,j,k);
             ewp_array(i,j,k,2) = C_TKE*0.0;
          });
     }
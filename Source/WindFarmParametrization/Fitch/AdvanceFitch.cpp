@@ -45,7 +45,8 @@ Real compute_Aijk(const Real z_k,
 
 
 void
-Fitch::advance (const Geometry& geom,
+Fitch::advance (int /*lev*/,
+                const Geometry& geom,
                 const Real& dt_advance,
                 MultiFab& cons_in,
                 MultiFab& mf_vars_fitch,
@@ -147,18 +148,22 @@ Fitch::source_terms_cellcentered (const Geometry& geom,
             Real z_k   = kk*dx[2];
             Real z_kp1 = (kk+1)*dx[2];
 
-            Real A_ijk = compute_Aijk(z_k, z_kp1, d_hub_height, d_rotor_rad);
-
             // Compute Fitch source terms
 
-            Real Vabs = std::pow(u_vel(i,j,k)*u_vel(i,j,k) +
-                                 v_vel(i,j,k)*v_vel(i,j,k) +
-                                 w_vel(i,j,kk)*w_vel(i,j,kk), 0.5);
+            Real Vabs = std::sqrt(u_vel(i,j,k)*u_vel(i,j,k) +
+                                  v_vel(i,j,k)*v_vel(i,j,k) +
+                                  w_vel(i,j,kk)*w_vel(i,j,kk));
+
+            fitch_array(i,j,k,0) = Vabs;
+
+            // The sources vanish in columns without turbines
+            if (Nturb_array(i,j,k) == 0.0) return;
+
+            Real A_ijk = compute_Aijk(z_k, z_kp1, d_hub_height, d_rotor_rad);
 
             Real C_T = interpolate_1d(wind_speed_d, thrust_coeff_d, Vabs, n_spec_table);
             Real C_TKE = 0.0;
 
-            fitch_array(i,j,k,0) = Vabs;
             fitch_array(i,j,k,1) =  -0.5*Nturb_array(i,j,k)/(dx[0]*dx[1])*C_T*Vabs*Vabs*A_ijk/(z_kp1 - z_k);
             fitch_array(i,j,k,2) = u_vel(i,j,k)/Vabs*fitch_array(i,j,k,1);
             fitch_array(i,j,k,3) = v_vel(i,j,k)/Vabs*fitch_array(i,j,k,1);
@@ -82,6 +82,9 @@ WindFarm::init_windfarm_lat_lon (const std::string windfarm_loc_table,
     }
     // Vector of vectors to store the matrix
     Vector<Real> lat, lon;
+    // The tables are read again for every level that is made
+    xloc.clear();
+    yloc.clear();
     Real value1, value2, value3;
 
     while (file >> value1 >> value2 >> value3) {
@@ -143,6 +146,9 @@ WindFarm::init_windfarm_x_y (const std::string windfarm_loc_table)
     }
     // Vector of vectors to store the matrix
     Real value1, value2;
+    // The tables are read again for every level that is made
+    xloc.clear();
+    yloc.clear();
 
     while (file >> value1 >> value2) {
         xloc.push_back(value1);
@@ -200,10 +206,71 @@ WindFarm::read_windfarm_spec_table(const std::string windfarm_spec_table)
 
 }
 
+/**
+ * Builds the turbine spatial index of one level and hands it to the model of
+ * that level: for each (i,j) column of the level's domain (and one ghost column
+ * on each side) the list of turbines whose rotor disk may overlap it, i.e. the
+ * column holding the hub in x and every column within the rotor radius in y,
+ * padded by one column against round-off in the per-cell tests.
+ *
+ * @param lev Level the index is built for
+ * @param geom Geometry of that level
+ */
 void
-WindFarm::fill_Nturb_multifab(const Geometry& geom,
+WindFarm::build_turb_index (int lev, const Geometry& geom)
+{
+    const Box& domain = geom.Domain();
+    auto dx        = geom.CellSizeArray();
+    auto ProbLoArr = geom.ProbLoArray();
+
+    int ilo = domain.smallEnd(0) - 1;
+    int jlo = domain.smallEnd(1) - 1;
+    int nx  = domain.length(0) + 2;
+    int ny  = domain.length(1) + 2;
+    int num_turb = xloc.size();
+
+    // Column range of each turbine
+    Vector<int> t_ilo(num_turb), t_ihi(num_turb), t_jlo(num_turb), t_jhi(num_turb);
+    for (int it = 0; it < num_turb; it++) {
+        int ic = static_cast<int>(std::floor((xloc[it] + 1e-12 - ProbLoArr[0]) / dx[0]));
+        t_ilo[it] = std::max(ic - 1, ilo);
+        t_ihi[it] = std::min(ic + 1, ilo + nx - 1);
+        t_jlo[it] = std::max(static_cast<int>(std::floor((yloc[it] - rotor_rad - ProbLoArr[1]) / dx[1])) - 1, jlo);
+        t_jhi[it] = std::min(static_cast<int>(std::floor((yloc[it] + rotor_rad - ProbLoArr[1]) / dx[1])) + 1, jlo + ny - 1);
+    }
+
+    // Count, then fill in turbine order
+    Vector<int> offsets(nx*ny + 1, 0);
+    for (int it = 0; it < num_turb; it++) {
+        for (int j = t_jlo[it]; j <= t_jhi[it]; j++) {
+            for (int i = t_ilo[it]; i <= t_ihi[it]; i++) {
+                offsets[(j-jlo)*nx + (i-ilo) + 1]++;
+            }
+        }
+    }
+    for (int c = 0; c < nx*ny; c++) {
+        offsets[c+1] += offsets[c];
+    }
+
+    Vector<int> ids(offsets[nx*ny]);
+    Vector<int> fill(offsets.begin(), offsets.end()-1);
+    for (int it = 0; it < num_turb; it++) {
+        for (int j = t_jlo[it]; j <= t_jhi[it]; j++) {
+            for (int i = t_ilo[it]; i <= t_ihi[it]; i++) {
+                ids[fill[(j-jlo)*nx + (i-ilo)]++] = it;
+            }
+        }
+    }
+
+    m_windfarm_model[lev]->set_turb_index(offsets, ids, ilo, jlo, nx, ny);
+}
+
+void
+WindFarm::fill_Nturb_multifab(int lev,
+                              const Geometry& geom,
                               MultiFab& mf_Nturb)
 {
+    build_turb_index(lev, geom);
 
     amrex::Gpu::DeviceVector<Real> d_xloc(xloc.size());
     amrex::Gpu::DeviceVector<Real> d_yloc(yloc.size());
@@ -219,7 +286,7 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
     int j_lo = geom.Domain().smallEnd(1); int j_hi = geom.Domain().bigEnd(1);
     auto dx = geom.CellSizeArray();
     auto ProbLoArr = geom.ProbLoArray();
-    int num_turb = xloc.size();
+    const TurbineIndex turb_index = m_windfarm_model[lev]->get_turb_index();
 
      // Initialize wind farm
     for ( MFIter mfi(mf_Nturb,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
@@ -234,7 +301,11 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
             Real y1 = ProbLoArr[1] + lj*dx[1];
             Real y2 = ProbLoArr[1] + (lj+1)*dx[1];
 
-            for(int it=0; it<num_turb; it++){
+            // Only the turbines that can touch this column
+            int t_begin, t_end;
+            turb_index.range(li, lj, t_begin, t_end);
+            for(int n=t_begin; n<t_end; n++){
+                int it = turb_index.ids[n];
                 if( d_xloc_ptr[it]+1e-12 > x1 and d_xloc_ptr[it]+1e-12 < x2 and
                     d_yloc_ptr[it]+1e-12 > y1 and d_yloc_ptr[it]+1e-12 < y2){
                        Nturb_array(i,j,k,0) = Nturb_array(i,j,k,0) + 1;
@@ -1,10 +1,12 @@
 #include <SimpleAD.H>
 #include <IndexDefines.H>
+#include <Interpolation_1D.H>
 
 using namespace amrex;
 
 void
-SimpleAD::advance (const Geometry& geom,
+SimpleAD::advance (int /*lev*/,
+                  const Geometry& geom,
                   const Real& dt_advance,
                   MultiFab& cons_in,
                   MultiFab& mf_vars_simpleAD,
@@ -15,6 +17,9 @@ SimpleAD::advance (const Geometry& geom,
 {
     AMREX_ALWAYS_ASSERT(W_old.nComp() > 0);
     AMREX_ALWAYS_ASSERT(mf_Nturb.nComp() > 0);
+    if (m_disk_average || m_track_power) {
+        compute_disk_sums(geom, cons_in, U_old, V_old);
+    }
     source_terms_cellcentered(geom, cons_in, mf_vars_simpleAD , U_old, V_old);
     update(dt_advance, cons_in, U_old, V_old, mf_vars_simpleAD);
 }
@@ -47,6 +52,118 @@ SimpleAD::update (const Real& dt_advance,
     }
 }
 
+/**
+ * Disk averages of the inflow of every turbine. The sums over the cells of each
+ * disk (u dA, v dA, dA) are accumulated in one sweep over the tiles that touch a
+ * disk and then reduced over all ranks with a single all-reduce.
+ * The disk-averaged speed also gives the power of each turbine from the power curve.
+ *
+ * @param geom Geometry of the level
+ * @param cons_in Conserved state, for the tiling
+ * @param U_old X-velocity
+ * @param V_old Y-velocity
+ */
+void
+SimpleAD::compute_disk_sums (const Geometry& geom,
+                             const MultiFab& cons_in,
+                             const MultiFab& U_old,
+                             const MultiFab& V_old)
+{
+    BL_PROFILE("SimpleAD::compute_disk_sums()");
+
+    get_turb_loc(xloc, yloc);
+    get_turb_spec(rotor_rad, hub_height, thrust_coeff_standing,
+                  wind_speed, thrust_coeff, power);
+
+    const int nturbs = xloc.size();
+    constexpr int nsum = 3;
+
+    auto dx = geom.CellSizeArray();
+    auto ProbLoArr = geom.ProbLoArray();
+
+    // Index-space bounding boxes of the disks, to skip the tiles that cannot touch one
+    BoxList disk_bl;
+    for (int it = 0; it < nturbs; it++) {
+        IntVect lo(static_cast<int>(std::floor((xloc[it] + 1e-12 - ProbLoArr[0]) / dx[0])) - 1,
+                   static_cast<int>(std::floor((yloc[it] - rotor_rad - ProbLoArr[1]) / dx[1])) - 1,
+                   static_cast<int>(std::floor((hub_height - rotor_rad - ProbLoArr[2]) / dx[2])) - 1);
+        IntVect hi(lo[0] + 2,
+                   static_cast<int>(std::floor((yloc[it] + rotor_rad - ProbLoArr[1]) / dx[1])) + 1,
+                   static_cast<int>(std::floor((hub_height + rotor_rad - ProbLoArr[2]) / dx[2])) + 1);
+        disk_bl.push_back(Box(lo,hi));
+    }
+    BoxArray disk_ba(disk_bl);
+
+    Gpu::DeviceVector<Real> d_sums(nturbs*nsum, 0.0);
+    Real* sums = d_sums.data();
+
+    Gpu::DeviceVector<Real> d_xloc(xloc.size());
+    Gpu::DeviceVector<Real> d_yloc(yloc.size());
+    Gpu::copy(Gpu::hostToDevice, xloc.begin(), xloc.end(), d_xloc.begin());
+    Gpu::copy(Gpu::hostToDevice, yloc.begin(), yloc.end(), d_yloc.begin());
+    const Real* d_xloc_ptr = d_xloc.data();
+    const Real* d_yloc_ptr = d_yloc.data();
+
+    Real d_rotor_rad  = rotor_rad;
+    Real d_hub_height = hub_height;
+    Real dA = dx[1]*dx[2];
+    const TurbineIndex turb_index = m_turb_index;
+
+    for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+        const Box& tbx = mfi.tilebox();
+        if (disk_ba.empty() || !disk_ba.intersects(tbx)) continue;
+
+        auto u_vel = U_old.const_array(mfi);
+        auto v_vel = V_old.const_array(mfi);
+
+        ParallelFor(tbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            Real x1 = ProbLoArr[0] + i     * dx[0];
+            Real x2 = ProbLoArr[0] + (i+1) * dx[0];
+
+            Real y = ProbLoArr[1] + (j+0.5) * dx[1];
+            Real z = ProbLoArr[2] + (k+0.5) * dx[2];
+
+            int t_begin, t_end;
+            turb_index.range(i, j, t_begin, t_end);
+            for(int n=t_begin; n<t_end; n++){
+                int it = turb_index.ids[n];
+                if(d_xloc_ptr[it]+1e-12 > x1 and d_xloc_ptr[it]+1e-12 < x2) {
+                   Real dy_turb = y - d_yloc_ptr[it];
+                   Real dz_turb = z - d_hub_height;
+                   if(dy_turb*dy_turb + dz_turb*dz_turb < d_rotor_rad*d_rotor_rad) {
+                       Gpu::Atomic::Add(&sums[it*nsum  ], u_vel(i,j,k)*dA);
+                       Gpu::Atomic::Add(&sums[it*nsum+1], v_vel(i,j,k)*dA);
+                       Gpu::Atomic::Add(&sums[it*nsum+2], dA);
+                    }
+                }
+            }
+        });
+    }
+
+    // One collective for all the turbines
+    Vector<Real> h_sums(nturbs*nsum);
+    Gpu::copy(Gpu::deviceToHost, d_sums.begin(), d_sums.end(), h_sums.begin());
+    ParallelDescriptor::ReduceRealSum(h_sums.data(), h_sums.size());
+
+    Vector<Real> h_disk_uv(2*nturbs, 0.0);
+    m_turb_power.resize(nturbs);
+    for (int it = 0; it < nturbs; it++) {
+        Real area = h_sums[it*nsum+2];
+        if (area > 0.0) {
+            h_disk_uv[2*it  ] = h_sums[it*nsum  ] / area;
+            h_disk_uv[2*it+1] = h_sums[it*nsum+1] / area;
+        }
+        Real Uh = std::sqrt(h_disk_uv[2*it]*h_disk_uv[2*it] + h_disk_uv[2*it+1]*h_disk_uv[2*it+1]);
+        // The power curve is in kW
+        m_turb_power[it] = (Uh > 0.0) ?
+            1000.0*amrex::max(Real(0.0), interpolate_1d(wind_speed.data(), power.data(), Uh, wind_speed.size())) : 0.0;
+    }
+
+    m_disk_uv.resize(2*nturbs);
+    Gpu::copy(Gpu::hostToDevice, h_disk_uv.begin(), h_disk_uv.end(), m_disk_uv.begin());
+}
+
 void
 SimpleAD::source_terms_cellcentered (const Geometry& geom,
                                      const MultiFab& cons_in,
@@ -85,7 +202,11 @@ SimpleAD::source_terms_cellcentered (const Geometry& geom,
 
       Real* d_xloc_ptr = d_xloc.data();
       Real* d_yloc_ptr = d_yloc.data();
-      long unsigned int nturbs = xloc.size();
+      const TurbineIndex turb_index = m_turb_index;
+
+      // With disk averaging the thrust and direction come from the turbine's inflow
+      bool disk_average = m_disk_average;
+      const Real* disk_uv = (disk_average) ? m_disk_uv.data() : nullptr;
 
     for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
@@ -107,17 +228,20 @@ SimpleAD::source_terms_cellcentered (const Geometry& geom,
 
             // Compute Simple AD source terms
 
-            Real phi = std::atan2(v_vel(i,j,k),u_vel(i,j,k)); // Wind direction w.r.t the x-dreiction
-
-            Real fac = 0.0;
-
             int check_int = 0;
+            int it_disk   = -1;
 
-            for(long unsigned int it=0;it<nturbs;it++){
+            // Only the turbines whose disk can overlap this column
+            int t_begin, t_end;
+            turb_index.range(ii, jj, t_begin, t_end);
+            for(int n=t_begin; n<t_end; n++){
+                int it = turb_index.ids[n];
                 if(d_xloc_ptr[it]+1e-12 > x1 and d_xloc_ptr[it]+1e-12 < x2) {
-                   if(std::pow((y-d_yloc_ptr[it])*(y-d_yloc_ptr[it]) + (z-d_hub_height)*(z-d_hub_height),0.5) < d_rotor_rad) {
+                   Real dy_turb = y - d_yloc_ptr[it];
+                   Real dz_turb = z - d_hub_height;
+                   if(dy_turb*dy_turb + dz_turb*dz_turb < d_rotor_rad*d_rotor_rad) {
                         check_int++;
-                        fac = -2.0*std::pow(u_vel(i,j,k)*std::cos(phi) + v_vel(i,j,k)*std::sin(phi), 2.0)*0.5*(1.0-0.5);
+                        it_disk = it;
                     }
                 }
             }
@@ -126,8 +250,23 @@ SimpleAD::source_terms_cellcentered (const Geometry& geom,
                              "and check the windturbine locations input file. Exiting..");
             }
 
-            simpleAD_array(i,j,k,0) = fac*std::cos(phi);
-            simpleAD_array(i,j,k,1) = fac*std::sin(phi);
+            // Wind direction w.r.t the x-direction; cos(phi) = u/|U|, sin(phi) = v/|U|
+            Real fac = 0.0;
+            Real cos_phi = 1.0;
+            Real sin_phi = 0.0;
+            if(check_int > 0){
+                Real u_in = (disk_average) ? disk_uv[2*it_disk  ] : u_vel(i,j,k);
+                Real v_in = (disk_average) ? disk_uv[2*it_disk+1] : v_vel(i,j,k);
+                Real Uh = std::sqrt(u_in*u_in + v_in*v_in);
+                if(Uh > 0.0){
+                    cos_phi = u_in/Uh;
+                    sin_phi = v_in/Uh;
+                }
+                fac = -2.0*Uh*Uh*0.5*(1.0-0.5);
+            }
+
+            simpleAD_array(i,j,k,0) = fac*cos_phi;
+            simpleAD_array(i,j,k,1) = fac*sin_phi;
          });
     }
 }
@@ -6,6 +6,7 @@
 
 //#include "IO.H"
 #include "ERF.H"
+#include "ERF_CompressedPlotfile.H"
 
 #ifdef ERF_USE_MULTIBLOCK
 #include <MultiBlockContainer.H>
@@ -215,6 +216,16 @@ int main (int argc, char* argv[])
         mbc.AdvanceBlocks();
     }
 #else
+    std::string compressed_plotfile;
+    ParmParse pp_erf("erf");
+    if (pp_erf.query("decompress_plotfile", compressed_plotfile))
+    {
+        // Only convert a compressed plotfile into a native one, e.g. for fcompare
+        std::string native_plotfile = compressed_plotfile + "_native";
+        pp_erf.query("decompressed_plotfile", native_plotfile);
+        DecompressPlotfile(compressed_plotfile, native_plotfile);
+    }
+    else
     {
         // constructor - reads in parameters from inputs file
         //             - sizes multilevel arrays and data structures
@@ -33,15 +33,8 @@ macro(setup_test)
 
 endmacro(setup_test)
 
-# Standard regression test
-function(add_test_r TEST_NAME TEST_EXE PLTFILE)
-    setup_test()
-
-    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
-    set(FCOMPARE_TOLERANCE "-r 2e-10 --abs_tol 2.0e-10")
-    set(FCOMPARE_FLAGS "--abort_if_not_all_found -a ${FCOMPARE_TOLERANCE}")
-    set(test_command sh -c "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && ${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${PLOT_GOLD} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
-
+# Add TEST_NAME, running test_command in the test directory, with the properties shared by all tests
+macro(add_regression_test)
     add_test(${TEST_NAME} ${test_command})
     set_tests_properties(${TEST_NAME}
         PROPERTIES
@@ -51,6 +44,31 @@ function(add_test_r TEST_NAME TEST_EXE PLTFILE)
         LABELS "regression"
         ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.log"
     )
+endmacro(add_regression_test)
+
+# Set test_command to run INPUTS, check its log with LOG_CHECK, run INPUTS again with REF_OPTIONS writing
+# the ref* plotfiles, run POST_REF (empty, or commands ending in "&& "), and compare the ref* counterpart of
+# PLTFILE with COMPARED_FILE to TOLERANCE.  Outputs of an earlier run are removed first.
+macro(setup_compare_command LOG_CHECK REF_OPTIONS POST_REF COMPARED_FILE)
+    string(REPLACE "plt" "ref" REFFILE ${PLTFILE})
+    set(FCOMPARE_FLAGS "--abort_if_not_all_found -a ${TOLERANCE}")
+    set(test_command sh -c "rm -rf plt* ref* && \
+${MPI_COMMANDS} ${TEST_EXE} ${INPUTS} ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && \
+${LOG_CHECK} && \
+${MPI_COMMANDS} ${TEST_EXE} ${INPUTS} ${REF_OPTIONS} erf.plot_file_1=ref ${RUNTIME_OPTIONS} > ${TEST_NAME}_ref.log && \
+${POST_REF}${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${CURRENT_TEST_BINARY_DIR}/${REFFILE} ${CURRENT_TEST_BINARY_DIR}/${COMPARED_FILE}")
+endmacro(setup_compare_command)
+
+# Standard regression test
+function(add_test_r TEST_NAME TEST_EXE PLTFILE)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(FCOMPARE_TOLERANCE "-r 2e-10 --abs_tol 2.0e-10")
+    set(FCOMPARE_FLAGS "--abort_if_not_all_found -a ${FCOMPARE_TOLERANCE}")
+    set(test_command sh -c "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && ${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${PLOT_GOLD} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
+
+    add_regression_test()
 endfunction(add_test_r)
 
 # Debug regression test with lower tolerance
@@ -62,17 +80,124 @@ function(add_test_d TEST_NAME TEST_EXE PLTFILE)
     set(FCOMPARE_FLAGS "--abort_if_not_all_found -a ${FCOMPARE_TOLERANCE}")
     set(test_command sh -c "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && ${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${PLOT_GOLD} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
 
-    add_test(${TEST_NAME} ${test_command})
-    set_tests_properties(${TEST_NAME}
-        PROPERTIES
-        TIMEOUT 5400
-        PROCESSORS ${NP}
-        WORKING_DIRECTORY "${CURRENT_TEST_BINARY_DIR}/"
-        LABELS "regression"
-        ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.log"
-    )
+    add_regression_test()
 endfunction(add_test_d)
     
+# Regression test of an alternate code path -- compare with the gold file of an existing test
+function(add_test_g TEST_NAME GOLD_NAME TEST_EXE PLTFILE)
+    setup_test()
+    set(PLOT_GOLD ${FCOMPARE_GOLD_FILES_DIRECTORY}/${GOLD_NAME})
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(FCOMPARE_TOLERANCE "-r 2e-10 --abs_tol 2.0e-10")
+    set(FCOMPARE_FLAGS "--abort_if_not_all_found -a ${FCOMPARE_TOLERANCE}")
+    set(test_command sh -c "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && ${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${PLOT_GOLD} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
+
+    add_regression_test()
+endfunction(add_test_g)
+
+# Comparison of two runs of the same inputs -- the second adds REF_OPTIONS and writes the ref* plotfiles.
+# The log of the first run must match LOG_REGEX, e.g. to check that the code path under test was taken.
+function(add_test_c TEST_NAME TEST_EXE PLTFILE TOLERANCE REF_OPTIONS LOG_REGEX)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(INPUTS ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i)
+    setup_compare_command("grep -E -q '${LOG_REGEX}' ${TEST_NAME}.log" "${REF_OPTIONS}" "" ${PLTFILE})
+
+    add_regression_test()
+endfunction(add_test_c)
+
+# Log test -- run and check that the log matches LOG_REGEX, e.g. the choices made by an adaptive algorithm.
+# An optional fourth argument names an output file of the run to check instead of the log.
+function(add_test_l TEST_NAME TEST_EXE LOG_REGEX)
+    setup_test()
+
+    set(LOG_FILE ${TEST_NAME}.log)
+    if(ARGC GREATER 3)
+        set(LOG_FILE ${ARGV3})
+    endif()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(test_command sh -c "rm -f ${LOG_FILE} && ${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && grep -E -q '${LOG_REGEX}' ${LOG_FILE}")
+
+    add_regression_test()
+endfunction(add_test_l)
+
+# Scripted comparison of two runs -- the second adds REF_OPTIONS and writes ref* files instead of plt*.
+# CHECK_COMMAND is then run in the test directory; outputs of an earlier run are removed first.
+function(add_test_s TEST_NAME TEST_EXE REF_OPTIONS CHECK_COMMAND)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(test_command sh -c "rm -rf plt* ref* && ${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && ${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${REF_OPTIONS} erf.plot_file_1=ref ${RUNTIME_OPTIONS} > ${TEST_NAME}_ref.log && ${CHECK_COMMAND}")
+
+    add_regression_test()
+endfunction(add_test_s)
+
+# Boundary plane round trip -- TEST_NAME.i writes the planes in the container format, and is restarted
+# from chk00006 with RESTART_OPTIONS so that the container holds the later steps twice; the same two runs then
+# write the native format.  TEST_NAME_read.i reads each set, and the two plotfiles must agree exactly.
+function(add_test_b TEST_NAME TEST_EXE PLTFILE RESTART_OPTIONS)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    string(REPLACE "plt" "ref" REFFILE ${PLTFILE})
+    set(WRITER ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i)
+    set(READER ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}_read.i)
+    set(NATIVE_OPTIONS "erf.bndry_output_format=native erf.bndry_output_planes_file=bndry_native")
+    set(FCOMPARE_FLAGS "--abort_if_not_all_found -a -r 0.0 --abs_tol 0.0")
+    set(test_command sh -c "rm -rf plt* ref* chk* bndry_* && \
+${MPI_COMMANDS} ${TEST_EXE} ${WRITER} ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && \
+${MPI_COMMANDS} ${TEST_EXE} ${WRITER} erf.restart=chk00006 ${RESTART_OPTIONS} ${RUNTIME_OPTIONS} >> ${TEST_NAME}.log && \
+rm -rf chk* && \
+${MPI_COMMANDS} ${TEST_EXE} ${WRITER} ${NATIVE_OPTIONS} ${RUNTIME_OPTIONS} >> ${TEST_NAME}.log && \
+${MPI_COMMANDS} ${TEST_EXE} ${WRITER} erf.restart=chk00006 ${RESTART_OPTIONS} ${NATIVE_OPTIONS} ${RUNTIME_OPTIONS} >> ${TEST_NAME}.log && \
+${MPI_COMMANDS} ${TEST_EXE} ${READER} erf.bndry_file=bndry_container ${RUNTIME_OPTIONS} > ${TEST_NAME}_read.log && \
+${MPI_COMMANDS} ${TEST_EXE} ${READER} erf.bndry_file=bndry_native erf.plot_file_1=ref ${RUNTIME_OPTIONS} > ${TEST_NAME}_ref.log && \
+${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${CURRENT_TEST_BINARY_DIR}/${REFFILE} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
+
+    add_regression_test()
+endfunction(add_test_b)
+
+# Compressed plotfile test -- TEST_NAME.i writes compressed plotfiles, and their compression ratios are
+# printed; erf.decompress_plotfile turns PLTFILE into a native plotfile, which must agree to TOLERANCE with
+# the native ref* plotfile of a second run.
+function(add_test_z TEST_NAME TEST_EXE PLTFILE TOLERANCE)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(INPUTS ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i)
+    setup_compare_command("grep 'compression ratio' ${TEST_NAME}.log" "erf.plotfile_type=amrex"
+        "${MPI_COMMANDS} ${TEST_EXE} ${INPUTS} erf.decompress_plotfile=${PLTFILE} > ${TEST_NAME}_decompress.log && "
+        ${PLTFILE}_native)
+
+    add_regression_test()
+endfunction(add_test_z)
+
+# NetCDF checkpoint round trip -- TEST_NAME.i writes NetCDF checkpoints and is restarted from CHKFILE, first with
+# erf.nc_parallel_io=false throughout, writing the ref* plotfiles, then with erf.nc_parallel_io=true throughout.
+# The two restarts must end with the same PLTFILE.
+function(add_test_n TEST_NAME TEST_EXE PLTFILE CHKFILE)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    string(REPLACE "plt" "ref" REFFILE ${PLTFILE})
+    set(INPUTS ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i)
+    set(SERIAL_OPTIONS "erf.nc_parallel_io=false")
+    set(PARALLEL_OPTIONS "erf.nc_parallel_io=true")
+    set(FCOMPARE_FLAGS "--abort_if_not_all_found -a -r 0.0 --abs_tol 0.0")
+    set(test_command sh -c "rm -rf plt* ref* chk* && \
+${MPI_COMMANDS} ${TEST_EXE} ${INPUTS} ${SERIAL_OPTIONS} ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && \
+${MPI_COMMANDS} ${TEST_EXE} ${INPUTS} erf.restart=${CHKFILE} ${SERIAL_OPTIONS} erf.plot_file_1=ref ${RUNTIME_OPTIONS} >> ${TEST_NAME}.log && \
+rm -rf plt* chk* && \
+${MPI_COMMANDS} ${TEST_EXE} ${INPUTS} ${PARALLEL_OPTIONS} ${RUNTIME_OPTIONS} > ${TEST_NAME}_par.log && \
+${MPI_COMMANDS} ${TEST_EXE} ${INPUTS} erf.restart=${CHKFILE} ${PARALLEL_OPTIONS} ${RUNTIME_OPTIONS} >> ${TEST_NAME}_par.log && \
+${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${CURRENT_TEST_BINARY_DIR}/${REFFILE} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
+
+    add_regression_test()
+endfunction(add_test_n)
+
 # Stationary test -- compare with time 0
 function(add_test_0 TEST_NAME TEST_EXE PLTFILE)
     setup_test()
@@ -82,15 +207,7 @@ function(add_test_0 TEST_NAME TEST_EXE PLTFILE)
     set(FCOMPARE_FLAGS "-a ${FCOMPARE_TOLERANCE}")
     set(test_command sh -c "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i erf.input_sounding_file=${CURRENT_TEST_BINARY_DIR}/input_sounding ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${CURRENT_TEST_BINARY_DIR}/plt00000 ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
 
-    add_test(${TEST_NAME} ${test_command})
-    set_tests_properties(${TEST_NAME}
-        PROPERTIES
-        TIMEOUT 5400
-        PROCESSORS ${NP}
-        WORKING_DIRECTORY "${CURRENT_TEST_BINARY_DIR}/"
-        LABELS "regression"
-        ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.log"
-    )
+    add_regression_test()
 endfunction(add_test_0)
 
 #=============================================================================
@@ -100,12 +217,16 @@ if(WIN32)
 #add_test_r(Bubble_DensityCurrent             "Bubble/bubble.exe" "plt00010")
 add_test_r(CouetteFlow                       "RegTests/Couette_Poiseuille/*/erf_couette_poiseuille.exe" "plt00050")
 add_test_r(DensityCurrent                    "RegTests/DensityCurrent/*/erf_density_current.exe" "plt00010")
+add_test_g(DensityCurrent_fused              DensityCurrent "RegTests/DensityCurrent/*/erf_density_current.exe" "plt00010")
+add_test_c(DensityCurrent_reuse              "RegTests/DensityCurrent/*/erf_density_current.exe" "plt00010" "-r 1e-4 --abs_tol 1.0e-4" "erf.reuse_fast_coeffs=false" "reused [1-9]")
+add_test_l(DensityCurrent_adaptive           "RegTests/DensityCurrent/*/erf_density_current.exe" "RK stages 1/2/3: 1 [1-9][0-9]* [1-9][0-9]+ ")
 add_test_r(DensityCurrent_detJ2              "RegTests/DensityCurrent/*/erf_density_current.exe" "plt00010")
 add_test_r(DensityCurrent_detJ2_nosub        "RegTests/DensityCurrent/*/erf_density_current.exe" "plt00020")
 add_test_r(DensityCurrent_detJ2_MT           "RegTests/DensityCurrent/*/erf_density_current.exe" "plt00010")
 add_test_r(EkmanSpiral                       "RegTests/EkmanSpiral/*/erf_ekman_spiral.exe" "plt00010")
 add_test_r(IsentropicVortexStationary        "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "plt00010")
 add_test_r(IsentropicVortexAdvecting         "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "plt00010")
+add_test_s(SamplerGroups                     "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "amr.max_grid_size=64 erf.towers.file=ref_towers.bin erf.beam.file=ref_beam.bin" "python3 check_sampler.py 1e-12 plt_towers.bin ref_towers.bin plt_beam.bin ref_beam.bin")
 add_test_r(IVA_NumDiff                       "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "plt00010")
 add_test_r(MovingTerrain_nosub               "DevTests/MovingTerrain/*/erf_moving_terrain.exe"   "plt00020")
 add_test_r(MovingTerrain_sub                 "DevTests/MovingTerrain/*/erf_moving_terrain.exe"   "plt00010")
@@ -127,25 +248,53 @@ add_test_r(ScalarDiffusionGaussian           "RegTests/ScalarAdvDiff/*/erf_scala
 add_test_r(ScalarDiffusionSine               "RegTests/ScalarAdvDiff/*/erf_scalar_advdiff.exe" "plt00020")
 add_test_r(TaylorGreenAdvecting              "RegTests/TaylorGreenVortex/*/erf_taylor_green.exe" "plt00010")
 add_test_r(TaylorGreenAdvectingDiffusing     "RegTests/TaylorGreenVortex/*/erf_taylor_green.exe" "plt00010")
+add_test_c(TaylorGreen_async                 "RegTests/TaylorGreenVortex/*/erf_taylor_green.exe" "plt00010" "-r 0.0 --abs_tol 0.0" "erf.async_fill_boundary=false" "async_fill_boundary *: 1")
 add_test_r(MSF_NoSub_IsentropicVortexAdv     "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "plt00010")
 add_test_r(MSF_Sub_IsentropicVortexAdv       "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "plt00010")
 add_test_r(ABL_MOST                          "ABL/*/erf_abl.exe" "plt00010")
+add_test_c(ABL_MOST_warm                     "ABL/*/erf_abl.exe" "plt00010" "-r 1e-5 --abs_tol 1.0e-5" "erf.most.warm_start=false erf.most.fixed_iters=0" "\\(land\\) after 3 iterations: .*columns above 1e-05: 0 of 4096")
 add_test_r(ABL_MYNN_PBL                      "ABL/*/erf_abl.exe" "plt00100")
 add_test_r(ABL_InflowFile                    "ABL/*/erf_abl.exe" "plt00010")
+add_test_b(BndryPlanes_container             "ABL/*/erf_abl.exe" "plt00008" "erf.Cs=0.2")
+add_test_z(CompressedPlotfile                "ABL/*/erf_abl.exe" "plt00010" "-r 0.0 --abs_tol 0.0")
+add_test_z(CompressedPlotfile_quantized      "ABL/*/erf_abl.exe" "plt00010" "-r 2.0e-6 --abs_tol 5.0e-4")
 add_test_r(MoistBubble                       "RegTests/Bubble/*/erf_bubble.exe" "plt00010")
+add_test_c(MoistBubble_trimmed               "RegTests/Bubble/*/erf_bubble.exe" "plt00010" "-r 0.0 --abs_tol 0.0" "erf.trim_mri_memory=false" "trim_mri_memory *: 1")
+add_test_s(MoistBubble_sediment_zsplit       "RegTests/Bubble/*/erf_bubble.exe" "amr.max_grid_size=256" "python3 check_water.py 1e-8 MoistBubble_sediment_zsplit.log MoistBubble_sediment_zsplit_ref.log")
+add_test_s(MoistBubble_sediment_substeps     "RegTests/Bubble/*/erf_bubble.exe" "amr.max_grid_size=256" "python3 check_water.py 1e-8 MoistBubble_sediment_substeps.log MoistBubble_sediment_substeps_ref.log && ${FEXTREMA_EXE} plt00010 > extrema.txt && python3 check_positive.py extrema.txt qv qc qp rain_accum")
 
 add_test_0(Deardorff_stationary              "ABL/*/erf_abl.exe" "plt00010")
 
+if(ERF_ENABLE_WINDFARM)
+add_test_l(SimpleAD_disk_average             "SimpleActuatorDisk/*/erf_simple_actuator_disk.exe" "^ *0 1000000 1000000$" "turbine_power.txt")
+add_test_s(SimpleAD_power                    "SimpleActuatorDisk/*/erf_simple_actuator_disk.exe" "erf.windfarm_disk_average=false erf.windfarm_power_log=ref_power.txt" "python3 check_power.py 1500000 plt_power.txt ref_power.txt")
+add_test_c(WindFarm_Fitch                    "EWP/*/erf_fitch.exe" "plt00010" "-r 1e-12 --abs_tol 1.0e-12" "amr.max_grid_size=64" "Reading wind turbine locations table")
+add_test_c(WindFarm_EWP                      "EWP/*/erf_fitch.exe" "plt00010" "-r 1e-12 --abs_tol 1.0e-12" "amr.max_grid_size=64" "Reading wind turbine locations table")
+endif()
+
+if(ERF_ENABLE_POISSON_SOLVE)
+add_test_c(FFTPoisson_vs_MLMG                "ABL/*/erf_abl.exe" "plt00010" "-r 1e-8 --abs_tol 1.0e-8" "erf.use_fft_poisson=false" "Projection at level 0 solved with FFTs")
+add_test_c(Projection_reuse                  "ABL/*/erf_abl.exe" "plt00010" "-r 1e-8 --abs_tol 1.0e-8" "erf.reuse_projection_solver=false" "Projection at level 0 took [0-9]+ MLMG iterations")
+endif()
+
+if(ERF_ENABLE_NETCDF AND ERF_ENABLE_MPI)
+add_test_n(IsentropicVortex_ncchk             "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "plt00010" "chk00005")
+endif()
+
 else()
 #add_test_r(Bubble_DensityCurrent             "Bubble/bubble" "plt00010")
 add_test_r(CouetteFlow                       "RegTests/Couette_Poiseuille/erf_couette_poiseuille" "plt00050")
 add_test_r(DensityCurrent                    "RegTests/DensityCurrent/erf_density_current" "plt00010")
+add_test_g(DensityCurrent_fused              DensityCurrent "RegTests/DensityCurrent/erf_density_current" "plt00010")
+add_test_c(DensityCurrent_reuse              "RegTests/DensityCurrent/erf_density_current" "plt00010" "-r 1e-4 --abs_tol 1.0e-4" "erf.reuse_fast_coeffs=false" "reused [1-9]")
+add_test_l(DensityCurrent_adaptive           "RegTests/DensityCurrent/erf_density_current" "RK stages 1/2/3: 1 [1-9][0-9]* [1-9][0-9]+ ")
 add_test_r(DensityCurrent_detJ2              "RegTests/DensityCurrent/erf_density_current" "plt00010")
 add_test_r(DensityCurrent_detJ2_nosub        "RegTests/DensityCurrent/erf_density_current" "plt00020")
 add_test_r(DensityCurrent_detJ2_MT           "RegTests/DensityCurrent/erf_density_current" "plt00010")
 add_test_r(EkmanSpiral                       "RegTests/EkmanSpiral/erf_ekman_spiral" "plt00010")
 add_test_r(IsentropicVortexStationary        "RegTests/IsentropicVortex/erf_isentropic_vortex" "plt00010")
 add_test_r(IsentropicVortexAdvecting         "RegTests/IsentropicVortex/erf_isentropic_vortex" "plt00010")
+add_test_s(SamplerGroups                     "RegTests/IsentropicVortex/erf_isentropic_vortex" "amr.max_grid_size=64 erf.towers.file=ref_towers.bin erf.beam.file=ref_beam.bin" "python3 check_sampler.py 1e-12 plt_towers.bin ref_towers.bin plt_beam.bin ref_beam.bin")
 add_test_r(IVA_NumDiff                       "RegTests/IsentropicVortex/erf_isentropic_vortex" "plt00010")
 add_test_r(MovingTerrain_nosub               "DevTests/MovingTerrain/erf_moving_terrain"   "plt00020")
 add_test_r(MovingTerrain_sub                 "DevTests/MovingTerrain/erf_moving_terrain"   "plt00010")
@@ -167,15 +316,39 @@ add_test_r(ScalarDiffusionGaussian           "RegTests/ScalarAdvDiff/erf_scalar_
 add_test_r(ScalarDiffusionSine               "RegTests/ScalarAdvDiff/erf_scalar_advdiff" "plt00020")
 add_test_r(TaylorGreenAdvecting              "RegTests/TaylorGreenVortex/erf_taylor_green" "plt00010")
 add_test_r(TaylorGreenAdvectingDiffusing     "RegTests/TaylorGreenVortex/erf_taylor_green" "plt00010")
+add_test_c(TaylorGreen_async                 "RegTests/TaylorGreenVortex/erf_taylor_green" "plt00010" "-r 0.0 --abs_tol 0.0" "erf.async_fill_boundary=false" "async_fill_boundary *: 1")
 add_test_r(MSF_NoSub_IsentropicVortexAdv     "RegTests/IsentropicVortex/erf_isentropic_vortex" "plt00010")
 add_test_r(MSF_Sub_IsentropicVortexAdv       "RegTests/IsentropicVortex/erf_isentropic_vortex" "plt00010")
 add_test_r(ABL_MOST                          "ABL/erf_abl" "plt00010")
+add_test_c(ABL_MOST_warm                     "ABL/erf_abl" "plt00010" "-r 1e-5 --abs_tol 1.0e-5" "erf.most.warm_start=false erf.most.fixed_iters=0" "\\(land\\) after 3 iterations: .*columns above 1e-05: 0 of 4096")
 add_test_r(ABL_MYNN_PBL                      "ABL/erf_abl" "plt00100")
 add_test_r(ABL_InflowFile                    "ABL/erf_abl" "plt00010")
+add_test_b(BndryPlanes_container             "ABL/erf_abl" "plt00008" "erf.Cs=0.2")
+add_test_z(CompressedPlotfile                "ABL/erf_abl" "plt00010" "-r 0.0 --abs_tol 0.0")
+add_test_z(CompressedPlotfile_quantized      "ABL/erf_abl" "plt00010" "-r 2.0e-6 --abs_tol 5.0e-4")
 add_test_r(MoistBubble                       "RegTests/Bubble/erf_bubble" "plt00010")
+add_test_c(MoistBubble_trimmed               "RegTests/Bubble/erf_bubble" "plt00010" "-r 0.0 --abs_tol 0.0" "erf.trim_mri_memory=false" "trim_mri_memory *: 1")
+add_test_s(MoistBubble_sediment_zsplit       "RegTests/Bubble/erf_bubble" "amr.max_grid_size=256" "python3 check_water.py 1e-8 MoistBubble_sediment_zsplit.log MoistBubble_sediment_zsplit_ref.log")
+add_test_s(MoistBubble_sediment_substeps     "RegTests/Bubble/erf_bubble" "amr.max_grid_size=256" "python3 check_water.py 1e-8 MoistBubble_sediment_substeps.log MoistBubble_sediment_substeps_ref.log && ${FEXTREMA_EXE} plt00010 > extrema.txt && python3 check_positive.py extrema.txt qv qc qp rain_accum")
 
 add_test_0(InitSoundingIdeal_stationary      "ABL/erf_abl" "plt00010")
 add_test_0(Deardorff_stationary              "ABL/erf_abl" "plt00010")
+
+if(ERF_ENABLE_WINDFARM)
+add_test_l(SimpleAD_disk_average             "SimpleActuatorDisk/erf_simple_actuator_disk" "^ *0 1000000 1000000$" "turbine_power.txt")
+add_test_s(SimpleAD_power                    "SimpleActuatorDisk/erf_simple_actuator_disk" "erf.windfarm_disk_average=false erf.windfarm_power_log=ref_power.txt" "python3 check_power.py 1500000 plt_power.txt ref_power.txt")
+add_test_c(WindFarm_Fitch                    "EWP/erf_fitch" "plt00010" "-r 1e-12 --abs_tol 1.0e-12" "amr.max_grid_size=64" "Reading wind turbine locations table")
+add_test_c(WindFarm_EWP                      "EWP/erf_fitch" "plt00010" "-r 1e-12 --abs_tol 1.0e-12" "amr.max_grid_size=64" "Reading wind turbine locations table")
+endif()
+
+if(ERF_ENABLE_POISSON_SOLVE)
+add_test_c(FFTPoisson_vs_MLMG                "ABL/erf_abl" "plt00010" "-r 1e-8 --abs_tol 1.0e-8" "erf.use_fft_poisson=false" "Projection at level 0 solved with FFTs")
+add_test_c(Projection_reuse                  "ABL/erf_abl" "plt00010" "-r 1e-8 --abs_tol 1.0e-8" "erf.reuse_projection_solver=false" "Projection at level 0 took [0-9]+ MLMG iterations")
+endif()
+
+if(ERF_ENABLE_NETCDF AND ERF_ENABLE_MPI)
+add_test_n(IsentropicVortex_ncchk             "RegTests/IsentropicVortex/erf_isentropic_vortex" "plt00010" "chk00005")
+endif()
 endif()
 #=============================================================================
 # Performance tests
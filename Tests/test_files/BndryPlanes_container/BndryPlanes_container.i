@@ -0,0 +1,72 @@
+# ------------------  INPUTS TO MAIN PROGRAM  -------------------
+max_step = 10
+
+amrex.fpe_trap_invalid = 1
+
+fabarray.mfiter_tile_size = 1024 1024 1024
+
+# PROBLEM SIZE & GEOMETRY
+geometry.prob_lo =    0.    0.     0.
+geometry.prob_hi = 1024. 1024.  1024.
+amr.n_cell       =   32    32     32
+amr.max_grid_size =  16
+
+geometry.is_periodic = 1 1 0
+
+zlo.type = "NoSlipWall"
+zhi.type = "SlipWall"
+
+# TIME STEP CONTROL
+erf.no_substepping  = 1
+erf.fixed_dt        = 2.0e-2  # fixed time step depending on grid resolution
+
+# DIAGNOSTICS & VERBOSITY
+erf.sum_interval   = 1       # timesteps between computing mass
+erf.v              = 1       # verbosity in ERF.cpp
+amr.v              = 1       # verbosity in Amr.cpp
+
+# REFINEMENT / REGRIDDING
+amr.max_level       = 0       # maximum level number allowed
+
+# CHECKPOINT FILES
+erf.check_file      = chk        # root name of checkpoint file
+erf.check_int       = 6          # number of timesteps between checkpoints
+
+# PLOTFILES
+erf.plot_file_1     = plt        # prefix of plotfile name
+erf.plot_int_1      = -1         # number of timesteps between plotfiles
+erf.plot_vars_1     = density x_velocity y_velocity z_velocity theta
+
+# SOLVER CHOICE
+erf.alpha_T = 0.0
+erf.alpha_C = 1.0
+erf.use_gravity = false
+
+erf.molec_diff_type = "None"
+erf.les_type        = "Smagorinsky"
+erf.Cs              = 0.1
+
+erf.init_type = "uniform"
+
+# PROBLEM PARAMETERS
+prob.rho_0 = 1.0
+prob.A_0 = 1.0
+prob.T_0 = 300.0
+prob.U_0 = 10.0
+prob.V_0 = 0.0
+prob.W_0 = 0.0
+
+prob.U_0_Pert_Mag = 0.08
+prob.V_0_Pert_Mag = 0.08
+prob.W_0_Pert_Mag = 0.0
+
+# BOUNDARY PLANES -- all ranks append to one file each
+erf.output_bndry_planes = 1
+erf.bndry_output_planes_interval = 2
+erf.bndry_output_start_time = 0.0
+erf.bndry_output_planes_file = "bndry_container"
+erf.bndry_output_format = "container"
+erf.bndry_output_var_names = temperature velocity density
+
+erf.bndry_output_box_lo = 256. 256.
+erf.bndry_output_box_hi = 768. 768.
@@ -0,0 +1,72 @@
+# ------------------  INPUTS TO MAIN PROGRAM  -------------------
+max_step = 10
+
+amrex.fpe_trap_invalid = 1
+
+fabarray.mfiter_tile_size = 1024 1024 1024
+
+# PROBLEM SIZE & GEOMETRY
+# nx and ny are not powers of two, so the mixed-radix transforms are used
+geometry.prob_extent =  960      800     640
+amr.n_cell           =   48       40      32
+
+geometry.is_periodic = 1 1 0
+
+zlo.type = "SlipWall"
+zhi.type = "SlipWall"
+
+# INCOMPRESSIBLE SOLVE
+# The reference run sets erf.use_fft_poisson = false and solves with MLMG
+erf.incompressible  = 1
+erf.no_substepping  = 1
+erf.use_fft_poisson = true
+erf.poisson_abstol  = 1e-12
+erf.poisson_reltol  = 1e-12
+erf.mg_v            = 1
+
+# TIME STEP CONTROL
+erf.fixed_dt = 0.5  # fixed time step depending on grid resolution
+
+# DIAGNOSTICS & VERBOSITY
+erf.sum_interval   = 1       # timesteps between computing mass
+erf.v              = 1       # verbosity in ERF.cpp
+amr.v              = 1       # verbosity in Amr.cpp
+
+# REFINEMENT / REGRIDDING
+amr.max_level       = 0       # maximum level number allowed
+
+# CHECKPOINT FILES
+erf.check_file      = chk        # root name of checkpoint file
+erf.check_int       = 100        # number of timesteps between checkpoints
+
+# PLOTFILES
+# With zero-gradient conditions in z the pressure of the two solvers may differ
+#   by a constant, so only the velocities are compared
+erf.plot_file_1     = plt       # prefix of plotfile name
+erf.plot_int_1      = 10        # number of timesteps between plotfiles
+erf.plot_vars_1     = density x_velocity y_velocity z_velocity theta
+
+# SOLVER CHOICE
+erf.alpha_T = 0.0
+erf.alpha_C = 1.0
+erf.use_gravity = false
+
+erf.molec_diff_type = "None"
+erf.les_type        = "None"
+
+erf.init_type = "uniform"
+
+# PROBLEM PARAMETERS
+prob.rho_0 = 1.0
+prob.A_0 = 1.0
+
+prob.U_0 = 10.0
+prob.V_0 = 0.0
+prob.W_0 = 0.0
+prob.T_0 = 300.0
+
+# Random velocity perturbations give a divergent field to project
+prob.pert_ref_height = 640.0
+prob.U_0_Pert_Mag = 1.0
+prob.V_0_Pert_Mag = 1.0
+prob.W_0_Pert_Mag = 1.0
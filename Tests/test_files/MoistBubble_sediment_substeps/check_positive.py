@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+"""Check that variables of a plotfile are not negative.
+
+Usage: check_positive.py extrema var [var ...]
+
+extrema is the output of amrex_fextrema on the plotfile, with one line per
+variable holding its name, minimum and maximum.
+"""
+import sys
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit("usage: check_positive.py extrema var [var ...]")
+    minima = {}
+    with open(sys.argv[1]) as f:
+        for line in f:
+            tokens = line.split()
+            if len(tokens) == 3:
+                try:
+                    minima[tokens[0]] = float(tokens[1])
+                except ValueError:
+                    pass
+
+    for var in sys.argv[2:]:
+        if var not in minima:
+            sys.exit(sys.argv[1] + ": no extrema for " + var)
+        print("%s: minimum %g" % (var, minima[var]))
+        if minima[var] < 0.0:
+            sys.exit(var + " is negative")
+
+
+if __name__ == "__main__":
+    main()
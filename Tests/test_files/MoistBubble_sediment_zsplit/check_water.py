@@ -0,0 +1,41 @@
+#!/usr/bin/env python3
+"""Check the conservation of the total water printed by erf.sum_interval.
+
+Usage: check_water.py tol log ref_log
+
+The TOTAL WATER (moist scalars plus the precipitation accumulated at the
+surface) of every step of log must agree with that of the first step, and
+the last value must agree with the last one of ref_log, both to the relative
+tolerance tol.
+"""
+import re
+import sys
+
+PATTERN = re.compile(r"TOTAL WATER\s*=\s*(\S+)")
+
+
+def read_water(fname):
+    with open(fname) as f:
+        values = [float(m.group(1)) for m in PATTERN.finditer(f.read())]
+    if len(values) < 2:
+        sys.exit(fname + ": fewer than two TOTAL WATER lines")
+    return values
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit("usage: check_water.py tol log ref_log")
+    tol = float(sys.argv[1])
+    water = read_water(sys.argv[2])
+    ref = read_water(sys.argv[3])
+
+    drift = max(abs(w - water[0]) for w in water) / abs(water[0])
+    diff = abs(water[-1] - ref[-1]) / abs(ref[-1])
+    print("%s: %d steps, relative drift %g, relative difference from %s %g"
+          % (sys.argv[2], len(water), drift, sys.argv[3], diff))
+    if not (drift <= tol and diff <= tol):
+        sys.exit("total water is not conserved")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+# ------------------  INPUTS TO MAIN PROGRAM  -------------------
+max_step = 10
+
+amrex.fpe_trap_invalid = 1
+
+fabarray.mfiter_tile_size = 1024 1024 1024
+
+# PROBLEM SIZE & GEOMETRY
+geometry.prob_lo     = -12  -12  -1
+geometry.prob_hi     =  12   12   1
+amr.n_cell           =  48   48   4
+
+geometry.is_periodic = 1 1 0
+
+zlo.type = "SlipWall"
+zhi.type = "SlipWall"
+
+# TIME STEP CONTROL
+erf.no_substepping     = 1
+erf.fixed_dt           = 0.0005
+
+# DIAGNOSTICS & VERBOSITY
+erf.sum_interval    = 1       # timesteps between computing mass
+erf.v               = 1       # verbosity in ERF.cpp
+amr.v               = 1       # verbosity in Amr.cpp
+
+# REFINEMENT / REGRIDDING
+amr.max_level       = 0       # maximum level number allowed
+amr.max_grid_size   = 16      # 9 boxes, so the probes are spread over the ranks
+
+# CHECKPOINT FILES
+erf.check_file      = chk        # root name of checkpoint file
+erf.check_int       = 100        # number of timesteps between checkpoints
+
+# PLOTFILES
+erf.plot_file_1     = plt        # number of timesteps between plotfiles
+erf.plot_int_1      = 10         # number of timesteps between plotfiles
+erf.plot_vars_1     = density x_velocity y_velocity z_velocity pressure theta temp vorticity_x vorticity_y vorticity_z
+
+# SOLVER CHOICE
+erf.alpha_T = 0.0
+erf.alpha_C = 0.0
+erf.use_gravity = false
+
+erf.les_type         = "None"
+erf.molec_diff_type  = "None"
+erf.dynamicViscosity = 0.0
+
+# PROBLEM PARAMETERS
+prob.p_inf = 1e5  # reference pressure [Pa]
+prob.T_inf = 300. # reference temperature [K]
+prob.M_inf = 1.1952286093343936  # freestream Mach number [-]
+prob.alpha = 0.7853981633974483  # inflow angle, 0 --> x-aligned [rad]
+prob.beta  = 1.1088514254079065 # non-dimensional max perturbation strength [-]
+prob.R     = 1.0  # characteristic length scale for grid [m]
+prob.sigma = 1.0  # Gaussian standard deviation [-]
+#prob.init_periodic = true # initialize a 3x3 array of vortices (8 vortices off-grid)
+
+# PROBE GROUPS
+# The test reruns with a single box and checks that both runs write the same samples
+erf.sampler_groups    = towers beam
+
+erf.towers.points     = 2 3 0   20 30 1   40 5 2   47 47 3   17 33 0
+erf.towers.interval   = 1
+erf.towers.file       = plt_towers.bin
+
+erf.beam.lines        = 15 16   16 16   31 32   45 10
+erf.beam.interval     = 5
+erf.beam.file         = plt_beam.bin
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Compare the probe-group files of two runs.
+
+Usage: check_sampler.py tol file ref_file [file ref_file ...]
+
+Each pair must have the same header and the same number of records, every
+value must agree to the relative tolerance tol, and the density (the first
+component) of every probe must be positive, so a probe that was not gathered
+onto the writer is caught even if both runs miss it.
+"""
+import struct
+import sys
+
+MAGIC = b"ERF_SAMPLER 1\n"
+
+
+def read_sampler(fname):
+    with open(fname, "rb") as f:
+        data = f.read()
+    if not data.startswith(MAGIC):
+        sys.exit(fname + ": bad header")
+    pos = len(MAGIC)
+    nprobes, ncomp = struct.unpack_from("<2i", data, pos)
+    pos += 8
+    cells = struct.unpack_from("<%di" % (3 * nprobes), data, pos)
+    pos += 12 * nprobes
+    reclen = 1 + nprobes * ncomp
+    nbytes = len(data) - pos
+    if nbytes % (8 * reclen) != 0:
+        sys.exit(fname + ": truncated record")
+    nrec = nbytes // (8 * reclen)
+    recs = [struct.unpack_from("<%dd" % reclen, data, pos + 8 * reclen * r) for r in range(nrec)]
+    return nprobes, ncomp, cells, recs
+
+
+def main():
+    tol = float(sys.argv[1])
+    files = sys.argv[2:]
+    if len(files) == 0 or len(files) % 2 != 0:
+        sys.exit("usage: check_sampler.py tol file ref_file [file ref_file ...]")
+
+    for fname, rname in zip(files[0::2], files[1::2]):
+        nprobes, ncomp, cells, recs = read_sampler(fname)
+        ref = read_sampler(rname)
+        if (nprobes, ncomp, cells) != ref[:3]:
+            sys.exit(fname + ": probes differ from " + rname)
+        if len(recs) == 0 or len(recs) != len(ref[3]):
+            sys.exit(fname + ": %d records, %s has %d" % (len(recs), rname, len(ref[3])))
+
+        max_err = 0.0
+        for rec, rrec in zip(recs, ref[3]):
+            for p in range(nprobes):
+                if not rec[1 + p * ncomp] > 0.0:
+                    sys.exit(fname + ": probe %d was not sampled at time %g" % (p, rec[0]))
+            for a, b in zip(rec, rrec):
+                err = abs(a - b) / max(abs(b), 1.0)
+                max_err = max(max_err, err)
+        print("%s: %d probes, %d records, max relative difference %g" % (fname, nprobes, len(recs), max_err))
+        if max_err > tol:
+            sys.exit(fname + ": differs from " + rname)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,117 @@
+# ------------------  INPUTS TO MAIN PROGRAM  -------------------
+max_step = 2
+
+amrex.fpe_trap_invalid = 1
+
+fabarray.mfiter_tile_size = 1024 1024 1024
+
+# PROBLEM SIZE & GEOMETRY
+geometry.prob_extent =  1000.0 1000.0  500.0
+amr.n_cell           =   100     100    50
+
+# WINDFARM PARAMETRIZATION PARAMETERS
+erf.windfarm_type = "SimpleActuatorDisk"
+erf.windfarm_loc_type = "x_y"
+erf.windfarm_loc_table = "windturbines_loc_x_y.txt"
+erf.windfarm_spec_table = "windturbines_spec.tbl"
+
+# The power curve is linear in the wind speed, so the power (W) of each turbine
+# is 1e5 times its disk-averaged wind speed. The initial flow is 10 m/s, so both
+# turbines must report 1000000 at time 0; only the first turbine is covered by
+# the fine level, so this also checks that level 1 does not leak into level 0
+erf.windfarm_disk_average = true
+erf.windfarm_power_log    = "turbine_power.txt"
+
+#erf.grid_stretching_ratio = 1.025
+#erf.initial_dz = 16.0
+
+geometry.is_periodic = 0 0 0
+
+# MOST BOUNDARY (DEFAULT IS ADIABATIC FOR THETA)
+#zlo.type      = "MOST"
+#erf.most.z0   = 0.1
+#erf.most.zref = 8.0
+
+zlo.type = "SlipWall"
+zhi.type = "SlipWall"
+xlo.type = "Inflow"
+xhi.type = "Outflow"
+ylo.type = "Outflow"
+yhi.type = "Outflow"
+
+xlo.velocity = 10. 0. 0.
+xlo.density  = 1.226
+xlo.theta    = 300.
+
+#erf.sponge_strength = 0.1
+#erf.use_xlo_sponge_damping = true
+#erf.xlo_sponge_end = 10000.0
+#erf.use_xhi_sponge_damping = true
+#erf.xhi_sponge_start = 90000.0
+
+#erf.sponge_density = 1.226
+#erf.sponge_x_velocity = 10.0
+#erf.sponge_y_velocity = 0.0
+#erf.sponge_z_velocity = 0.0
+
+
+# TIME STEP CONTROL
+erf.use_native_mri = 1
+erf.fixed_dt       = 0.1  # fixed time step depending on grid resolution
+#erf.fixed_fast_dt  = 0.0025
+
+# DIAGNOSTICS & VERBOSITY
+erf.sum_interval   = 1       # timesteps between computing mass
+erf.v              = 1       # verbosity in ERF.cpp
+amr.v              = 1       # verbosity in Amr.cpp
+
+# REFINEMENT / REGRIDDING
+amr.max_level       = 1       # maximum level number allowed
+amr.ref_ratio_vect  = 2 2 1
+amr.n_error_buf     = 0
+
+erf.refinement_indicators = box1
+erf.box1.max_level = 1
+erf.box1.in_box_lo = 200. 200.   0.
+erf.box1.in_box_hi = 400. 400. 500.
+
+# CHECKPOINT FILES
+erf.check_file      = chk       # root name of checkpoint file
+erf.check_int       = 1000        # number of timesteps between checkpoints
+
+# PLOTFILES
+erf.plot_file_1     = plt       # prefix of plotfile name
+erf.plot_int_1      = 1000     # number of timesteps between plotfiles
+erf.plot_vars_1     = density rhoadv_0 x_velocity y_velocity z_velocity pressure temp theta QKE num_turb vorticity_x vorticity_y vorticity_z
+
+# ADVECTION SCHEMES
+erf.dycore_horiz_adv_type    = "Centered_2nd"
+erf.dycore_vert_adv_type     = "Centered_2nd"
+erf.dryscal_horiz_adv_type   = "Centered_2nd"
+erf.dryscal_vert_adv_type    = "Centered_2nd"
+erf.moistscal_horiz_adv_type = "Centered_2nd"
+erf.moistscal_vert_adv_type  = "Centered_2nd"
+
+# SOLVER CHOICE
+erf.alpha_T = 0.0
+erf.alpha_C = 1.0
+erf.use_gravity = false
+
+erf.molec_diff_type = "ConstantAlpha"
+erf.les_type        = "None"
+erf.Cs              = 1.5
+erf.dynamicViscosity = 10.0
+
+erf.pbl_type        = "None"
+
+erf.init_type = "uniform"
+
+
+# PROBLEM PARAMETERS
+prob.rho_0 = 1.226
+prob.A_0 = 1.0
+
+prob.U_0 = 10.0
+prob.V_0 = 0.0
+prob.W_0 = 0.0
+prob.T_0 = 300.0
@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+"""Check the turbine power logs of a wind farm run.
+
+Usage: check_power.py p0 file [file ...]
+
+Each line of a log holds the time and the power (W) of every turbine. The
+first line must be at time 0 with every turbine at p0 (to a relative 1e-8),
+and the file must hold later lines, on which every power is positive and
+below p0, as the disks slow the flow down.
+"""
+import sys
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit("usage: check_power.py p0 file [file ...]")
+    p0 = float(sys.argv[1])
+
+    for fname in sys.argv[2:]:
+        with open(fname) as f:
+            recs = [[float(v) for v in line.split()] for line in f if line.strip()]
+        if len(recs) < 2:
+            sys.exit(fname + ": %d records, need at least 2" % len(recs))
+
+        first = recs[0]
+        if first[0] != 0.0 or len(first) < 2:
+            sys.exit(fname + ": the first record is not at time 0")
+        for it, p in enumerate(first[1:]):
+            if abs(p - p0) > 1e-8 * p0:
+                sys.exit(fname + ": turbine %d has power %.8g at time 0, expected %.8g" % (it, p, p0))
+
+        for rec in recs[1:]:
+            if len(rec) != len(first):
+                sys.exit(fname + ": record at time %g has %d turbines" % (rec[0], len(rec) - 1))
+            for it, p in enumerate(rec[1:]):
+                if not 0.0 < p < p0:
+                    sys.exit(fname + ": turbine %d has power %.8g at time %g" % (it, p, rec[0]))
+
+        last = " ".join("%.8g" % p for p in recs[-1][1:])
+        print("%s: %d records, power at time %g: %s" % (fname, len(recs), recs[-1][0], last))
+
+
+if __name__ == "__main__":
+    main()
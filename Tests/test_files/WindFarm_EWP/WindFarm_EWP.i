@@ -0,0 +1,72 @@
+# ------------------  INPUTS TO MAIN PROGRAM  -------------------
+max_step = 10
+
+amrex.fpe_trap_invalid = 1
+
+fabarray.mfiter_tile_size = 1024 1024 1024
+
+# PROBLEM SIZE & GEOMETRY
+geometry.prob_extent =  2000.0 2000.0 1000.0
+amr.n_cell           =    40     40     20
+amr.max_grid_size    =     8
+
+# WINDFARM PARAMETRIZATION PARAMETERS
+erf.windfarm_type = "EWP"
+erf.windfarm_loc_type = "x_y"
+erf.windfarm_loc_table = "windturbines_loc_x_y.txt"
+erf.windfarm_spec_table = "windturbines_spec.tbl"
+
+# Two turbines share a column, and two sit on the edges of the 8-cell grids;
+# the run must match the single-grid run of the same farm
+
+geometry.is_periodic = 0 0 0
+
+zlo.type = "SlipWall"
+zhi.type = "SlipWall"
+xlo.type = "Outflow"
+xhi.type = "Outflow"
+ylo.type = "Outflow"
+yhi.type = "Outflow"
+
+# TIME STEP CONTROL
+erf.use_native_mri = 1
+erf.fixed_dt       = 0.25  # fixed time step depending on grid resolution
+
+# DIAGNOSTICS & VERBOSITY
+erf.sum_interval   = 1       # timesteps between computing mass
+erf.v              = 1       # verbosity in ERF.cpp
+amr.v              = 1       # verbosity in Amr.cpp
+
+# REFINEMENT / REGRIDDING
+amr.max_level       = 0       # maximum level number allowed
+
+# CHECKPOINT FILES
+erf.check_file      = chk       # root name of checkpoint file
+erf.check_int       = 1000      # number of timesteps between checkpoints
+
+# PLOTFILES
+erf.plot_file_1     = plt       # prefix of plotfile name
+erf.plot_int_1      = 10        # number of timesteps between plotfiles
+erf.plot_vars_1     = density rhoadv_0 x_velocity y_velocity z_velocity pressure temp theta QKE num_turb
+
+# SOLVER CHOICE
+erf.alpha_T = 0.0
+erf.alpha_C = 1.0
+erf.use_gravity = false
+
+erf.molec_diff_type = "ConstantAlpha"
+erf.les_type        = "None"
+erf.dynamicViscosity = 100.0
+
+erf.pbl_type        = "None"
+
+erf.init_type = "uniform"
+
+# PROBLEM PARAMETERS
+prob.rho_0 = 1.0
+prob.A_0 = 1.0
+
+prob.U_0 = 10.0
+prob.V_0 = 5.0
+prob.W_0 = 0.0
+prob.T_0 = 300.0